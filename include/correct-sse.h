@@ -9,6 +9,15 @@ typedef struct correct_convolutional_sse correct_convolutional_sse;
 /* SSE versions of libcorrect's convolutional encoder/decoder.
  * These instances should not be used with the non-sse functions,
  * and non-sse instances should not be used with the sse functions.
+ *
+ * correct_convolutional_sse_set_traceback defaults traceback_group_length
+ * to 100 * order rather than 15 * order, as the sse decoder is fast
+ * enough for the traceback to be most of its cost.
+ *
+ * With those groups the traceback costs next to nothing per bit, so
+ * CORRECT_CONV_SURVIVOR_AUTO always picks it for the sse decoder.
+ * correct_convolutional_sse_set_survivor_memory can still ask for
+ * register exchange.
  */
 
 correct_convolutional_sse *correct_convolutional_sse_create(size_t rate, size_t order, const correct_convolutional_polynomial_t *poly);
@@ -17,5 +26,49 @@ size_t correct_convolutional_sse_encode_len(correct_convolutional_sse *conv, siz
 size_t correct_convolutional_sse_encode(correct_convolutional_sse *conv, const uint8_t *msg, size_t msg_len, uint8_t *encoded);
 ssize_t correct_convolutional_sse_decode(correct_convolutional_sse *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg);
 ssize_t correct_convolutional_sse_decode_soft(correct_convolutional_sse *conv, const correct_convolutional_soft_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+ssize_t correct_convolutional_sse_decode_soft_s8(correct_convolutional_sse *conv, const int8_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+ssize_t correct_convolutional_sse_decode_soft_llr_f32(correct_convolutional_sse *conv, const float *encoded, size_t num_encoded_bits, float scale, uint8_t *msg);
+ssize_t correct_convolutional_sse_decode_soft_u4(correct_convolutional_sse *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+ssize_t correct_convolutional_sse_decode_soft_u3(correct_convolutional_sse *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+ssize_t correct_convolutional_sse_decode_crc(correct_convolutional_sse *conv, const uint8_t *encoded, size_t num_encoded_bits, const correct_crc *crc, uint8_t *msg);
+ssize_t correct_convolutional_sse_decode_soft_crc(correct_convolutional_sse *conv, const correct_convolutional_soft_t *encoded, size_t num_encoded_bits, const correct_crc *crc, uint8_t *msg);
+ssize_t correct_convolutional_sse_set_puncture(correct_convolutional_sse *conv, const correct_convolutional_puncture *puncture);
+ssize_t correct_convolutional_sse_set_tail_biting(correct_convolutional_sse *conv, int tail_biting, size_t passes);
+ssize_t correct_convolutional_sse_set_traceback(correct_convolutional_sse *conv, size_t traceback_depth, size_t traceback_group_length);
+ssize_t correct_convolutional_sse_set_survivor_memory(correct_convolutional_sse *conv, int survivor_memory);
+ssize_t correct_convolutional_sse_set_soft_metric(correct_convolutional_sse *conv, int soft_metric);
+ssize_t correct_convolutional_sse_set_syndrome_check(correct_convolutional_sse *conv, int syndrome_check);
+ssize_t correct_convolutional_sse_set_m_algorithm(correct_convolutional_sse *conv, size_t max_paths);
+ssize_t correct_convolutional_sse_stream_begin(correct_convolutional_sse *conv, size_t delay);
+ssize_t correct_convolutional_sse_stream_decode(correct_convolutional_sse *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+ssize_t correct_convolutional_sse_stream_decode_soft(correct_convolutional_sse *conv, const correct_convolutional_soft_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+ssize_t correct_convolutional_sse_stream_end(correct_convolutional_sse *conv, uint8_t *msg);
+ssize_t correct_convolutional_sse_get_stats(const correct_convolutional_sse *conv, correct_convolutional_stats_t *stats);
+ssize_t correct_convolutional_sse_reset_stats(correct_convolutional_sse *conv);
+
+/* correct_convolutional_sse_set_threads splits the add-compare-select
+ * of every time slice across num_threads threads, for a single stream
+ * of a code whose trellis is too big for one core to keep up with,
+ * like the order 15 codes with 16384 states. Each thread owns a fixed
+ * range of the states and their decisions, and the threads meet once
+ * per time slice, waiting for each other in a spin. The calling
+ * thread takes the first range; the others are started here, pinned
+ * to their own cpus where the system allows, and sleep between
+ * blocks.
+ *
+ * A time slice has to be long enough to be worth the meeting, which
+ * takes on the order of a few hundred nanoseconds between cores, so
+ * this pays off from about order 13 up and only with a core for each
+ * thread. Threads beyond one per 64 states are left out. Decoded bits
+ * are exactly the same as with one thread.
+ *
+ * This affects the block decoders, the streams and tail-biting
+ * decoding, but not the M-algorithm. Pass 0 or 1 to go back to
+ * decoding on the calling thread alone, the default.
+ *
+ * This function returns 0, or -1 if the threads couldn't be started,
+ * or if the library was built without threads.
+ */
+ssize_t correct_convolutional_sse_set_threads(correct_convolutional_sse *conv, size_t num_threads);
 
 #endif  /* CORRECT_SSE_H */
@@ -70,7 +70,8 @@ size_t correct_convolutional_encode_len(correct_convolutional *conv, size_t msg_
  *
  * This function returns the number of bits written to encoded. If
  * this is not an exact multiple of 8, then it occupies an additional
- * byte.
+ * byte. Bits are packed most significant first, so the bits of that
+ * last byte are its highest-order bits and the rest are 0.
  */
 size_t correct_convolutional_encode(correct_convolutional *conv, const uint8_t *msg, size_t msg_len, uint8_t *encoded);
 
@@ -85,7 +86,8 @@ size_t correct_convolutional_encode(correct_convolutional *conv, const uint8_t *
  * num_encoded_bits should contain the length of encoded in *bits*.
  * This value need not be an exact multiple of 8. However,
  * it must be a multiple of the inv_rate used to create
- * the conv instance.
+ * the conv instance, unless it is punctured (see
+ * correct_convolutional_set_puncture).
  *
  * This function writes the result to msg, which must be large
  * enough to hold the decoded message. A good conservative size
@@ -108,7 +110,8 @@ ssize_t correct_convolutional_decode(correct_convolutional *conv, const uint8_t
  * num_encoded_bits should contain the length of encoded in *bits*.
  * This value need not be an exact multiple of 8. However,
  * it must be a multiple of the inv_rate used to create
- * the conv instance.
+ * the conv instance, unless it is punctured (see
+ * correct_convolutional_set_puncture).
  *
  * This function writes the result to msg, which must be large
  * enough to hold the decoded message. A good conservative size
@@ -122,6 +125,486 @@ ssize_t correct_convolutional_decode(correct_convolutional *conv, const uint8_t
  */
 ssize_t correct_convolutional_decode_soft(correct_convolutional *conv, const correct_convolutional_soft_t *encoded, size_t num_encoded_bits, uint8_t *msg);
 
+/* correct_convolutional_decode_soft_s8 and
+ * correct_convolutional_decode_soft_llr_f32 decode the same blocks
+ * as correct_convolutional_decode_soft, for demodulators that
+ * produce signed soft symbols. The decoder converts the symbols a
+ * chunk at a time as it reaches them, so there is no need for a
+ * separate conversion pass or a uint8_t copy of the block.
+ *
+ * For correct_convolutional_decode_soft_s8, -128 is a sure 0, 127 a
+ * sure 1 and 0 an erasure; it decodes exactly as
+ * correct_convolutional_decode_soft does with each symbol plus 128.
+ *
+ * correct_convolutional_decode_soft_llr_f32 takes log-likelihood
+ * ratios that are positive for a 1, like a BPSK voltage that maps 1
+ * to the positive level. Each one is multiplied by scale and added
+ * to 128, rounded, and clamped to 0..255, so 0 is an erasure and a
+ * scaled ratio of 127 or more is a sure 1. A good scale puts the
+ * typical ratio of a noiseless symbol near 127. Ratios defined as
+ * log(P(0) / P(1)) take a negative scale.
+ *
+ * Both work with puncturing and tail-biting, and return the same as
+ * correct_convolutional_decode_soft.
+ */
+ssize_t correct_convolutional_decode_soft_s8(correct_convolutional *conv, const int8_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+ssize_t correct_convolutional_decode_soft_llr_f32(correct_convolutional *conv, const float *encoded, size_t num_encoded_bits, float scale, uint8_t *msg);
+
+/* correct_convolutional_decode_soft_u4 and
+ * correct_convolutional_decode_soft_u3 take soft symbols packed
+ * below a byte each, to halve or better the size of the buffers
+ * between demodulator and decoder. As with the signed formats
+ * above, the decoder unpacks a chunk at a time as it reaches it.
+ *
+ * 4-bit symbols go two to a byte, the first in the high nibble.
+ * 0 is a sure 0 and 15 a sure 1, so encoded holds
+ * (num_encoded_bits + 1) / 2 bytes.
+ *
+ * 3-bit symbols are packed from the most significant bit down,
+ * eight to every three bytes, and a symbol may straddle two bytes.
+ * 0 is a sure 0 and 7 a sure 1, so encoded holds
+ * (3 * num_encoded_bits + 7) / 8 bytes.
+ *
+ * Neither has a level halfway between 0 and 1, so an erasure should
+ * alternate between the two middle levels, 7 and 8 or 3 and 4.
+ *
+ * Both work with puncturing and tail-biting, and return the same as
+ * correct_convolutional_decode_soft.
+ */
+ssize_t correct_convolutional_decode_soft_u4(correct_convolutional *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+ssize_t correct_convolutional_decode_soft_u3(correct_convolutional *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+
+/* correct_crc describes a cyclic redundancy check, which the
+ * decoders can verify on their output as they write it (see
+ * correct_convolutional_decode_soft_crc).
+ *
+ * correct_crc_create takes the usual parameters of a crc: its width
+ * in bits, which must be 8, 16, 24 or 32, the polynomial without its
+ * top bit, the initial register, the value xored into the result,
+ * and whether bytes enter least significant bit first (reflected,
+ * as for CRC-32) or most significant bit first. init is given
+ * unreflected, as in published crc catalogues.
+ *
+ * correct_crc_create_standard makes one of the common crcs:
+ * CORRECT_CRC16_CCITT is polynomial 0x1021 with register 0xffff, as
+ * in CCSDS transfer frames, CORRECT_CRC32 is the crc of ethernet and
+ * zlib, and CORRECT_CRC32C is the Castagnoli crc of iSCSI and SCTP.
+ *
+ * Both return NULL on invalid parameters or failure.
+ */
+struct correct_crc;
+typedef struct correct_crc correct_crc;
+
+enum {
+    CORRECT_CRC16_CCITT = 0,
+    CORRECT_CRC32 = 1,
+    CORRECT_CRC32C = 2,
+};
+correct_crc *correct_crc_create(unsigned int width, uint32_t polynomial, uint32_t init, uint32_t xorout, int reflected);
+correct_crc *correct_crc_create_standard(int standard);
+
+/* correct_crc_destroy releases the resources associated with crc.
+ */
+void correct_crc_destroy(correct_crc *crc);
+
+/* correct_crc_compute returns the crc of the len bytes at data.
+ *
+ * correct_crc_append writes the crc of the len bytes at data
+ * directly after them, in the byte order the decoders expect: most
+ * significant byte first, or least significant byte first for a
+ * reflected crc. data must have room for width / 8 more bytes. This
+ * function returns the new length of data.
+ */
+uint32_t correct_crc_compute(const correct_crc *crc, const uint8_t *data, size_t len);
+size_t correct_crc_append(const correct_crc *crc, uint8_t *data, size_t len);
+
+/* correct_convolutional_decode_crc and
+ * correct_convolutional_decode_soft_crc decode a block just as
+ * correct_convolutional_decode and correct_convolutional_decode_soft
+ * do, for messages that end in a crc made by correct_crc_append.
+ * The crc is computed while the decoder writes msg, so there is no
+ * second pass over the message to check it.
+ *
+ * The message is all of the whole bytes decoded from the block, the
+ * last width / 8 of which are the crc.
+ *
+ * These functions return 1 if the crc matches, 0 if it doesn't, or
+ * -1 on failure. Either way, msg holds the decoded message.
+ */
+ssize_t correct_convolutional_decode_crc(correct_convolutional *conv, const uint8_t *encoded, size_t num_encoded_bits, const correct_crc *crc, uint8_t *msg);
+ssize_t correct_convolutional_decode_soft_crc(correct_convolutional *conv, const correct_convolutional_soft_t *encoded, size_t num_encoded_bits, const correct_crc *crc, uint8_t *msg);
+
+/* correct_convolutional_set_soft_metric picks how the soft decoders
+ * measure the distance between a received soft symbol and a sent
+ * bit.
+ *
+ * CORRECT_SOFT_LINEAR, the default, charges the plain difference,
+ * e.g. 55 for receiving 200 when a 1 (255) was sent.
+ * CORRECT_SOFT_QUADRATIC charges the square of the difference,
+ * scaled back down by 255, e.g. 12 for the same symbol. On AWGN
+ * channels the squared distance tracks the likelihood better, and
+ * it discounts weak symbols more heavily.
+ *
+ * Both are looked up in a table of 256 costs, so neither is faster
+ * than the other. The metric doesn't affect hard decoding with
+ * correct_convolutional_decode.
+ *
+ * This function returns 0, or -1 on failure.
+ */
+enum {
+    CORRECT_SOFT_LINEAR = 0,
+    CORRECT_SOFT_QUADRATIC = 1,
+};
+ssize_t correct_convolutional_set_soft_metric(correct_convolutional *conv, int soft_metric);
+
+/* correct_convolutional_set_syndrome_check turns on a fast path for
+ * blocks that arrive without errors, which are most of them at high
+ * SNR. Before running the Viterbi decoder, the decoders take a hard
+ * decision on every symbol and run the code's parity checks over the
+ * block a machine word at a time. If those pass and the block ends
+ * in the zero tail, it is exactly what the encoder sent, and the
+ * message is read straight off it at a small fraction of the cost
+ * of decoding. Any other block is decoded as usual.
+ *
+ * Blocks that pass the check decode exactly as they would without
+ * it, so the check only costs the extra pass over blocks that don't.
+ * Soft blocks with an erased symbol (128) always go to the decoder,
+ * as do punctured and tail-biting blocks.
+ *
+ * This affects the block decoders, correct_convolutional_decode,
+ * correct_convolutional_decode_soft and the other formats and crc
+ * variants of these. It is off by default; pass 1 to turn it on and
+ * 0 to turn it off.
+ *
+ * This function returns 0, or -1 if the code's parity checks can't
+ * give back its message, which takes two polynomials without a
+ * common factor.
+ */
+ssize_t correct_convolutional_set_syndrome_check(correct_convolutional *conv, int syndrome_check);
+
+/* correct_convolutional_set_m_algorithm swaps the Viterbi decoder
+ * for the M-algorithm, a reduced-state decoder for codes whose
+ * full trellis is too big to search, like the order 15 codes.
+ * Rather than keeping a path into each of the 2^(order-1) states,
+ * it keeps only the max_paths paths with the best metrics at each
+ * time slice, so its cost grows with max_paths rather than with
+ * the order. The paths are traced back the same way, with the
+ * traceback set by correct_convolutional_set_traceback.
+ *
+ * A path costs several times what a state does in the Viterbi
+ * decoder, so this only pays off with max_paths well below the
+ * number of states. It also gives up some coding gain, as the
+ * correct path is lost whenever noise pushes it out of the best
+ * max_paths, and the decoder then makes a burst of errors until it
+ * finds its way back. tools/compare_conv_m_algorithm.c measures both
+ * for a given code and signal to noise ratio.
+ *
+ * This affects the block decoders, as
+ * correct_convolutional_set_syndrome_check does, except for
+ * tail-biting blocks, which always use the Viterbi decoder. Pass 0
+ * to go back to the Viterbi decoder, the default.
+ *
+ * This function returns 0, or -1 on failure.
+ */
+ssize_t correct_convolutional_set_m_algorithm(correct_convolutional *conv, size_t max_paths);
+
+/* correct_convolutional_puncture describes a puncture pattern, which
+ * raises the rate of a code by not sending some of its outputs.
+ *
+ * pattern holds period * inv_rate entries, one time slice after
+ * another. Entry i * inv_rate + j is nonzero if output j of time slice
+ * i within the period is sent, and zero if it is dropped. Every time
+ * slice must send at least one output. E.g., rate 3/4 from a rate 1/2
+ * code sends both outputs of the first slice, the second output of
+ * the second and the first output of the third:
+ * correct_convolutional_puncture_create(2, (uint8_t[]){1, 1, 0, 1, 1, 0}, 3);
+ *
+ * The patterns below are the usual ones for the rate 1/2, order 7
+ * code, as used by DVB-S and CCSDS.
+ *
+ * If this call is successful, it returns a non-NULL pointer.
+ */
+struct correct_convolutional_puncture;
+typedef struct correct_convolutional_puncture correct_convolutional_puncture;
+
+static const uint8_t correct_conv_puncture_r23[] = {1, 1, 0, 1};
+static const uint8_t correct_conv_puncture_r34[] = {1, 1, 0, 1, 1, 0};
+static const uint8_t correct_conv_puncture_r56[] = {1, 1, 0, 1, 1, 0, 0, 1, 1, 0};
+static const uint8_t correct_conv_puncture_r78[] = {1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0};
+
+correct_convolutional_puncture *correct_convolutional_puncture_create(size_t inv_rate, const uint8_t *pattern, size_t period);
+
+/* correct_convolutional_puncture_destroy releases all resources
+ * associated with puncture.
+ */
+void correct_convolutional_puncture_destroy(correct_convolutional_puncture *puncture);
+
+/* correct_convolutional_set_puncture makes conv puncture everything
+ * it encodes and expect punctured input to everything it decodes.
+ * conv keeps its own copy of the pattern, so puncture may be
+ * destroyed afterwards. Passing NULL goes back to sending every
+ * output.
+ *
+ * Once set, correct_convolutional_encode_len and
+ * correct_convolutional_encode count only the bits that are sent,
+ * and num_encoded_bits passed to the decoders is the length of the
+ * punctured stream. It must end on a time slice boundary. The
+ * decoders give dropped outputs no weight at all, so there is no
+ * need to depuncture by hand.
+ *
+ * This function returns 0, or -1 if puncture was made for a different
+ * inv_rate or on failure.
+ */
+ssize_t correct_convolutional_set_puncture(correct_convolutional *conv, const correct_convolutional_puncture *puncture);
+
+/* correct_convolutional_set_tail_biting switches conv between the
+ * usual zero tail and tail-biting, if tail_biting is nonzero.
+ *
+ * A zero-tailed block flushes the encoder with order + 1 zero bits
+ * after the message so that the decoder knows where it ends. A
+ * tail-biting block instead starts the encoder from the state that
+ * the last order - 1 message bits leave it in, and sends no tail at
+ * all. For short messages this saves a noticeable share of the
+ * encoded length, e.g. 8 of 136 time slices for a 16 byte message
+ * with an order 7 code.
+ *
+ * Since the decoder no longer knows the state at either end, it
+ * walks all the way around the message passes times to learn it
+ * before the walk it decodes from. Each pass costs about as much
+ * as decoding the message once. 1 or 2 passes are usually enough;
+ * 0 is allowed but gives up some of the code's strength at the
+ * edges of the message.
+ *
+ * Once set, correct_convolutional_encode_len and
+ * correct_convolutional_encode leave out the tail, and the decoders
+ * expect a tail-biting block of whole message bytes. Tail-biting
+ * works with puncturing.
+ *
+ * This function returns 0, or -1 on failure.
+ */
+ssize_t correct_convolutional_set_tail_biting(correct_convolutional *conv, int tail_biting, size_t passes);
+
+/* correct_convolutional_set_traceback tunes how the decoders pick
+ * out the decoded path.
+ *
+ * The decoders keep one decision per state for every time slice
+ * and periodically trace back along the best path to output bits.
+ * Only bits at least traceback_depth slices old are output, since
+ * the paths have only merged that far back. Each traceback then
+ * outputs traceback_group_length bits at once.
+ *
+ * A longer traceback_depth decodes better, up to a point, but costs
+ * a longer walk back for every group. A longer group makes the
+ * tracebacks rarer and the decoder faster, at the cost of memory
+ * and latency. The defaults are 5 * order for traceback_depth and
+ * 15 * order for traceback_group_length. Passing 0 for either
+ * restores its default. tools/sweep_conv_traceback.c can measure
+ * the tradeoff for a given code.
+ *
+ * Tail-biting decoding also runs on past the end of its block for
+ * traceback_depth slices (see correct_convolutional_set_tail_biting).
+ *
+ * This function returns 0, or -1 on failure.
+ */
+ssize_t correct_convolutional_set_traceback(correct_convolutional *conv, size_t traceback_depth, size_t traceback_group_length);
+
+/* correct_convolutional_set_survivor_memory picks how the decoders
+ * remember the paths that survive each time slice.
+ *
+ * CORRECT_CONV_SURVIVOR_TRACEBACK keeps one decision per state for
+ * every time slice and walks back through them to output bits, as
+ * described for correct_convolutional_set_traceback.
+ *
+ * CORRECT_CONV_SURVIVOR_REGISTER_EXCHANGE instead keeps each state's
+ * whole surviving path in a 64 bit register, copying registers from
+ * state to state as the paths merge. There is nothing to walk back
+ * through, but every register moves on every time slice, so this
+ * only pays off for small orders. The register also caps
+ * traceback_depth + traceback_group_length at 64, so the group is
+ * shortened to fit; a traceback_depth of 64 or more always uses
+ * traceback. Both give exactly the same decoded bits.
+ *
+ * CORRECT_CONV_SURVIVOR_AUTO, the default, uses register exchange
+ * where it measured faster, which is for order 4 and below, and
+ * traceback otherwise. See tools/sweep_conv_traceback.c to compare
+ * the two for a given code.
+ *
+ * This only affects correct_convolutional_decode and
+ * correct_convolutional_decode_soft for zero-tailed blocks.
+ *
+ * This function returns 0, or -1 on failure.
+ */
+enum {
+    CORRECT_CONV_SURVIVOR_AUTO = 0,
+    CORRECT_CONV_SURVIVOR_TRACEBACK = 1,
+    CORRECT_CONV_SURVIVOR_REGISTER_EXCHANGE = 2,
+};
+ssize_t correct_convolutional_set_survivor_memory(correct_convolutional *conv, int survivor_memory);
+
+/* correct_convolutional_stream_begin starts a low-delay stream on
+ * conv's decoder. Where correct_convolutional_decode outputs bits in
+ * bursts once it has traceback_group_length of them, a stream outputs
+ * the bit for every time slice exactly delay time slices later. It
+ * does so with a traceback of delay slices after every slice, so a
+ * short delay is cheap but decodes less well. delay around 5 * order
+ * decodes about as well as the block decoder.
+ *
+ * The stream starts from the all-zero encoder state, as
+ * correct_convolutional_encode does. Streams can't be punctured or
+ * tail-biting. While a stream is running, conv's other decode
+ * functions must not be used.
+ *
+ * This function returns 0, or -1 on failure.
+ */
+ssize_t correct_convolutional_stream_begin(correct_convolutional *conv, size_t delay);
+
+/* correct_convolutional_stream_decode and
+ * correct_convolutional_stream_decode_soft feed the next
+ * num_encoded_bits of a stream to the decoder. num_encoded_bits must
+ * be a multiple of the inv_rate used to create the conv instance,
+ * and for the hard decision decoder, encoded must start on a whole
+ * time slice.
+ *
+ * The decoded bits are written to msg, starting with its first bit.
+ * msg must hold at least as many bits as there are time slices in
+ * encoded. Unused bits of the last byte are set to 0.
+ *
+ * These functions return the number of *bits* written to msg, or -1
+ * if no stream is running or on failure.
+ */
+ssize_t correct_convolutional_stream_decode(correct_convolutional *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+ssize_t correct_convolutional_stream_decode_soft(correct_convolutional *conv, const correct_convolutional_soft_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+
+/* correct_convolutional_stream_end writes the bits for the last delay
+ * time slices of the stream to msg, which must hold delay bits, and
+ * starts a new stream with the same delay. Note that these include
+ * the tail of a block made by correct_convolutional_encode, which
+ * decodes as order + 1 0 bits after the message.
+ *
+ * This function returns the number of *bits* written to msg, or -1
+ * if no stream is running.
+ */
+ssize_t correct_convolutional_stream_end(correct_convolutional *conv, uint8_t *msg);
+
+/* correct_convolutional_stats_t counts what a decoder has done since
+ * it was created or its stats were last reset.
+ *
+ * The best path metric is how far the received symbols are from the
+ * path the decoder settled on, so its growth tracks the channel. For
+ * correct_convolutional_decode every bit in error adds 1, and
+ * metric_growth / (inv_rate * steps) estimates the channel's bit
+ * error rate before decoding, which can stand in for an SNR estimate.
+ * For the soft decoders with the default metric, a symbol at the
+ * wrong end of the range adds 255 and one in the middle about 128.
+ */
+typedef struct {
+    // blocks run through the decoder. tail-biting blocks count, blocks
+    // that passed the syndrome check without decoding don't
+    uint64_t blocks;
+    // time slices run through the trellis, every pass of a tail-biting
+    // block and every slice of a stream included
+    uint64_t steps;
+    // times the path metrics were brought back down by the best of them
+    uint64_t renormalizations;
+    // tracebacks through the survivor memory
+    uint64_t tracebacks;
+    // total growth of the best path metric
+    uint64_t metric_growth;
+    // the metric of the winning path of the last block, over the whole
+    // block. not set by tail-biting blocks or streams
+    uint64_t last_path_metric;
+} correct_convolutional_stats_t;
+
+/* correct_convolutional_get_stats copies conv's counters to stats,
+ * and correct_convolutional_reset_stats sets them back to 0.
+ *
+ * The counters are only kept when the library is built with
+ * CORRECT_CONV_STATS (the ENABLE_LIBCORRECT_STATS CMake option).
+ * Otherwise every update is compiled out and these functions return
+ * -1. Keeping them costs a few additions per renormalization and per
+ * traceback.
+ *
+ * These functions return 0, or -1 if stats aren't built in.
+ */
+ssize_t correct_convolutional_get_stats(const correct_convolutional *conv, correct_convolutional_stats_t *stats);
+ssize_t correct_convolutional_reset_stats(correct_convolutional *conv);
+
+/* correct_convolutional_sequential is an encoder/decoder for codes of
+ * order up to 64, far beyond what the Viterbi decoder or even the
+ * M-algorithm can search. Rather than a trellis, it decodes with the
+ * Fano algorithm, which follows a single path through the code tree
+ * and backs up to try other branches only where the noise makes the
+ * path's metric fall. At moderate SNR and above it does little more
+ * than one step per bit, whatever the order, but its work grows
+ * quickly as the SNR falls, so each block has a compute budget,
+ * which when spent makes the decoder give up on the block.
+ *
+ * The polynomials are 64 bits wide and follow the same convention as
+ * correct_convolutional_polynomial_t, and the encoded format is the
+ * same as correct_convolutional_encode's, a tail of order + 1 0 bits
+ * included. E.g. the rate 1/2, order 32 code of libfec's fano decoder
+ * is created with
+ * correct_convolutional_sequential_create(2, 32, correct_conv_r12_32_polynomial);
+ *
+ * inv_rate can be from 2 to 8 and order from 2 to 64.
+ *
+ * If this call is successful, it returns a non-NULL pointer.
+ */
+typedef uint64_t correct_convolutional_long_polynomial_t;
+
+static const correct_convolutional_long_polynomial_t correct_conv_r12_32_polynomial[] = {0xf2d05351, 0xe4613c47};
+
+struct correct_convolutional_sequential;
+typedef struct correct_convolutional_sequential correct_convolutional_sequential;
+
+correct_convolutional_sequential *correct_convolutional_sequential_create(size_t inv_rate, size_t order, const correct_convolutional_long_polynomial_t *poly);
+
+/* correct_convolutional_sequential_destroy releases all resources
+ * associated with seq.
+ */
+void correct_convolutional_sequential_destroy(correct_convolutional_sequential *seq);
+
+/* correct_convolutional_sequential_encode_len and
+ * correct_convolutional_sequential_encode work as
+ * correct_convolutional_encode_len and correct_convolutional_encode
+ * do.
+ */
+size_t correct_convolutional_sequential_encode_len(correct_convolutional_sequential *seq, size_t msg_len);
+size_t correct_convolutional_sequential_encode(correct_convolutional_sequential *seq, const uint8_t *msg, size_t msg_len, uint8_t *encoded);
+
+/* correct_convolutional_sequential_decode and
+ * correct_convolutional_sequential_decode_soft decode a block made by
+ * correct_convolutional_sequential_encode, taking their arguments as
+ * correct_convolutional_decode and correct_convolutional_decode_soft
+ * do. The whole block is searched at once, so it should be no longer
+ * than the frames the code is meant for.
+ *
+ * These functions return the number of bytes written to msg, or -1
+ * if the block's compute budget ran out before the decoder found its
+ * way through, or on failure.
+ */
+ssize_t correct_convolutional_sequential_decode(correct_convolutional_sequential *seq, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+ssize_t correct_convolutional_sequential_decode_soft(correct_convolutional_sequential *seq, const correct_convolutional_soft_t *encoded, size_t num_encoded_bits, uint8_t *msg);
+
+/* correct_convolutional_sequential_set_compute_budget caps the work
+ * spent on each block at cycles_per_bit steps of the decoder for
+ * each time slice in the block. A clean block takes one step per
+ * time slice. The default is 1000.
+ *
+ * This function returns 0, or -1 if cycles_per_bit is 0.
+ */
+ssize_t correct_convolutional_sequential_set_compute_budget(correct_convolutional_sequential *seq, size_t cycles_per_bit);
+
+/* correct_convolutional_sequential_set_channel sets the Eb/N0, in
+ * dB, of the channel the decoder's metrics are worked out for. The
+ * soft metrics assume BPSK scaled to 0..255, as for
+ * correct_convolutional_decode_soft. The decoder still works away
+ * from this point, if not as well; the default is 3 dB.
+ *
+ * This function returns 0, or -1 if eb_n0 is out of range.
+ */
+ssize_t correct_convolutional_sequential_set_channel(correct_convolutional_sequential *seq, double eb_n0);
+
 // Reed-Solomon
 
 struct correct_reed_solomon;
@@ -211,6 +694,60 @@ correct_reed_solomon *correct_reed_solomon_create(uint16_t primitive_polynomial,
  */
 ssize_t correct_reed_solomon_encode(correct_reed_solomon *rs, const uint8_t *msg, size_t msg_length, uint8_t *encoded);
 
+/* correct_reed_solomon_fragment_t describes one piece of a
+ * message that is not held in one contiguous buffer, e.g. the
+ * fragments of a scatter-gather list.
+ */
+typedef struct {
+    const uint8_t *data;
+    size_t length;
+} correct_reed_solomon_fragment_t;
+
+/* correct_reed_solomon_encode_begin starts an incremental encode.
+ * The parity of a block can be computed while its payload is still
+ * arriving by calling correct_reed_solomon_encode_update or
+ * correct_reed_solomon_encode_updatev once per fragment, in order,
+ * and then correct_reed_solomon_encode_final.
+ *
+ * The rs instance holds the state of one incremental encode at a
+ * time. Calling begin discards any encode in progress.
+ *
+ * This function returns 0, or -1 on invalid input.
+ */
+ssize_t correct_reed_solomon_encode_begin(correct_reed_solomon *rs);
+
+/* correct_reed_solomon_encode_update feeds the next fragment_length
+ * bytes of the payload into an incremental encode. The fragment is
+ * not retained, so it may be reused as soon as this call returns.
+ *
+ * The payload as a whole should be no more than the payload size for
+ * one block. A fragment that would exceed it is rejected, leaving the
+ * encode as it was.
+ *
+ * This function returns the number of payload bytes fed in so far,
+ * or -1 on invalid input.
+ */
+ssize_t correct_reed_solomon_encode_update(correct_reed_solomon *rs, const uint8_t *fragment, size_t fragment_length);
+
+/* correct_reed_solomon_encode_updatev is like
+ * correct_reed_solomon_encode_update, but it feeds in each of
+ * num_fragments fragments in turn. If any fragment is invalid, none
+ * of them are fed in.
+ */
+ssize_t correct_reed_solomon_encode_updatev(correct_reed_solomon *rs, const correct_reed_solomon_fragment_t *fragments, size_t num_fragments);
+
+/* correct_reed_solomon_encode_final finishes an incremental encode
+ * and writes num_roots parity bytes to parity. These are the same
+ * bytes that correct_reed_solomon_encode would have written after the
+ * payload, had the fragments been handed to it as one buffer.
+ *
+ * The rs instance is then ready to begin the next block.
+ *
+ * This function returns the number of bytes written to parity, or
+ * -1 on invalid input.
+ */
+ssize_t correct_reed_solomon_encode_final(correct_reed_solomon *rs, uint8_t *parity);
+
 /* correct_reed_solomon_decode uses the rs instance to decode
  * a payload from a block containing payload and parity bytes.
  * This function can recover in spite of some bytes being corrupted.
@@ -257,10 +794,345 @@ ssize_t correct_reed_solomon_decode(correct_reed_solomon *rs, const uint8_t *enc
  */
 ssize_t correct_reed_solomon_decode_with_erasures(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length, const uint8_t *erasure_locations, size_t erasure_length, uint8_t *msg);
 
+/* correct_reed_solomon_decode_erasures_only uses the rs instance
+ * to decode a payload from a block whose only damage is at the
+ * given erasure_locations, e.g. a block assembled from storage
+ * where some disks or packets are known to be missing. The bytes
+ * at the erased indices may hold any value.
+ *
+ * Unlike correct_reed_solomon_decode_with_erasures, this function
+ * does not search for unknown errors. It only needs the first
+ * erasure_length syndromes, and it caches the work that depends
+ * on the erasure pattern, so consecutive calls which share the
+ * same erasure_locations and encoded_length are much faster.
+ * If the block contains errors outside of erasure_locations,
+ * the payload written to msg will be wrong and no error is
+ * reported.
+ *
+ * erasure_locations should contain erasure_length distinct items.
+ * erasure_length should not exceed the number of parity
+ * bytes encoded into this block.
+ *
+ * msg should be long enough to contain a decoded payload for
+ * this encoded block.
+ *
+ * This function returns a positive number of bytes written to msg
+ * if it has decoded or -1 if it has encountered an error.
+ */
+ssize_t correct_reed_solomon_decode_erasures_only(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length, const uint8_t *erasure_locations, size_t erasure_length, uint8_t *msg);
+
+/* correct_reed_solomon_check uses the rs instance to test
+ * whether a block containing payload and parity bytes arrived
+ * intact, without decoding it. This is much cheaper than
+ * correct_reed_solomon_decode, as it reads the block in place
+ * and stops at the first sign of corruption.
+ *
+ * Any corruption of fewer than num_roots + 1 bytes is always
+ * detected. Heavier corruption may go unnoticed with
+ * probability about 1 in 256^num_roots.
+ *
+ * This function returns 1 if the block is clean, 0 if it is
+ * corrupted or -1 on invalid input.
+ */
+ssize_t correct_reed_solomon_check(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length);
+
+/* correct_reed_solomon_check_blocks runs correct_reed_solomon_check
+ * over num_blocks consecutive blocks of encoded_length bytes each.
+ *
+ * If clean is not NULL, it should hold num_blocks bytes, and every
+ * block is checked, with 1 written for each clean block and 0 for
+ * each corrupted one. If clean is NULL, checking stops at the first
+ * corrupted block.
+ *
+ * This function returns the number of corrupted blocks found, so
+ * 0 means that every block is clean. It returns -1 on invalid input.
+ */
+ssize_t correct_reed_solomon_check_blocks(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length, size_t num_blocks, uint8_t *clean);
+
 /* correct_reed_solomon_destroy releases the resources
  * associated with rs. This pointer should not be
  * used for any functions after this call.
  */
 void correct_reed_solomon_destroy(correct_reed_solomon *rs);
 
+// Reed-Solomon over GF(2^m)
+
+struct correct_reed_solomon_int;
+typedef struct correct_reed_solomon_int correct_reed_solomon_int;
+
+static const uint32_t correct_rs_primitive_polynomial_4_1_0 =
+    0x13;  // x^4 + x + 1
+
+static const uint32_t correct_rs_primitive_polynomial_5_2_0 =
+    0x25;  // x^5 + x^2 + 1
+
+static const uint32_t correct_rs_primitive_polynomial_6_1_0 =
+    0x43;  // x^6 + x + 1
+
+static const uint32_t correct_rs_primitive_polynomial_7_3_0 =
+    0x89;  // x^7 + x^3 + 1
+
+static const uint32_t correct_rs_primitive_polynomial_9_4_0 =
+    0x211;  // x^9 + x^4 + 1
+
+static const uint32_t correct_rs_primitive_polynomial_10_3_0 =
+    0x409;  // x^10 + x^3 + 1
+
+static const uint32_t correct_rs_primitive_polynomial_11_2_0 =
+    0x805;  // x^11 + x^2 + 1
+
+static const uint32_t correct_rs_primitive_polynomial_12_6_4_1_0 =
+    0x1053;  // x^12 + x^6 + x^4 + x + 1
+
+static const uint32_t correct_rs_primitive_polynomial_13_4_3_1_0 =
+    0x201b;  // x^13 + x^4 + x^3 + x + 1
+
+static const uint32_t correct_rs_primitive_polynomial_14_10_6_1_0 =
+    0x4443;  // x^14 + x^10 + x^6 + x + 1
+
+static const uint32_t correct_rs_primitive_polynomial_15_1_0 =
+    0x8003;  // x^15 + x + 1
+
+static const uint32_t correct_rs_primitive_polynomial_16_12_3_1_0 =
+    0x1100b;  // x^16 + x^12 + x^3 + x + 1
+
+/* correct_reed_solomon_int_create allocates and initializes an
+ * encoder/decoder for a reed solomon code over GF(2^symbol_size)
+ * with symbols held in uint16_t. symbol_size may be 2 through 16,
+ * and the block size is 2^symbol_size - 1 symbols, e.g. 65535
+ * symbols with 16-bit symbols.
+ *
+ * primitive_polynomial must be a primitive polynomial of degree
+ * symbol_size, such as one of the given values in this file
+ * (the GF(2^8) values above also work with symbol_size 8).
+ * generator_root_gap must be coprime with the block size. Sane
+ * values for first_consecutive_root and generator_root_gap are
+ * 1 and 1.
+ *
+ * This function returns NULL if the parameters don't describe
+ * a valid code.
+ */
+correct_reed_solomon_int *correct_reed_solomon_int_create(unsigned int symbol_size, uint32_t primitive_polynomial, uint16_t first_consecutive_root, uint16_t generator_root_gap, size_t num_roots);
+
+/* correct_reed_solomon_int_encode uses the rs instance to encode
+ * parity symbols onto a block of data. msg_length should be no
+ * more than the payload size for one block. Shorter blocks will
+ * be encoded with virtual padding where the padding is not emitted.
+ * Only the low symbol_size bits of each symbol are used.
+ *
+ * encoded should be at least msg_length + num_roots symbols long.
+ * It is allowable for msg and encoded to be the same pointer.
+ *
+ * This function returns the number of symbols written to encoded
+ * or -1 on invalid input.
+ */
+ssize_t correct_reed_solomon_int_encode(correct_reed_solomon_int *rs, const uint16_t *msg, size_t msg_length, uint16_t *encoded);
+
+/* correct_reed_solomon_int_decode uses the rs instance to decode
+ * a payload from a block containing payload and parity symbols.
+ * It can repair as many as num_roots/2 corrupted symbols.
+ *
+ * msg should be long enough to contain a decoded payload for
+ * this encoded block.
+ *
+ * This function returns a positive number of symbols written to
+ * msg if it has decoded or -1 if it has encountered an error.
+ */
+ssize_t correct_reed_solomon_int_decode(correct_reed_solomon_int *rs, const uint16_t *encoded, size_t encoded_length, uint16_t *msg);
+
+/* correct_reed_solomon_int_decode_with_erasures is the GF(2^m)
+ * counterpart of correct_reed_solomon_decode_with_erasures.
+ * erasure_locations holds the indices of suspect symbols, and the
+ * quantity (num_erasures + 2*num_errors) must not exceed num_roots.
+ *
+ * This function returns a positive number of symbols written to
+ * msg if it has decoded or -1 if it has encountered an error.
+ */
+ssize_t correct_reed_solomon_int_decode_with_erasures(correct_reed_solomon_int *rs, const uint16_t *encoded, size_t encoded_length, const uint16_t *erasure_locations, size_t erasure_length, uint16_t *msg);
+
+/* correct_reed_solomon_int_destroy releases the resources
+ * associated with rs. This pointer should not be
+ * used for any functions after this call.
+ */
+void correct_reed_solomon_int_destroy(correct_reed_solomon_int *rs);
+
+// Concatenated Codes
+
+/* correct_concatenated_stats_t reports what the outer code
+ * repaired in one frame.
+ */
+typedef struct {
+    // position of this frame in the order it was pushed, from 0
+    size_t frame_index;
+    // bytes repaired by Reed-Solomon, over all codewords in the frame
+    size_t corrected_bytes;
+    // the most bytes repaired in any one codeword of the frame
+    size_t max_corrected_bytes;
+    // codewords that had too many errors to repair
+    size_t failed_codewords;
+} correct_concatenated_stats_t;
+
+struct correct_concatenated;
+typedef struct correct_concatenated correct_concatenated;
+
+/* correct_concatenated_create allocates and initializes a decoding
+ * pipeline for the CCSDS concatenated code: a rate 1/2, order 7
+ * convolutional inner code around interleave_depth RS(255, 223)
+ * outer codewords, interleaved byte by byte. Each frame carries
+ * interleave_depth * 223 bytes of payload.
+ *
+ * Frames move through the pipeline in order. Soft symbols go in,
+ * the convolutional code is decoded, each codeword is de-interleaved
+ * and repaired, and the payload comes out. As many as ring_length
+ * frames may be in flight at once.
+ *
+ * If threaded is nonzero, the convolutional and Reed-Solomon stages
+ * each run on their own thread, so consecutive frames are decoded
+ * in parallel. Otherwise, or where threads are unavailable, both
+ * stages run inside correct_concatenated_push_soft.
+ *
+ * The convolutional stage uses the SSE decoder when the library is
+ * built with SSE.
+ */
+correct_concatenated *correct_concatenated_create(size_t interleave_depth, size_t ring_length, int threaded);
+
+/* correct_concatenated_frame_len returns the number of payload
+ * bytes in one frame.
+ */
+size_t correct_concatenated_frame_len(correct_concatenated *cc);
+
+/* correct_concatenated_encode_len returns the number of *bits*
+ * in one encoded frame, which is also the number of soft symbols
+ * that correct_concatenated_push_soft expects.
+ */
+size_t correct_concatenated_encode_len(correct_concatenated *cc);
+
+/* correct_concatenated_encode encodes one frame of payload into
+ * encoded, which must be long enough to hold
+ * correct_concatenated_encode_len bits. Encoding does not disturb
+ * frames in flight.
+ *
+ * This function returns the number of bits written to encoded.
+ */
+size_t correct_concatenated_encode(correct_concatenated *cc, const uint8_t *frame, uint8_t *encoded);
+
+/* correct_concatenated_push_soft feeds the soft symbols of one
+ * encoded frame into the pipeline. encoded should hold
+ * correct_concatenated_encode_len symbols, with the same mapping
+ * as correct_convolutional_decode_soft. The symbols are copied into
+ * the pipeline; correct_concatenated_acquire_soft avoids the copy.
+ *
+ * This call never waits. If ring_length frames are already in
+ * flight, the oldest must be popped before another can be pushed.
+ *
+ * This function returns 0 if the frame was accepted or -1 if it
+ * was not.
+ */
+ssize_t correct_concatenated_push_soft(correct_concatenated *cc, const correct_convolutional_soft_t *encoded);
+
+/* correct_concatenated_push_soft_wait is correct_concatenated_push_soft,
+ * except that when ring_length frames are in flight in a threaded
+ * pipeline, it waits until the oldest has been popped. Frames must
+ * then be popped by another thread, or this call never returns. In
+ * a pipeline without threads, it behaves as
+ * correct_concatenated_push_soft.
+ */
+ssize_t correct_concatenated_push_soft_wait(correct_concatenated *cc, const correct_convolutional_soft_t *encoded);
+
+/* correct_concatenated_acquire_soft returns the pipeline's own
+ * buffer for the next frame's soft symbols, so that the caller can
+ * write correct_concatenated_encode_len symbols there directly, then
+ * hand the frame over with correct_concatenated_commit_soft. Until
+ * then, the frame is not in flight.
+ *
+ * Like correct_concatenated_push_soft, this call never waits, and
+ * returns NULL if ring_length frames are already in flight.
+ * correct_concatenated_acquire_soft_wait waits instead, as
+ * correct_concatenated_push_soft_wait does.
+ */
+correct_convolutional_soft_t *correct_concatenated_acquire_soft(correct_concatenated *cc);
+correct_convolutional_soft_t *correct_concatenated_acquire_soft_wait(correct_concatenated *cc);
+
+/* correct_concatenated_commit_soft puts the frame whose symbols were
+ * written to the buffer from correct_concatenated_acquire_soft into
+ * the pipeline. The buffer must not be touched after this call.
+ *
+ * This function returns 0 if the frame was accepted or -1 if no
+ * buffer was acquired.
+ */
+ssize_t correct_concatenated_commit_soft(correct_concatenated *cc);
+
+/* correct_concatenated_pop waits for the oldest frame in flight
+ * to finish decoding and copies its payload to frame, which must
+ * hold correct_concatenated_frame_len bytes. If stats is not NULL,
+ * the outer code's statistics for this frame are written there.
+ * Bytes of codewords that could not be repaired are written as the
+ * inner decoder produced them. correct_concatenated_peek avoids the
+ * copy.
+ *
+ * This function returns the number of bytes written to frame or -1
+ * if no frame is in flight.
+ */
+ssize_t correct_concatenated_pop(correct_concatenated *cc, uint8_t *frame, correct_concatenated_stats_t *stats);
+
+/* correct_concatenated_peek waits for the oldest frame in flight to
+ * finish decoding, as correct_concatenated_pop does, and returns a
+ * pointer to its correct_concatenated_frame_len bytes of payload
+ * inside the pipeline, or NULL if no frame is in flight. The frame
+ * stays in flight, and its slot unusable by new frames, until
+ * correct_concatenated_release is called. The pointer must not be
+ * used after that.
+ */
+const uint8_t *correct_concatenated_peek(correct_concatenated *cc, correct_concatenated_stats_t *stats);
+
+/* correct_concatenated_release ends the oldest frame's time in the
+ * pipeline, once it has been decoded, and frees its slot.
+ *
+ * This function returns 0 if a frame was released or -1 if the
+ * oldest frame in flight has not finished decoding, or there is none.
+ */
+ssize_t correct_concatenated_release(correct_concatenated *cc);
+
+/* correct_concatenated_destroy stops the pipeline's threads and
+ * releases its resources. Frames still in flight are discarded.
+ */
+void correct_concatenated_destroy(correct_concatenated *cc);
+
+// Profiling
+
+/* correct_profile_stage_t reports the time spent in one stage of the
+ * decoders. The convolutional stages are the branch metrics, filling
+ * the lookup tables from them, the add-compare-select, path metric
+ * renormalization, traceback and writing out decoded bits. The
+ * Reed-Solomon stages are the syndromes, Berlekamp-Massey, the Chien
+ * search and Forney's algorithm.
+ *
+ * ticks are TSC cycles on x86 and nanoseconds elsewhere. Timing a
+ * stage costs a few tens of cycles, which matters most for the
+ * per-time slice stages of small convolutional codes, so compare
+ * stages of the same build rather than absolute times.
+ */
+typedef struct {
+    const char *name;
+    uint64_t calls;
+    uint64_t ticks;
+} correct_profile_stage_t;
+
+/* correct_profile_dump writes the time spent in each stage, summed
+ * over every thread, to stages, which must hold max_stages entries.
+ * Each thread adds to its own counters, so this should be called
+ * while no decoder is running if the totals are to be exact.
+ * correct_profile_reset sets every thread's counters back to 0.
+ *
+ * The stages are only timed when the library is built with the
+ * Profiling CMake build type, which defines CORRECT_PROFILE.
+ * Otherwise the timing is compiled out.
+ *
+ * correct_profile_dump returns the number of stages written, or -1
+ * if the library isn't built for profiling. correct_profile_reset
+ * returns 0, or -1 if the library isn't built for profiling.
+ */
+ssize_t correct_profile_dump(correct_profile_stage_t *stages, size_t max_stages);
+ssize_t correct_profile_reset(void);
+
 #endif  /* CORRECT_H */
@@ -0,0 +1,90 @@
+#ifndef CORRECT_CONCATENATED_H
+#define CORRECT_CONCATENATED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "correct.h"
+#include "correct/portable.h"
+
+#ifdef HAVE_SSE
+#include "correct-sse.h"
+typedef correct_convolutional_sse concatenated_conv_t;
+#else
+typedef correct_convolutional concatenated_conv_t;
+#endif
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+// CCSDS inner code, r=1/2 k=7. these are libfec's polynomials in libcorrect's bit order
+static const correct_convolutional_polynomial_t concatenated_conv_polynomial[] = {0155, 0117};
+static const size_t concatenated_conv_rate = 2;
+static const size_t concatenated_conv_order = 7;
+
+// CCSDS outer code, RS(255, 223) with conventional (not dual basis) symbols
+static const size_t concatenated_rs_block_length = 255;
+static const size_t concatenated_rs_message_length = 223;
+static const size_t concatenated_rs_num_roots = 32;
+static const uint8_t concatenated_rs_first_consecutive_root = 112;
+static const uint8_t concatenated_rs_root_gap = 11;
+
+// one frame in flight
+// the viterbi stage decodes soft into codeblock, and the RS stage then repairs
+//   codeblock in place, so the stages never copy a frame between them
+typedef struct {
+    correct_convolutional_soft_t *soft;
+    uint8_t *codeblock;
+    correct_concatenated_stats_t stats;
+} concatenated_slot_t;
+
+struct correct_concatenated {
+    size_t interleave_depth;
+    size_t frame_length;        // interleave_depth * 223 bytes
+    size_t codeblock_length;    // interleave_depth * 255 bytes
+    size_t num_encoded_bits;    // convolutional encoding of one codeblock
+
+    // encoding has its own instances so that it may run alongside the stages
+    correct_convolutional *conv_encoder;
+    correct_reed_solomon *rs_encoder;
+    uint8_t *encode_codeblock;
+
+    // owned by the viterbi stage
+    concatenated_conv_t *conv;
+    // owned by the RS stage
+    correct_reed_solomon *rs;
+    uint8_t *codeword;
+    uint8_t *decoded;
+
+    // single producer, single consumer ring of frames
+    // each cursor counts the frames which have passed one point and is only advanced by
+    //   the one party that owns that point. a slot belongs to the stage whose cursor
+    //   has not yet passed it, so the data path needs no locks
+    concatenated_slot_t *slots;
+    size_t ring_length;
+    size_t pushed;
+    size_t decoded_viterbi;
+    size_t decoded_rs;
+    size_t popped;
+    // set by acquire_soft until the frame is committed, only touched by the pusher
+    bool soft_acquired;
+
+    bool threaded;
+#ifdef HAVE_PTHREAD
+    // only used to sleep when a stage has nothing to do
+    pthread_mutex_t lock;
+    pthread_cond_t advanced;
+    bool shutdown;
+    bool has_viterbi_thread;
+    bool has_rs_thread;
+    pthread_t viterbi_thread;
+    pthread_t rs_thread;
+#endif
+};
+
+#endif  /* CORRECT_CONCATENATED_H */
@@ -12,6 +12,8 @@
 
 #include "correct.h"
 #include "correct/portable.h"
+#include "correct/profile.h"
+#include "correct/probe.h"
 
 typedef unsigned int shift_register_t;
 typedef uint16_t polynomial_t;
@@ -22,9 +24,7 @@ static const soft_t soft_max = UINT8_MAX;
 typedef uint16_t distance_t;
 static const distance_t distance_max = UINT16_MAX;
 
-typedef enum {
-    CORRECT_SOFT_LINEAR,
-    CORRECT_SOFT_QUADRATIC,
-} soft_measurement_t;
+// CORRECT_SOFT_LINEAR or CORRECT_SOFT_QUADRATIC, see correct_convolutional_set_soft_metric
+typedef int soft_measurement_t;
 
 #endif  /* CORRECT_CONVOLUTIONAL_H */
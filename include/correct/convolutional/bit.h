@@ -2,6 +2,7 @@
 #define CORRECT_CONVOLUTIONAL_BIT_H
 
 #include "correct/convolutional.h"
+#include "correct/convolutional/crc.h"
 
 typedef struct {
     uint8_t current_byte;
@@ -9,6 +10,12 @@ typedef struct {
     uint8_t *bytes;
     size_t byte_index;
     size_t len;
+
+    // when crc is set, each byte is folded into crc_reg as it is written, up to crc_len
+    //   bytes, so that the output needs no pass of its own to check it
+    const correct_crc *crc;
+    uint32_t crc_reg;
+    size_t crc_len;
 } bit_writer_t;
 
 bit_writer_t *bit_writer_create(uint8_t *bytes, size_t len);
@@ -18,8 +25,12 @@ void bit_writer_destroy(bit_writer_t *w);
 void bit_writer_write(bit_writer_t *w, uint8_t val, unsigned int n);
 void bit_writer_write_1(bit_writer_t *w, uint8_t val);
 void bit_writer_write_bitlist_reversed(bit_writer_t *w, uint8_t *l, size_t len);
+void bit_writer_write_bits(bit_writer_t *w, uint64_t bits, unsigned int n);
 void bit_writer_flush_byte(bit_writer_t *w);
+void bit_writer_advance(bit_writer_t *w, size_t len);
 size_t bit_writer_length(bit_writer_t *w);
+void bit_writer_set_crc(bit_writer_t *w, const correct_crc *crc, size_t len);
+uint32_t bit_writer_crc(bit_writer_t *w);
 
 typedef struct {
     uint8_t current_byte;
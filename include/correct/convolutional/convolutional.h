@@ -6,7 +6,13 @@
 #include "correct/convolutional/metric.h"
 #include "correct/convolutional/lookup.h"
 #include "correct/convolutional/history_buffer.h"
+#include "correct/convolutional/register_exchange.h"
 #include "correct/convolutional/error_buffer.h"
+#include "correct/convolutional/puncture.h"
+#include "correct/convolutional/soft_input.h"
+#include "correct/convolutional/syndrome.h"
+#include "correct/convolutional/m_algorithm.h"
+#include "correct/convolutional/stats.h"
 
 struct correct_convolutional {
     unsigned int *table;        // size 2**order
@@ -16,12 +22,53 @@ struct correct_convolutional {
     bit_writer_t *bit_writer;
     bit_reader_t *bit_reader;
 
+    // NULL unless punctured, see correct_convolutional_set_puncture
+    correct_convolutional_puncture *puncture;
+    distance_t *sent_distances;     // distances of just the sent bits, 2**rate
+
+    // see correct_convolutional_set_tail_biting
+    bool tail_biting;
+    size_t tail_biting_passes;
+
+    // see correct_convolutional_set_traceback, 0 until set
+    unsigned int traceback_depth;
+    unsigned int traceback_group_length;
+
+    // see correct_convolutional_set_survivor_memory
+    int survivor_memory;
+    size_t register_exchange_max_order;     // the largest order that CORRECT_CONV_SURVIVOR_AUTO uses it for
+
+    // NULL unless set, see correct_convolutional_set_syndrome_check
+    syndrome_check_t *syndrome_check;
+
+    // 0 for the full viterbi decoder, see correct_convolutional_set_m_algorithm
+    size_t m_algorithm_paths;
+    m_algorithm_t *m_algorithm;     // NULL until a block decode needs it
+
+    // low-delay streaming, see correct_convolutional_stream_begin
+    bool streaming;
+    size_t stream_delay;
+
     bool has_init_decode;
     distance_t *distances;
     pair_lookup_t *pair_lookup;
     soft_measurement_t soft_measurement;
+    uint8_t soft_cost[256];     // see metric_soft_cost_fill
+    soft_input_t *soft_input;   // NULL until a decode call takes signed or float input
     history_buffer *history_buffer;
+    register_exchange *register_exchange;   // NULL unless the block decoders use it instead of history_buffer
     error_buffer_t *errors;
+
+    // whole-frame decoding, see convolutional_decode_frame_init
+    uint8_t *frame_history;     // frame_cap slices of frame_slice_bytes, one decision bit per state
+    size_t frame_slice_bytes;
+    size_t frame_cap;
+    size_t frame_len;           // slices decided so far
+    unsigned int frame_renormalize_counter;
+    uint8_t *frame_slice;       // one byte per state, as the add-compare-select writes it
+
+    // see correct_convolutional_get_stats, only updated with CORRECT_CONV_STATS
+    decoder_stats_t stats;
 };
 
 correct_convolutional *_correct_convolutional_init(correct_convolutional *conv, size_t rate, size_t order, const polynomial_t *poly);
@@ -29,8 +76,43 @@ void _correct_convolutional_teardown(correct_convolutional *conv);
 
 // portable versions
 bool _convolutional_decode_init(correct_convolutional *conv, unsigned int min_traceback, unsigned int traceback_length, unsigned int renormalize_interval);
+bool convolutional_decode_set_traceback(correct_convolutional *conv, size_t traceback_depth, size_t traceback_group_length);
+bool convolutional_decode_set_survivor_memory(correct_convolutional *conv, int survivor_memory);
+void convolutional_decode_survivors_reset(correct_convolutional *conv);
+void convolutional_decode_survivors_flush(correct_convolutional *conv);
 void convolutional_decode_warmup(correct_convolutional *conv, unsigned int sets, const uint8_t *soft);
 void convolutional_decode_inner(correct_convolutional *conv, unsigned int sets, const uint8_t *soft);
 void convolutional_decode_tail(correct_convolutional *conv, unsigned int sets, const uint8_t *soft);
+bool convolutional_decode_sets(const correct_convolutional *conv, size_t num_encoded_bits, size_t *sets);
+void convolutional_decode_distances(correct_convolutional *conv, const soft_t *soft, size_t set);
+bool convolutional_decode_m_algorithm(correct_convolutional *conv, size_t sets, const soft_t *soft);
+ssize_t convolutional_decode_syndrome(correct_convolutional *conv, const uint8_t *encoded, const soft_t *soft, size_t sets, uint8_t *msg);
+bool convolutional_decode_crc_begin(correct_convolutional *conv, const correct_crc *crc, size_t sets, size_t *msg_len);
+ssize_t convolutional_decode_crc_end(correct_convolutional *conv, const correct_crc *crc, ssize_t decoded_len, const uint8_t *msg, size_t msg_len);
+bool convolutional_decode_soft_input_begin(correct_convolutional *conv, soft_convert_t convert, const void *encoded, size_t symbol_bits, size_t num_encoded_bits, float scale);
+
+// whole-frame decoding for callers that hand over a frame in pieces
+// path metrics and decisions persist across updates, and traceback runs once at the end
+bool convolutional_decode_frame_init(correct_convolutional *conv, size_t max_sets);
+void convolutional_decode_frame_reset(correct_convolutional *conv, shift_register_t start_state);
+void convolutional_decode_frame_advance(correct_convolutional *conv);
+size_t convolutional_decode_frame_update(correct_convolutional *conv, const soft_t *soft, size_t sets);
+void convolutional_decode_frame_step(correct_convolutional *conv, const soft_t *soft, size_t set, uint8_t *decisions);
+shift_register_t convolutional_decode_frame_best_state(const correct_convolutional *conv);
+size_t convolutional_decode_frame_traceback(correct_convolutional *conv, shift_register_t end_state, size_t num_decoded_bits, uint8_t *msg);
+
+// tail-biting decoding runs on the whole-frame machinery, walking the circular trellis with
+//   the backend's frame update
+bool convolutional_decode_tail_biting_init(correct_convolutional *conv, size_t sets);
+size_t convolutional_decode_tail_biting_depth(const correct_convolutional *conv, size_t sets);
+void convolutional_decode_tail_biting_rewind(correct_convolutional *conv);
+ssize_t convolutional_decode_tail_biting_traceback(correct_convolutional *conv, size_t sets, uint8_t *msg);
+
+// low-delay streaming keeps a ring of decisions on the whole-frame storage, and outputs
+//   one bit per time slice after a fixed-length traceback
+bool convolutional_decode_stream_begin(correct_convolutional *conv, size_t delay);
+uint8_t *convolutional_decode_stream_slot(correct_convolutional *conv);
+size_t convolutional_decode_stream_output(correct_convolutional *conv);
+size_t convolutional_decode_stream_end(correct_convolutional *conv, uint8_t *msg);
 
 #endif  /* CORRECT_CONVOLUTIONAL_CONVOLUTIONAL_H */
@@ -0,0 +1,29 @@
+#ifndef CORRECT_CONVOLUTIONAL_CRC_H
+#define CORRECT_CONVOLUTIONAL_CRC_H
+
+#include "correct/convolutional.h"
+
+// a crc of width 8, 16, 24 or 32 bits, see correct_crc_create
+// the register is kept as the table-driven algorithm wants it: for a reflected crc it sits
+//   in the low width bits, least significant bit first, and otherwise in the high width
+//   bits of 32, so that every width shares the same byte steps
+struct correct_crc {
+    unsigned int width;
+    bool reflected;
+    uint32_t init;          // the initial register, already reflected or shifted up
+    uint32_t xorout;
+
+    // slice-by-8: table[k][b] is the register change for byte b followed by k zero bytes
+    uint32_t table[8][256];
+};
+
+uint32_t crc_begin(const correct_crc *crc);
+uint32_t crc_update(const correct_crc *crc, uint32_t reg, const uint8_t *data, size_t len);
+uint32_t crc_finish(const correct_crc *crc, uint32_t reg);
+
+// the crc as it is sent after the message: most significant byte first, or for a
+//   reflected crc, least significant byte first
+void crc_write(const correct_crc *crc, uint32_t value, uint8_t *dst);
+uint32_t crc_read(const correct_crc *crc, const uint8_t *src);
+
+#endif  /* CORRECT_CONVOLUTIONAL_CRC_H */
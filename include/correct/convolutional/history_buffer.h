@@ -3,6 +3,7 @@
 
 #include "correct/convolutional.h"
 #include "correct/convolutional/bit.h"
+#include "correct/convolutional/stats.h"
 
 // ring buffer of path histories
 // generates output bits after accumulating sufficient history
@@ -38,6 +39,9 @@ typedef struct {
     // how often should we renormalize?
     unsigned int renormalize_interval;
     unsigned int renormalize_counter;
+
+    // the owning decoder's counters, set after create
+    decoder_stats_t *stats;
 } history_buffer;
 
 history_buffer *history_buffer_create(unsigned int min_traceback_length, unsigned int traceback_group_length, unsigned int renormalize_interval, unsigned int num_states, shift_register_t highbit);
@@ -0,0 +1,61 @@
+#ifndef CORRECT_CONVOLUTIONAL_M_ALGORITHM_H
+#define CORRECT_CONVOLUTIONAL_M_ALGORITHM_H
+
+#include "correct/convolutional.h"
+#include "correct/convolutional/bit.h"
+#include "correct/convolutional/stats.h"
+
+// reduced-state decoding by the M-algorithm, for orders where the full trellis is too big
+// rather than every state, only the best max_paths paths survive each time slice. each
+//   path is extended by both input bits, where two paths meet in the same state only
+//   the better survives, as in the viterbi decoder, and the best max_paths of what's
+//   left go on to the next slice
+// each surviving path records which path it came from and its input bit, and these
+//   links are traced back in groups, as history_buffer does for the viterbi decoder
+// the path in a state, valid if slice is the current time slice
+typedef struct {
+    uint32_t slice;
+    uint32_t path;
+} m_algorithm_state_t;
+
+typedef struct {
+    unsigned int max_paths;
+    unsigned int order;
+    unsigned int num_states;    // 2**(order - 1)
+
+    // the surviving paths, with their metrics relative to the best of them
+    unsigned int num_paths;
+    shift_register_t *states;
+    uint32_t *metrics;
+
+    // the extensions of every path for one time slice, before selection
+    shift_register_t *candidate_states;
+    uint32_t *candidate_metrics;
+    uint32_t *candidate_links;      // path << 1 | input bit
+    unsigned int *kept;             // the candidates that survive selection
+    unsigned int select_counts[257];
+
+    m_algorithm_state_t *state_paths;     // one per state
+    uint32_t slice;
+
+    // cap time slices of links, max_paths to a slice, as a ring
+    uint32_t *links;
+    unsigned int min_traceback_length;
+    unsigned int traceback_group_length;
+    unsigned int cap;
+    unsigned int index;
+    unsigned int len;
+
+    uint8_t *fetched;
+
+    // the owning decoder's counters, set after create
+    decoder_stats_t *stats;
+} m_algorithm_t;
+
+m_algorithm_t *m_algorithm_create(unsigned int max_paths, unsigned int order, unsigned int min_traceback_length, unsigned int traceback_group_length);
+void m_algorithm_destroy(m_algorithm_t *m);
+void m_algorithm_reset(m_algorithm_t *m);
+void m_algorithm_step(m_algorithm_t *m, const unsigned int *table, const distance_t *distances, bool zero_input, bit_writer_t *output);
+void m_algorithm_flush(m_algorithm_t *m, bit_writer_t *output);
+
+#endif  /* CORRECT_CONVOLUTIONAL_M_ALGORITHM_H */
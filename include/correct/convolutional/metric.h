@@ -9,31 +9,27 @@ static inline distance_t metric_distance(unsigned int x, unsigned int y) {
     return (distance_t)popcount(x ^ y);
 }
 
-static inline distance_t metric_soft_distance_linear(unsigned int hard_x, const uint8_t *soft_y, size_t len) {
-    distance_t dist = 0;
+// the soft metrics are kept as a table of the cost of receiving soft symbol y when a 0
+//   was sent. a sent 1 costs cost[y ^ 0xff], since 255 is a sure 1
+// every cost is at most soft_max, so the metric never changes how often the decoders
+//   have to renormalize
+void metric_soft_cost_fill(soft_measurement_t measurement, uint8_t *cost);
 
+// fill distances with the distance from each of the 2**len possible outputs to the len
+//   soft symbols in soft_y, output bit i matching symbol i
+// each symbol adds its 0 cost to the outputs with bit i clear and its 1 cost to the rest,
+//   which takes 2 lookups per symbol and one add per output
+static inline void metric_soft_distances(const uint8_t *cost, const uint8_t *soft_y, size_t len, distance_t *distances) {
+    distances[0] = 0;
     for (size_t i = 0; i < len; i++) {
-        uint8_t soft_x = (hard_x & 1) ? 0xff : 0;
-        hard_x >>= 1;
-        
-        uint16_t diff;
-        if (soft_y[i] >= soft_x) {
-            diff = soft_y[i] - soft_x;
-        } else {
-            diff = soft_x - soft_y[i];
-        }
-        
-        uint32_t new_dist = (uint32_t)dist + diff;
-        if (new_dist > UINT16_MAX) {
-            dist = UINT16_MAX;
-        } else {
-            dist = (distance_t)new_dist;
+        distance_t cost_0 = cost[soft_y[i]];
+        distance_t cost_1 = cost[soft_y[i] ^ 0xff];
+        size_t width = (size_t)1 << i;
+        for (size_t j = 0; j < width; j++) {
+            distances[width + j] = distances[j] + cost_1;
+            distances[j] += cost_0;
         }
     }
-
-    return dist;
 }
 
-distance_t metric_soft_distance_quadratic(unsigned int hard_x, const uint8_t *soft_y, size_t len);
-
 #endif  /* CORRECT_CONVOLUTIONAL_METRIC_H */
@@ -0,0 +1,32 @@
+#ifndef CORRECT_CONVOLUTIONAL_PUNCTURE_H
+#define CORRECT_CONVOLUTIONAL_PUNCTURE_H
+
+#include "correct/convolutional.h"
+
+// a puncture pattern repeats every period time slices
+// at each step of the period, some of the rate outputs are sent and the rest are dropped
+struct correct_convolutional_puncture {
+    size_t inv_rate;
+    size_t period;
+    uint8_t *pattern;       // period * inv_rate, as given to create
+
+    unsigned int *masks;    // per step, bit j is set if output j is sent
+    unsigned int *counts;   // per step, how many outputs are sent
+    size_t *offsets;        // per step, how many bits the period sent before it
+    size_t sent;            // bits sent per period
+
+    // per step, every output of the code with its sent bits packed down to the low bits
+    // the decoder measures only the sent bits and looks each output up through this
+    unsigned int *compact;
+};
+
+// how many bits are sent for the first sets time slices, which is also
+//   where time slice sets starts in the punctured stream
+static inline size_t puncture_offset(const correct_convolutional_puncture *puncture, size_t sets) {
+    return (sets / puncture->period) * puncture->sent + puncture->offsets[sets % puncture->period];
+}
+
+bool puncture_sets(const correct_convolutional_puncture *puncture, size_t num_encoded_bits, size_t *sets);
+correct_convolutional_puncture *puncture_copy(const correct_convolutional_puncture *puncture);
+
+#endif  /* CORRECT_CONVOLUTIONAL_PUNCTURE_H */
@@ -0,0 +1,57 @@
+#ifndef CORRECT_CONVOLUTIONAL_REGISTER_EXCHANGE_H
+#define CORRECT_CONVOLUTIONAL_REGISTER_EXCHANGE_H
+
+#include "correct/convolutional.h"
+#include "correct/convolutional/bit.h"
+#include "correct/convolutional/stats.h"
+
+// register-exchange survivor memory, an alternative to history_buffer for small orders
+// each state keeps its whole survivor path in one register. every time slice, a state's
+//   new register is its predecessor's shifted left with the new decision in the low bit
+// the best state's register then already holds the decoded bits, so there is no
+//   traceback, but all num_states registers move every slice
+// registers are path_t wide, which limits cap to 64
+typedef struct {
+    // history entries must be at least this old to be decoded
+    unsigned int min_traceback_length;
+    // we'll decode entries in bursts. this tells us the length of the burst
+    unsigned int traceback_group_length;
+    // bits held per register, min_traceback_length + traceback_group_length
+    unsigned int cap;
+
+    // how many states in the shift register?
+    unsigned int num_states;
+
+    // the path registers for the last time slice, and the ones being written for this one
+    path_t *registers;
+    path_t *next_registers;
+
+    // one decision per state for this time slice, written by the add-compare-select
+    uint8_t *decisions;
+
+    // how many valid bits are there in each register?
+    unsigned int len;
+
+    // how often should we renormalize?
+    unsigned int renormalize_interval;
+    unsigned int renormalize_counter;
+
+    // the owning decoder's counters, set after create
+    decoder_stats_t *stats;
+} register_exchange;
+
+// the longest survivor a register can hold
+static const unsigned int register_exchange_max_cap = 8 * sizeof(path_t);
+
+register_exchange *register_exchange_create(unsigned int min_traceback_length, unsigned int traceback_group_length, unsigned int renormalize_interval, unsigned int num_states);
+void register_exchange_destroy(register_exchange *reg);
+void register_exchange_reset(register_exchange *reg);
+uint8_t *register_exchange_get_slice(register_exchange *reg);
+void register_exchange_swap(register_exchange *reg);
+void register_exchange_update_skip(register_exchange *reg, unsigned int skip);
+void register_exchange_output_skip(register_exchange *reg, distance_t *distances, bit_writer_t *output, unsigned int skip);
+void register_exchange_process_skip(register_exchange *reg, distance_t *distances, bit_writer_t *output, unsigned int skip);
+void register_exchange_process(register_exchange *reg, distance_t *distances, bit_writer_t *output);
+void register_exchange_flush(register_exchange *reg, bit_writer_t *output);
+
+#endif  /* CORRECT_CONVOLUTIONAL_REGISTER_EXCHANGE_H */
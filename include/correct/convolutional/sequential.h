@@ -0,0 +1,50 @@
+#ifndef CORRECT_CONVOLUTIONAL_SEQUENTIAL_H
+#define CORRECT_CONVOLUTIONAL_SEQUENTIAL_H
+
+#include "correct/convolutional.h"
+#include "correct/convolutional/bit.h"
+#include "correct/convolutional/lookup.h"
+
+// sequential decoding by the fano algorithm, for orders too big for any trellis search
+// rather than keeping many paths, the decoder follows one path down the code tree,
+//   moving forward while its metric stays above a running threshold and backing up to
+//   try the other branch when it falls below. the threshold rises in steps of delta as
+//   the path improves and drops by delta when every way forward has been tried, so the
+//   work per bit is small while the noise is and grows only where it isn't
+// the register is a path_t, so orders up to 64 fit, and the output of the register is
+//   the xor of one lookup per byte of it, as the encoder table for order 8 built for
+//   each byte of the polynomials
+
+// one node of the path, a time slice into the block
+typedef struct {
+    path_t reg;         // the encoder's register after this slice's input
+    int64_t gamma;      // the path metric up to this node
+    int32_t metrics[2]; // of the branches out of this node, the better first
+    uint8_t best;       // the input bit of metrics[0]
+    uint8_t tried;      // 0 while on the better branch, 1 on the other
+} sequential_node_t;
+
+struct correct_convolutional_sequential {
+    size_t rate;
+    size_t order;
+    path_t register_mask;
+    unsigned int table[8][256];     // the output for each byte of the register
+
+    // fano metrics, log2(P(symbol | bit) / P(symbol)) - 1/rate, scaled and rounded
+    double eb_n0;
+    int32_t soft_metrics[2][256];
+    int32_t hard_metrics[2][256];   // only 0 and 255 are used
+    int32_t delta;
+
+    size_t compute_budget;      // cycles per time slice of the block
+
+    sequential_node_t *nodes;
+    size_t nodes_cap;
+    soft_t *soft;               // hard input, spread out to a symbol a byte
+    size_t soft_cap;
+
+    bit_writer_t *bit_writer;
+    bit_reader_t *bit_reader;
+};
+
+#endif  /* CORRECT_CONVOLUTIONAL_SEQUENTIAL_H */
@@ -0,0 +1,61 @@
+#ifndef CORRECT_CONVOLUTIONAL_SOFT_INPUT_H
+#define CORRECT_CONVOLUTIONAL_SOFT_INPUT_H
+
+#include "correct/convolutional.h"
+
+// converts n symbols starting at src to soft_t, 0 for a sure 0 up to 255 for a sure 1
+// src always starts on a whole byte, even for formats that pack several symbols per byte
+typedef void (*soft_convert_t)(const void *src, size_t n, float scale, soft_t *dst);
+
+// soft symbols in some format other than soft_t
+// rather than converting the whole block in a pass of its own, the metric stage converts
+//   a chunk at a time as it reaches it, so the converted symbols are still in cache
+typedef struct {
+    // NULL outside of a decode call that takes converted input
+    soft_convert_t convert;
+    const uint8_t *src;
+    size_t symbol_bits;     // bits per source symbol
+    size_t align;           // chunks start on a multiple of this many symbols, a whole byte
+    size_t len;             // source symbols
+    float scale;
+
+    // chunk_len converted symbols, starting at source symbol chunk_start
+    soft_t *chunk;
+    size_t chunk_start;
+    size_t chunk_len;
+} soft_input_t;
+
+// symbols converted at once. large enough for the conversion to run at full width, small
+//   enough to stay in L1
+static const size_t soft_input_chunk_cap = 512;
+
+soft_input_t *soft_input_create(void);
+void soft_input_destroy(soft_input_t *in);
+void soft_input_begin(soft_input_t *in, soft_convert_t convert, const void *src, size_t symbol_bits, size_t len, float scale);
+void soft_input_end(soft_input_t *in);
+const soft_t *soft_input_fill(soft_input_t *in, size_t offset, size_t len);
+
+// the len converted symbols starting at source symbol offset
+static inline const soft_t *soft_input_slice(soft_input_t *in, size_t offset, size_t len) {
+    if (offset >= in->chunk_start && offset + len <= in->chunk_start + in->chunk_len) {
+        return in->chunk + (offset - in->chunk_start);
+    }
+    return soft_input_fill(in, offset, len);
+}
+
+// signed 8-bit symbols, -128 for a sure 0 and 127 for a sure 1. scale is unused
+void soft_convert_s8(const void *src, size_t n, float scale, soft_t *dst);
+// float log-likelihood ratios, positive for 1, scaled and added to 128 before rounding
+void soft_convert_llr_f32(const void *src, size_t n, float scale, soft_t *dst);
+// 4-bit symbols, two per byte with the first in the high nibble, 0 for a sure 0 and 15
+//   for a sure 1. scale is unused
+void soft_convert_u4(const void *src, size_t n, float scale, soft_t *dst);
+// 3-bit symbols, eight per three bytes, packed from the most significant bit down, 0 for
+//   a sure 0 and 7 for a sure 1. scale is unused
+void soft_convert_u3(const void *src, size_t n, float scale, soft_t *dst);
+
+// the soft_t that each packed symbol stands for, spread evenly over 0 to 255
+static const soft_t soft_input_u4_levels[16] = {0, 17, 34, 51, 68, 85, 102, 119, 136, 153, 170, 187, 204, 221, 238, 255};
+static const soft_t soft_input_u3_levels[8] = {0, 36, 73, 109, 146, 182, 219, 255};
+
+#endif  /* CORRECT_CONVOLUTIONAL_SOFT_INPUT_H */
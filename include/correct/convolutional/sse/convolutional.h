@@ -3,6 +3,7 @@
 
 #include "correct/convolutional/convolutional.h"
 #include "correct/convolutional/sse/lookup.h"
+#include "correct/convolutional/sse/team.h"
 // BIG HEAPING TODO sort out the include mess
 
 #include "correct-sse.h"
@@ -20,6 +21,12 @@
 struct correct_convolutional_sse {
     correct_convolutional base_conv;
     oct_lookup_t *oct_lookup;
+    acs_team_t *team;       // NULL unless set, see correct_convolutional_sse_set_threads
 };
 
+void convolutional_sse_decode_acs_range(correct_convolutional_sse *conv, uint8_t *history, shift_register_t begin, shift_register_t end);
+bool convolutional_sse_decode_frame_init(correct_convolutional_sse *conv, size_t max_sets);
+size_t convolutional_sse_decode_frame_update(correct_convolutional_sse *conv, const soft_t *soft, size_t sets);
+void convolutional_sse_decode_frame_step(correct_convolutional_sse *conv, const soft_t *soft, size_t set, uint8_t *decisions);
+
 #endif  /* CORRECT_CONVOLUTIONAL_SSE_H */
@@ -0,0 +1,22 @@
+#ifndef CORRECT_CONVOLUTIONAL_SSE_TEAM_H
+#define CORRECT_CONVOLUTIONAL_SSE_TEAM_H
+
+#include "correct/convolutional.h"
+
+// a team of threads that splits the add-compare-select of each time slice between them
+// each thread owns a fixed range of states, and so the same range of the history slice
+//   and of the error metrics, so nothing is shared but the metrics of the last slice,
+//   which are only read. the thread that calls acs_team_run takes the first range and
+//   waits for the others, which spin between slices and sleep between blocks
+struct correct_convolutional_sse;
+typedef struct acs_team acs_team_t;
+
+acs_team_t *acs_team_create(struct correct_convolutional_sse *conv, unsigned int num_threads, unsigned int num_states);
+void acs_team_destroy(acs_team_t *team);
+// wake the team for a block, and send it back to sleep after
+void acs_team_begin(acs_team_t *team);
+void acs_team_end(acs_team_t *team);
+// run the add-compare-select of one time slice, writing decisions to history
+void acs_team_run(acs_team_t *team, uint8_t *history);
+
+#endif  /* CORRECT_CONVOLUTIONAL_SSE_TEAM_H */
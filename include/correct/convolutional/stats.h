@@ -0,0 +1,84 @@
+#ifndef CORRECT_CONVOLUTIONAL_STATS_H
+#define CORRECT_CONVOLUTIONAL_STATS_H
+
+#include "correct/convolutional.h"
+
+// event counters for the decoders, see correct_convolutional_get_stats
+// each decoder owns one of these, and the parts that renormalize or trace back hold a
+//   pointer to it. every update goes through the functions below, which compile to
+//   nothing unless the library is built with CORRECT_CONV_STATS
+typedef struct {
+    correct_convolutional_stats_t counts;
+    // how far the best path metric has grown since the block began, as the renormalizations
+    //   took it off. what's left in the metrics at the end of the block makes up the rest
+    uint64_t block_growth;
+} decoder_stats_t;
+
+// the USDT probes report the path metric too, so it's followed whenever they're built in
+#if defined(CORRECT_CONV_STATS) || defined(CORRECT_USDT)
+#define DECODER_STATS_PATH_METRIC 1
+#endif
+
+static inline void decoder_stats_begin_block(decoder_stats_t *stats, size_t sets) {
+#ifdef CORRECT_CONV_STATS
+    stats->counts.blocks++;
+    stats->counts.steps += sets;
+#else
+    (void)sets;
+#endif
+#ifdef DECODER_STATS_PATH_METRIC
+    stats->block_growth = 0;
+#else
+    (void)stats;
+#endif
+}
+
+static inline void decoder_stats_step(decoder_stats_t *stats) {
+#ifdef CORRECT_CONV_STATS
+    stats->counts.steps++;
+#else
+    (void)stats;
+#endif
+}
+
+// every path metric just had offset, the best of them, taken off
+static inline void decoder_stats_renormalize(decoder_stats_t *stats, uint32_t offset) {
+#ifdef CORRECT_CONV_STATS
+    stats->counts.renormalizations++;
+    stats->counts.metric_growth += offset;
+#endif
+#ifdef DECODER_STATS_PATH_METRIC
+    stats->block_growth += offset;
+#else
+    (void)stats;
+    (void)offset;
+#endif
+}
+
+static inline void decoder_stats_traceback(decoder_stats_t *stats) {
+#ifdef CORRECT_CONV_STATS
+    stats->counts.tracebacks++;
+#else
+    (void)stats;
+#endif
+}
+
+// the block ended on a path whose metric, since the last renormalization, is metric
+static inline void decoder_stats_end_block(decoder_stats_t *stats, uint32_t metric) {
+#ifdef CORRECT_CONV_STATS
+    stats->counts.metric_growth += metric;
+#endif
+#ifdef DECODER_STATS_PATH_METRIC
+    stats->counts.last_path_metric = stats->block_growth + metric;
+#else
+    (void)stats;
+    (void)metric;
+#endif
+}
+
+// the metric of the path the last block was decoded along, or 0 when it isn't followed
+static inline uint64_t decoder_stats_path_metric(const decoder_stats_t *stats) {
+    return stats->counts.last_path_metric;
+}
+
+#endif  /* CORRECT_CONVOLUTIONAL_STATS_H */
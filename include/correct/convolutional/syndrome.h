@@ -0,0 +1,46 @@
+#ifndef CORRECT_CONVOLUTIONAL_SYNDROME_H
+#define CORRECT_CONVOLUTIONAL_SYNDROME_H
+
+#include "correct/convolutional.h"
+
+// a check for error-free blocks, which then skip the viterbi decoder
+// write each output stream as a polynomial over time, r_k(D) = u(D) g_k(D) for message
+//   u and generator g_k. for a pair of generators g_i, g_j with no common factor, every
+//   codeword has r_i g_k + r_k g_i = 0 for all k, and a g_i + b g_j = 1 for some a and b,
+//   so u = a r_i + b r_j. both are a handful of shifts and xors per 64 time slices
+// a hard-sliced block with a zero syndrome and a zero tail is exactly the encoder's
+//   output for u, so it is also what the viterbi decoder would pick
+typedef struct {
+    unsigned int rate;
+    unsigned int order;
+
+    // generator k taps the input from j time slices ago for every shift in taps[k]
+    unsigned int *num_taps;
+    unsigned int *taps;         // rate rows of order
+
+    // the inverse, u = a r_i + b r_j
+    unsigned int inverse_i;
+    unsigned int inverse_j;
+    unsigned int num_a_taps;
+    unsigned int a_taps[32];
+    unsigned int num_b_taps;
+    unsigned int b_taps[32];
+
+    // for rate 2, each encoded byte split into a nibble per stream
+    uint8_t unzip[256];
+
+    // the hard-sliced streams, rate rows of words_cap words with time slice t at bit
+    //   t % 64 of word t / 64
+    uint64_t *streams;
+    size_t words;
+    size_t words_cap;
+} syndrome_check_t;
+
+syndrome_check_t *syndrome_check_create(unsigned int rate, unsigned int order, const unsigned int *table);
+void syndrome_check_destroy(syndrome_check_t *check);
+bool syndrome_check_reset(syndrome_check_t *check, size_t sets);
+void syndrome_check_load_hard(syndrome_check_t *check, const uint8_t *encoded, size_t sets);
+bool syndrome_check_load_soft(syndrome_check_t *check, const soft_t *soft, size_t offset, size_t len);
+ssize_t syndrome_check_decode(syndrome_check_t *check, size_t sets, uint8_t *msg);
+
+#endif  /* CORRECT_CONVOLUTIONAL_SYNDROME_H */
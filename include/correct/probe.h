@@ -0,0 +1,36 @@
+#ifndef CORRECT_PROBE_H
+#define CORRECT_PROBE_H
+
+// USDT probes, for tracing decodes in a running program with bpftrace or systemtap,
+//   see tools/bpftrace
+// with CORRECT_USDT, each probe is a nop in the code and a note in the binary that the
+//   tracer patches when it attaches, so an untraced probe costs next to nothing. the
+//   arguments should already be at hand, as they're worked out either way
+// every probe is in the libcorrect provider:
+//   conv_decode_begin(conv, sets), conv_decode_end(conv, sets, result, path_metric)
+//   conv_sse_decode_begin(conv, sets), conv_sse_decode_end(conv, sets, result, path_metric)
+//     result is the number of bytes decoded, or -1. path_metric is the metric of the
+//     decoded path, which for hard decisions is the number of encoded bits corrected.
+//     it's 0 for a block the syndrome check found clean, and -1 for a tail-biting block,
+//     whose decoder doesn't keep one
+//     these fire for every block through correct_convolutional_decode and _decode_soft,
+//     the sse versions, and the entry points built on them. streaming and whole-frame
+//     (libfec shim) decodes aren't traced
+//   rs_decode_begin(rs, encoded_length), rs_decode_end(rs, encoded_length, corrected)
+//   rs_decode_erasures_begin(rs, encoded_length, num_erasures),
+//   rs_decode_erasures_end(rs, encoded_length, corrected)
+//     corrected is the number of symbols corrected, erasures included, or the negative
+//     code of a failed decode
+#ifdef CORRECT_USDT
+#include <sys/sdt.h>
+#define CORRECT_PROBE2(name, a, b) DTRACE_PROBE2(libcorrect, name, a, b)
+#define CORRECT_PROBE3(name, a, b, c) DTRACE_PROBE3(libcorrect, name, a, b, c)
+#define CORRECT_PROBE4(name, a, b, c, d) DTRACE_PROBE4(libcorrect, name, a, b, c, d)
+#else
+// the arguments are still named, so values worked out only for a probe don't go unused
+#define CORRECT_PROBE2(name, a, b) do { (void)(a); (void)(b); } while (0)
+#define CORRECT_PROBE3(name, a, b, c) do { (void)(a); (void)(b); (void)(c); } while (0)
+#define CORRECT_PROBE4(name, a, b, c, d) do { (void)(a); (void)(b); (void)(c); (void)(d); } while (0)
+#endif
+
+#endif  /* CORRECT_PROBE_H */
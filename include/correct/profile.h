@@ -0,0 +1,82 @@
+#ifndef CORRECT_PROFILE_H
+#define CORRECT_PROFILE_H
+
+#include <stdint.h>
+
+#include "correct.h"
+
+// time spent in each stage of the decoders, see correct_profile_dump
+// a stage is timed by taking profile_now() before it and handing that to profile_add
+//   after. the Profiling build type defines CORRECT_PROFILE, and without it both compile
+//   to nothing
+typedef enum {
+    PROFILE_CONV_DISTANCES,
+    PROFILE_CONV_FILL,
+    PROFILE_CONV_ACS,
+    PROFILE_CONV_RENORMALIZE,
+    PROFILE_CONV_TRACEBACK,
+    PROFILE_CONV_OUTPUT,
+    PROFILE_RS_SYNDROMES,
+    PROFILE_RS_BERLEKAMP_MASSEY,
+    PROFILE_RS_CHIEN,
+    PROFILE_RS_FORNEY,
+    PROFILE_NUM_STAGES,
+} profile_stage_t;
+
+#ifdef CORRECT_PROFILE
+#ifndef __GNUC__
+#error "CORRECT_PROFILE needs gcc or clang"
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+// each thread adds to its own counters, so the decoders never share a cache line for
+//   them. profile.c keeps a list of every thread's to sum up
+typedef struct profile_counters {
+    uint64_t ticks[PROFILE_NUM_STAGES];
+    uint64_t calls[PROFILE_NUM_STAGES];
+    struct profile_counters *next;
+} profile_counters_t;
+
+extern __thread profile_counters_t *profile_thread_counters;
+profile_counters_t *profile_counters_create(void);
+
+// tsc cycles on x86, nanoseconds elsewhere
+static inline uint64_t profile_now(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#endif
+}
+
+static inline void profile_add(profile_stage_t stage, uint64_t start) {
+    uint64_t end = profile_now();
+    profile_counters_t *counters = profile_thread_counters;
+    if (!counters) {
+        counters = profile_counters_create();
+        if (!counters) {
+            return;
+        }
+    }
+    counters->ticks[stage] += end - start;
+    counters->calls[stage]++;
+}
+#else
+static inline uint64_t profile_now(void) {
+    return 0;
+}
+
+static inline void profile_add(profile_stage_t stage, uint64_t start) {
+    (void)stage;
+    (void)start;
+}
+#endif
+
+#endif  /* CORRECT_PROFILE_H */
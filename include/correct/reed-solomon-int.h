@@ -0,0 +1,64 @@
+#ifndef CORRECT_REED_SOLOMON_INT_H
+#define CORRECT_REED_SOLOMON_INT_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "correct.h"
+#include "correct/portable.h"
+#include "correct/profile.h"
+
+// an element in GF(2^m), m <= 16
+typedef uint16_t field_int_element_t;
+
+// a power of the primitive element alpha
+typedef uint16_t field_int_logarithm_t;
+
+// headroom for arithmetic on elements and logarithms
+typedef uint32_t field_int_operation_t;
+
+typedef struct {
+    unsigned int symbol_size;
+    // number of nonzero elements, 2^m - 1. also a mask for valid symbols
+    field_int_operation_t size;
+    field_int_element_t *exp;
+    field_int_logarithm_t *log;
+} field_int_t;
+
+struct correct_reed_solomon_int {
+    size_t block_length;
+    size_t message_length;
+    size_t min_distance;
+
+    field_int_logarithm_t first_consecutive_root;
+    field_int_logarithm_t generator_root_gap;
+
+    field_int_t *field;
+
+    // generator coefficients as logs, lowest order first, 0 for a zero coefficient
+    field_int_logarithm_t *generator_log;
+    // log of each root of the generator
+    field_int_logarithm_t *generator_root_log;
+
+    // parity LFSR used during encoding
+    field_int_element_t *parity;
+
+    field_int_element_t *syndromes;
+    field_int_element_t *error_locator;
+    field_int_element_t *last_error_locator;
+    field_int_element_t *next_error_locator;
+    field_int_logarithm_t *chien_registers;
+    size_t *error_locations;
+    field_int_element_t *error_vals;
+
+    // split multiplication tables for the SIMD syndrome kernel, 128 bytes per syndrome
+    // for each of the 4 nibbles of a symbol, 16 low bytes and 16 high bytes of
+    //   the product of that nibble with root^16
+    uint8_t *syndrome_tables;
+    bool has_init_decode;
+};
+
+#endif  /* CORRECT_REED_SOLOMON_INT_H */
@@ -10,6 +10,8 @@
 
 #include "correct.h"
 #include "correct/portable.h"
+#include "correct/profile.h"
+#include "correct/probe.h"
 
 // an element in GF(2^8)
 typedef uint8_t field_element_t;
@@ -46,9 +48,24 @@ struct correct_reed_solomon {
     field_element_t *generator_roots;
     field_logarithm_t **generator_root_exp;
 
+    // per-code lookup tables, 256 entries each, built at create
+    // location (degree) of the error whose locator root is the index
+    field_logarithm_t *error_root_location;
+    // locator root of an error at the location (degree) given by the index
+    field_element_t *error_location_root;
+    // log of root^(c-1) for the root given by the index, the forney scale factor
+    field_logarithm_t *error_root_scale_log;
+
     polynomial_t *encoded_polynomial;
     polynomial_t *encoded_remainder;
 
+    // used during incremental encoding
+    // generator coefficients as logs, lowest order first, 0 for a zero coefficient
+    field_logarithm_t *generator_log;
+    // parity LFSR, lowest order first, kept between calls to update
+    field_element_t *stream_parity;
+    size_t stream_length;
+
     field_element_t *syndromes;
     field_element_t *modified_syndromes;
     polynomial_t *received_polynomial;
@@ -73,6 +90,20 @@ struct correct_reed_solomon {
     polynomial_t *init_from_roots_scratch[2];
     bool has_init_decode;
 
+    // used during erasure-only decoding
+    // the recovery matrix maps the first n syndromes onto the values of
+    //   n erasures. it only depends on the erasure pattern, so we keep it
+    //   around until a block arrives with a different pattern
+    uint8_t *erasure_pattern;
+    size_t erasure_pattern_length;
+    size_t erasure_pattern_encoded_length;
+    field_logarithm_t *erasure_recovery;
+    bool has_erasure_pattern;
+
+    // used during verify-only checks
+    // split multiplication tables for the SIMD syndrome kernel, when available
+    uint8_t *check_tables;
+    bool has_init_check;
 };
 
 #endif  /* CORRECT_REED_SOLOMON_H */
@@ -0,0 +1,20 @@
+#ifndef CORRECT_REED_SOLOMON_CHECK_H
+#define CORRECT_REED_SOLOMON_CHECK_H
+
+#include "correct/reed-solomon.h"
+#include "correct/reed-solomon/field.h"
+
+#if defined(__SSE4_1__) || defined(HAVE_NEON)
+#define HAVE_RS_SPLIT_TABLES
+#ifdef HAVE_NEON
+# include "sse2neon.h"
+#else
+# ifdef _MSC_VER
+#  include <intrin.h>
+# else
+#  include <x86intrin.h>
+# endif
+#endif
+#endif
+
+#endif  /* CORRECT_REED_SOLOMON_CHECK_H */
@@ -0,0 +1,103 @@
+#ifndef CORRECT_REED_SOLOMON_FIELD_INT_H
+#define CORRECT_REED_SOLOMON_FIELD_INT_H
+
+#include "correct/reed-solomon-int.h"
+
+// GF(2^m) for 2 <= m <= 16
+// this follows the same conventions as the GF(2^8) field in field.h
+//   log(0) is stored as 0 and is used as a sentinel
+//   log(1) is stored as size (alpha^size = alpha^0 = 1) so that no nonzero element has log 0
+//   exp runs up to 2 * size so that the sum of two logs can be looked up directly
+
+static inline void field_int_destroy(field_int_t *field) {
+    if (field) {
+        if (field->exp) {
+            free(field->exp);
+        }
+
+        if (field->log) {
+            free(field->log);
+        }
+
+        free(field);
+    }
+}
+
+static inline field_int_t *field_int_create(unsigned int symbol_size, field_int_operation_t primitive_poly) {
+    if (symbol_size < 2 || symbol_size > 16) {
+        return NULL;
+    }
+
+    field_int_t *field = (field_int_t *)calloc(1, sizeof(field_int_t));
+    if (!field) {
+        return NULL;
+    }
+
+    field->symbol_size = symbol_size;
+    field->size = (1U << symbol_size) - 1;
+
+    field->exp = (field_int_element_t *)malloc((2 * (size_t)field->size + 1) * sizeof(field_int_element_t));
+    field->log = (field_int_logarithm_t *)calloc((size_t)field->size + 1, sizeof(field_int_logarithm_t));
+    if (!field->exp || !field->log) {
+        field_int_destroy(field);
+        return NULL;
+    }
+
+    field_int_operation_t element = 1;
+    field->exp[0] = (field_int_element_t)element;
+    for (field_int_operation_t i = 1; i <= 2 * field->size; i++) {
+        element <<= 1;
+        element = (element > field->size) ? (element ^ primitive_poly) : element;
+        if (element > field->size || (element == 1 && i < field->size)) {
+            // not a polynomial of this degree, or alpha doesn't generate the whole field
+            field_int_destroy(field);
+            return NULL;
+        }
+        field->exp[i] = (field_int_element_t)element;
+
+        if (i <= field->size) {
+            field->log[element] = (field_int_logarithm_t)i;
+        }
+    }
+
+    return field;
+}
+
+// reduce an arbitrary power of alpha to a valid logarithm in [1, size]
+static inline field_int_logarithm_t field_int_log_mod(const field_int_t *field, uint64_t power) {
+    field_int_operation_t res = (field_int_operation_t)(power % field->size);
+    return (field_int_logarithm_t)(res ? res : field->size);
+}
+
+static inline field_int_element_t field_int_mul_log_element(const field_int_t *field, field_int_logarithm_t l, field_int_logarithm_t r) {
+    // both logs are at most size, so the exp table covers this without a wraparound check
+    return field->exp[(field_int_operation_t)l + (field_int_operation_t)r];
+}
+
+static inline field_int_logarithm_t field_int_mul_log(const field_int_t *field, field_int_logarithm_t l, field_int_logarithm_t r) {
+    field_int_operation_t res = (field_int_operation_t)l + (field_int_operation_t)r;
+    return (field_int_logarithm_t)((res > field->size) ? (res - field->size) : res);
+}
+
+static inline field_int_logarithm_t field_int_div_log(const field_int_t *field, field_int_logarithm_t l, field_int_logarithm_t r) {
+    field_int_operation_t res = field->size + (field_int_operation_t)l - (field_int_operation_t)r;
+    return (field_int_logarithm_t)((res > field->size) ? (res - field->size) : res);
+}
+
+static inline field_int_element_t field_int_mul(const field_int_t *field, field_int_element_t l, field_int_element_t r) {
+    if (!l || !r) {
+        return 0;
+    }
+
+    return field_int_mul_log_element(field, field->log[l], field->log[r]);
+}
+
+static inline field_int_element_t field_int_div(const field_int_t *field, field_int_element_t l, field_int_element_t r) {
+    if (!l || !r) {
+        return 0;
+    }
+
+    return field->exp[field_int_div_log(field, field->log[l], field->log[r])];
+}
+
+#endif  /* CORRECT_REED_SOLOMON_FIELD_INT_H */
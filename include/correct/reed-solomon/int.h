@@ -0,0 +1,20 @@
+#ifndef CORRECT_REED_SOLOMON_INT_INT_H
+#define CORRECT_REED_SOLOMON_INT_INT_H
+
+#include "correct/reed-solomon-int.h"
+#include "correct/reed-solomon/field-int.h"
+
+#if defined(__SSE4_1__) || defined(HAVE_NEON)
+#define HAVE_RS_INT_SPLIT_TABLES
+#ifdef HAVE_NEON
+# include "sse2neon.h"
+#else
+# ifdef _MSC_VER
+#  include <intrin.h>
+# else
+#  include <x86intrin.h>
+# endif
+#endif
+#endif
+
+#endif  /* CORRECT_REED_SOLOMON_INT_INT_H */
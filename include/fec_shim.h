@@ -12,6 +12,26 @@ void free_rs_char(void *rs);
 void encode_rs_char(void *rs, const unsigned char *msg, unsigned char *parity);
 int decode_rs_char(void *rs, unsigned char *block, int *erasure_locations, int num_erasures);
 
+// The CCSDS (255, 223) code: 0x187, first root 112, root gap 11, 32 roots.
+// encode_rs_8 and decode_rs_8 take symbols in the conventional basis, while
+//   encode_rs_ccsds and decode_rs_ccsds take them in the dual basis CCSDS
+//   transmits. pad shortens the block as in init_rs_char.
+// As in libfec, the decoders repair the whole block, parity included, and
+//   return the number of symbols corrected, or -1 if the block could not be
+//   decoded or an erasure lies outside it.
+// Each thread has its own decoder. Where pthreads are unavailable, one decoder
+//   is shared, and these must not be called from several threads at once.
+void encode_rs_8(unsigned char *data, unsigned char *parity, int pad);
+int decode_rs_8(unsigned char *data, int *erasure_locations, int num_erasures, int pad);
+void encode_rs_ccsds(unsigned char *data, unsigned char *parity, int pad);
+int decode_rs_ccsds(unsigned char *data, int *erasure_locations, int num_erasures, int pad);
+
+// symbols of 2 to 16 bits, held in ints
+void *init_rs_int(int symbol_size, int primitive_polynomial, int first_consecutive_root, int root_gap, int number_roots, int pad);
+void free_rs_int(void *rs);
+void encode_rs_int(void *rs, const int *msg, int *parity);
+int decode_rs_int(void *rs, int *block, int *erasure_locations, int num_erasures);
+
 // Convolutional Codes
 
 // Polynomials
@@ -37,29 +57,96 @@ int decode_rs_char(void *rs, unsigned char *block, int *erasure_locations, int n
 #define V615POLYF 064537
 
 // Convolutional Methods
+// The unsuffixed functions use the fastest decoder libcorrect was built with.
+// libfec's _port and _sse2 variants are provided too: _port always uses the
+//   portable decoder, and _sse2 is the same as the unsuffixed function.
+// set_viterbi*_polynomial applies to decoders created after it is called.
+// As in libfec, a decoder holds one frame of up to num_decoded_bits bits:
+//   init_viterbi*, then update_viterbi*_blk in as many pieces as convenient
+//   until the message and its K - 1 tail groups are in, then chainback_viterbi*.
 void *create_viterbi27(int num_decoded_bits);
-int init_viterbi27(void *vit, int _mystery);
+int init_viterbi27(void *vit, int starting_state);
 int update_viterbi27_blk(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
-int chainback_viterbi27(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int _mystery);
+int chainback_viterbi27(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
 void delete_viterbi27(void *vit);
+void set_viterbi27_polynomial(int polys[2]);
+
+void *create_viterbi27_port(int num_decoded_bits);
+int init_viterbi27_port(void *vit, int starting_state);
+int update_viterbi27_blk_port(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
+int chainback_viterbi27_port(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
+void delete_viterbi27_port(void *vit);
+void set_viterbi27_polynomial_port(int polys[2]);
+
+void *create_viterbi27_sse2(int num_decoded_bits);
+int init_viterbi27_sse2(void *vit, int starting_state);
+int update_viterbi27_blk_sse2(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
+int chainback_viterbi27_sse2(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
+void delete_viterbi27_sse2(void *vit);
+void set_viterbi27_polynomial_sse2(int polys[2]);
 
 void *create_viterbi29(int num_decoded_bits);
-int init_viterbi29(void *vit, int _mystery);
+int init_viterbi29(void *vit, int starting_state);
 int update_viterbi29_blk(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
-int chainback_viterbi29(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int _mystery);
+int chainback_viterbi29(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
 void delete_viterbi29(void *vit);
+void set_viterbi29_polynomial(int polys[2]);
+
+void *create_viterbi29_port(int num_decoded_bits);
+int init_viterbi29_port(void *vit, int starting_state);
+int update_viterbi29_blk_port(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
+int chainback_viterbi29_port(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
+void delete_viterbi29_port(void *vit);
+void set_viterbi29_polynomial_port(int polys[2]);
+
+void *create_viterbi29_sse2(int num_decoded_bits);
+int init_viterbi29_sse2(void *vit, int starting_state);
+int update_viterbi29_blk_sse2(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
+int chainback_viterbi29_sse2(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
+void delete_viterbi29_sse2(void *vit);
+void set_viterbi29_polynomial_sse2(int polys[2]);
 
 void *create_viterbi39(int num_decoded_bits);
-int init_viterbi39(void *vit, int _mystery);
+int init_viterbi39(void *vit, int starting_state);
 int update_viterbi39_blk(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
-int chainback_viterbi39(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int _mystery);
+int chainback_viterbi39(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
 void delete_viterbi39(void *vit);
+void set_viterbi39_polynomial(int polys[3]);
+
+void *create_viterbi39_port(int num_decoded_bits);
+int init_viterbi39_port(void *vit, int starting_state);
+int update_viterbi39_blk_port(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
+int chainback_viterbi39_port(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
+void delete_viterbi39_port(void *vit);
+void set_viterbi39_polynomial_port(int polys[3]);
+
+void *create_viterbi39_sse2(int num_decoded_bits);
+int init_viterbi39_sse2(void *vit, int starting_state);
+int update_viterbi39_blk_sse2(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
+int chainback_viterbi39_sse2(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
+void delete_viterbi39_sse2(void *vit);
+void set_viterbi39_polynomial_sse2(int polys[3]);
 
 void *create_viterbi615(int num_decoded_bits);
-int init_viterbi615(void *vit, int _mystery);
+int init_viterbi615(void *vit, int starting_state);
 int update_viterbi615_blk(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
-int chainback_viterbi615(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int _mystery);
+int chainback_viterbi615(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
 void delete_viterbi615(void *vit);
+void set_viterbi615_polynomial(int polys[6]);
+
+void *create_viterbi615_port(int num_decoded_bits);
+int init_viterbi615_port(void *vit, int starting_state);
+int update_viterbi615_blk_port(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
+int chainback_viterbi615_port(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
+void delete_viterbi615_port(void *vit);
+void set_viterbi615_polynomial_port(int polys[6]);
+
+void *create_viterbi615_sse2(int num_decoded_bits);
+int init_viterbi615_sse2(void *vit, int starting_state);
+int update_viterbi615_blk_sse2(void *vit, unsigned char *encoded_soft, int n_encoded_groups);
+int chainback_viterbi615_sse2(void *vit, unsigned char *decoded, unsigned int n_decoded_bits, unsigned int endstate);
+void delete_viterbi615_sse2(void *vit);
+void set_viterbi615_polynomial_sse2(int polys[6]);
 
 // Misc other
 static inline int parity(unsigned int x) {
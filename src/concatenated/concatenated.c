@@ -0,0 +1,447 @@
+#include "correct/concatenated.h"
+
+#ifdef HAVE_SSE
+#define concatenated_conv_create correct_convolutional_sse_create
+#define concatenated_conv_destroy correct_convolutional_sse_destroy
+#define concatenated_conv_decode_soft correct_convolutional_sse_decode_soft
+#else
+#define concatenated_conv_create correct_convolutional_create
+#define concatenated_conv_destroy correct_convolutional_destroy
+#define concatenated_conv_decode_soft correct_convolutional_decode_soft
+#endif
+
+#ifdef HAVE_PTHREAD
+// cursors are read by one thread while another advances them
+static inline size_t concatenated_cursor_load(const size_t *cursor) {
+    return __atomic_load_n(cursor, __ATOMIC_ACQUIRE);
+}
+
+static inline void concatenated_cursor_store(size_t *cursor, size_t val) {
+    __atomic_store_n(cursor, val, __ATOMIC_RELEASE);
+}
+#else
+static inline size_t concatenated_cursor_load(const size_t *cursor) {
+    return *cursor;
+}
+
+static inline void concatenated_cursor_store(size_t *cursor, size_t val) {
+    *cursor = val;
+}
+#endif
+
+// viterbi stage -- soft symbols to a byte aligned codeblock
+static void concatenated_viterbi_stage(correct_concatenated *cc, concatenated_slot_t *slot) {
+    concatenated_conv_decode_soft(cc->conv, slot->soft, cc->num_encoded_bits, slot->codeblock);
+}
+
+// RS stage -- de-interleave each codeword, repair it and write the payload back in place
+// codeword j holds the codeblock bytes j, j + depth, j + 2*depth...
+static void concatenated_rs_stage(correct_concatenated *cc, concatenated_slot_t *slot) {
+    size_t depth = cc->interleave_depth;
+    correct_concatenated_stats_t *stats = &slot->stats;
+
+    stats->corrected_bytes = 0;
+    stats->max_corrected_bytes = 0;
+    stats->failed_codewords = 0;
+
+    for (size_t j = 0; j < depth; j++) {
+        for (size_t i = 0; i < concatenated_rs_block_length; i++) {
+            cc->codeword[i] = slot->codeblock[i * depth + j];
+        }
+
+        ssize_t num_corrected = correct_reed_solomon_decode(cc->rs, cc->codeword, concatenated_rs_block_length, cc->decoded);
+        if (num_corrected < 0) {
+            // leave this codeword's bytes as the viterbi stage found them
+            stats->failed_codewords++;
+            continue;
+        }
+
+        stats->corrected_bytes += (size_t)num_corrected;
+        if ((size_t)num_corrected > stats->max_corrected_bytes) {
+            stats->max_corrected_bytes = (size_t)num_corrected;
+        }
+
+        for (size_t i = 0; i < concatenated_rs_message_length; i++) {
+            slot->codeblock[i * depth + j] = cc->decoded[i];
+        }
+    }
+}
+
+#ifdef HAVE_PTHREAD
+// block until *cursor reaches target
+// returns false if the pipeline is shutting down
+static bool concatenated_wait(correct_concatenated *cc, const size_t *cursor, size_t target) {
+    if (!cc->threaded) {
+        // the stages run inside push, so nothing else will move this cursor
+        return concatenated_cursor_load(cursor) >= target;
+    }
+
+    // frames take a while to decode, so a short spin rarely succeeds where a sleep wouldn't
+    for (unsigned int i = 0; i < 64; i++) {
+        if (concatenated_cursor_load(cursor) >= target) {
+            return true;
+        }
+    }
+
+    pthread_mutex_lock(&cc->lock);
+    while (concatenated_cursor_load(cursor) < target && !cc->shutdown) {
+        pthread_cond_wait(&cc->advanced, &cc->lock);
+    }
+    bool ok = !cc->shutdown;
+    pthread_mutex_unlock(&cc->lock);
+    return ok;
+}
+
+static void concatenated_advance(correct_concatenated *cc, size_t *cursor) {
+    concatenated_cursor_store(cursor, *cursor + 1);
+
+    if (cc->threaded) {
+        // wake whoever was waiting on this cursor
+        pthread_mutex_lock(&cc->lock);
+        pthread_cond_broadcast(&cc->advanced);
+        pthread_mutex_unlock(&cc->lock);
+    }
+}
+
+static void *concatenated_viterbi_thread(void *arg) {
+    correct_concatenated *cc = (correct_concatenated *)arg;
+    while (concatenated_wait(cc, &cc->pushed, cc->decoded_viterbi + 1)) {
+        concatenated_viterbi_stage(cc, &cc->slots[cc->decoded_viterbi % cc->ring_length]);
+        concatenated_advance(cc, &cc->decoded_viterbi);
+    }
+    return NULL;
+}
+
+static void *concatenated_rs_thread(void *arg) {
+    correct_concatenated *cc = (correct_concatenated *)arg;
+    while (concatenated_wait(cc, &cc->decoded_viterbi, cc->decoded_rs + 1)) {
+        concatenated_rs_stage(cc, &cc->slots[cc->decoded_rs % cc->ring_length]);
+        concatenated_advance(cc, &cc->decoded_rs);
+    }
+    return NULL;
+}
+#else
+static bool concatenated_wait(correct_concatenated *cc, const size_t *cursor, size_t target) {
+    // without threads, every stage has already run by the time we look
+    (void)cc;
+    return concatenated_cursor_load(cursor) >= target;
+}
+
+static void concatenated_advance(correct_concatenated *cc, size_t *cursor) {
+    (void)cc;
+    concatenated_cursor_store(cursor, *cursor + 1);
+}
+#endif
+
+void correct_concatenated_destroy(correct_concatenated *cc) {
+    if (!cc) {
+        return;
+    }
+
+#ifdef HAVE_PTHREAD
+    if (cc->threaded) {
+        pthread_mutex_lock(&cc->lock);
+        cc->shutdown = true;
+        pthread_cond_broadcast(&cc->advanced);
+        pthread_mutex_unlock(&cc->lock);
+
+        if (cc->has_viterbi_thread) {
+            pthread_join(cc->viterbi_thread, NULL);
+        }
+
+        if (cc->has_rs_thread) {
+            pthread_join(cc->rs_thread, NULL);
+        }
+
+        pthread_cond_destroy(&cc->advanced);
+        pthread_mutex_destroy(&cc->lock);
+    }
+#endif
+
+    if (cc->slots) {
+        for (size_t i = 0; i < cc->ring_length; i++) {
+            if (cc->slots[i].soft) {
+                free(cc->slots[i].soft);
+            }
+
+            if (cc->slots[i].codeblock) {
+                free(cc->slots[i].codeblock);
+            }
+        }
+
+        free(cc->slots);
+    }
+
+    if (cc->encode_codeblock) {
+        free(cc->encode_codeblock);
+    }
+
+    if (cc->codeword) {
+        free(cc->codeword);
+    }
+
+    if (cc->decoded) {
+        free(cc->decoded);
+    }
+
+    if (cc->conv) {
+        concatenated_conv_destroy(cc->conv);
+    }
+
+    if (cc->rs) {
+        correct_reed_solomon_destroy(cc->rs);
+    }
+
+    if (cc->conv_encoder) {
+        correct_convolutional_destroy(cc->conv_encoder);
+    }
+
+    if (cc->rs_encoder) {
+        correct_reed_solomon_destroy(cc->rs_encoder);
+    }
+
+    free(cc);
+}
+
+correct_concatenated *correct_concatenated_create(size_t interleave_depth, size_t ring_length, int threaded) {
+    if (interleave_depth == 0 || ring_length == 0) {
+        return NULL;
+    }
+
+    correct_concatenated *cc = (correct_concatenated *)calloc(1, sizeof(correct_concatenated));
+    if (!cc) {
+        return NULL;
+    }
+
+    cc->interleave_depth = interleave_depth;
+    cc->frame_length = interleave_depth * concatenated_rs_message_length;
+    cc->codeblock_length = interleave_depth * concatenated_rs_block_length;
+    cc->ring_length = ring_length;
+
+    cc->conv_encoder = correct_convolutional_create(concatenated_conv_rate, concatenated_conv_order, concatenated_conv_polynomial);
+    cc->conv = concatenated_conv_create(concatenated_conv_rate, concatenated_conv_order, concatenated_conv_polynomial);
+    if (!cc->conv_encoder || !cc->conv) {
+        correct_concatenated_destroy(cc);
+        return NULL;
+    }
+    cc->num_encoded_bits = correct_convolutional_encode_len(cc->conv_encoder, cc->codeblock_length);
+
+    cc->rs_encoder = correct_reed_solomon_create(correct_rs_primitive_polynomial_ccsds, concatenated_rs_first_consecutive_root, concatenated_rs_root_gap, concatenated_rs_num_roots);
+    cc->rs = correct_reed_solomon_create(correct_rs_primitive_polynomial_ccsds, concatenated_rs_first_consecutive_root, concatenated_rs_root_gap, concatenated_rs_num_roots);
+    if (!cc->rs_encoder || !cc->rs) {
+        correct_concatenated_destroy(cc);
+        return NULL;
+    }
+
+    cc->encode_codeblock = (uint8_t *)malloc(cc->codeblock_length);
+    if (!cc->encode_codeblock) {
+        correct_concatenated_destroy(cc);
+        return NULL;
+    }
+
+    cc->codeword = (uint8_t *)malloc(concatenated_rs_block_length);
+    cc->decoded = (uint8_t *)malloc(concatenated_rs_block_length);
+    if (!cc->codeword || !cc->decoded) {
+        correct_concatenated_destroy(cc);
+        return NULL;
+    }
+
+    cc->slots = (concatenated_slot_t *)calloc(ring_length, sizeof(concatenated_slot_t));
+    if (!cc->slots) {
+        correct_concatenated_destroy(cc);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < ring_length; i++) {
+        cc->slots[i].soft = (correct_convolutional_soft_t *)malloc(cc->num_encoded_bits * sizeof(correct_convolutional_soft_t));
+        // the decoder writes whole bytes, including the last partial one
+        cc->slots[i].codeblock = (uint8_t *)malloc(cc->codeblock_length + 1);
+        if (!cc->slots[i].soft || !cc->slots[i].codeblock) {
+            correct_concatenated_destroy(cc);
+            return NULL;
+        }
+    }
+
+#ifdef HAVE_PTHREAD
+    if (threaded) {
+        if (pthread_mutex_init(&cc->lock, NULL) != 0) {
+            correct_concatenated_destroy(cc);
+            return NULL;
+        }
+
+        if (pthread_cond_init(&cc->advanced, NULL) != 0) {
+            pthread_mutex_destroy(&cc->lock);
+            correct_concatenated_destroy(cc);
+            return NULL;
+        }
+
+        // from here on, destroy knows how to tear down the threads
+        cc->threaded = true;
+
+        cc->has_viterbi_thread = pthread_create(&cc->viterbi_thread, NULL, concatenated_viterbi_thread, cc) == 0;
+        if (!cc->has_viterbi_thread) {
+            correct_concatenated_destroy(cc);
+            return NULL;
+        }
+
+        cc->has_rs_thread = pthread_create(&cc->rs_thread, NULL, concatenated_rs_thread, cc) == 0;
+        if (!cc->has_rs_thread) {
+            correct_concatenated_destroy(cc);
+            return NULL;
+        }
+    }
+#else
+    // no thread support on this platform, so the stages run in the caller's thread
+    (void)threaded;
+#endif
+
+    return cc;
+}
+
+size_t correct_concatenated_frame_len(correct_concatenated *cc) {
+    return cc->frame_length;
+}
+
+size_t correct_concatenated_encode_len(correct_concatenated *cc) {
+    return cc->num_encoded_bits;
+}
+
+size_t correct_concatenated_encode(correct_concatenated *cc, const uint8_t *frame, uint8_t *encoded) {
+    size_t depth = cc->interleave_depth;
+    uint8_t codeword[255];
+    uint8_t *codeblock = cc->encode_codeblock;
+
+    // the frame is the payload of depth codewords, interleaved byte by byte,
+    //   followed by the parity of each, interleaved the same way
+    for (size_t j = 0; j < depth; j++) {
+        for (size_t i = 0; i < concatenated_rs_message_length; i++) {
+            codeword[i] = frame[i * depth + j];
+        }
+
+        correct_reed_solomon_encode(cc->rs_encoder, codeword, concatenated_rs_message_length, codeword);
+
+        for (size_t i = 0; i < concatenated_rs_block_length; i++) {
+            codeblock[i * depth + j] = codeword[i];
+        }
+    }
+
+    return correct_convolutional_encode(cc->conv_encoder, codeblock, cc->codeblock_length, encoded);
+}
+
+// a slot is free once the frame that last used it has been released
+static correct_convolutional_soft_t *concatenated_acquire_soft(correct_concatenated *cc, bool wait) {
+    if (!cc) {
+        return NULL;
+    }
+
+    if (cc->pushed >= cc->ring_length) {
+        size_t target = cc->pushed + 1 - cc->ring_length;
+        bool free_slot = wait ? concatenated_wait(cc, &cc->popped, target) : concatenated_cursor_load(&cc->popped) >= target;
+        if (!free_slot) {
+            return NULL;
+        }
+    }
+
+    cc->soft_acquired = true;
+    return cc->slots[cc->pushed % cc->ring_length].soft;
+}
+
+correct_convolutional_soft_t *correct_concatenated_acquire_soft(correct_concatenated *cc) {
+    return concatenated_acquire_soft(cc, false);
+}
+
+correct_convolutional_soft_t *correct_concatenated_acquire_soft_wait(correct_concatenated *cc) {
+    return concatenated_acquire_soft(cc, true);
+}
+
+ssize_t correct_concatenated_commit_soft(correct_concatenated *cc) {
+    if (!cc || !cc->soft_acquired) {
+        return -1;
+    }
+    cc->soft_acquired = false;
+
+    concatenated_slot_t *slot = &cc->slots[cc->pushed % cc->ring_length];
+    slot->stats.frame_index = cc->pushed;
+
+    if (!cc->threaded) {
+        concatenated_viterbi_stage(cc, slot);
+        concatenated_rs_stage(cc, slot);
+        concatenated_advance(cc, &cc->decoded_viterbi);
+        concatenated_advance(cc, &cc->decoded_rs);
+    }
+
+    concatenated_advance(cc, &cc->pushed);
+
+    return 0;
+}
+
+static ssize_t concatenated_push_soft(correct_concatenated *cc, const correct_convolutional_soft_t *encoded, bool wait) {
+    if (!cc || !encoded) {
+        return -1;
+    }
+
+    correct_convolutional_soft_t *soft = concatenated_acquire_soft(cc, wait);
+    if (!soft) {
+        return -1;
+    }
+
+    memcpy(soft, encoded, cc->num_encoded_bits * sizeof(correct_convolutional_soft_t));
+    return correct_concatenated_commit_soft(cc);
+}
+
+ssize_t correct_concatenated_push_soft(correct_concatenated *cc, const correct_convolutional_soft_t *encoded) {
+    return concatenated_push_soft(cc, encoded, false);
+}
+
+ssize_t correct_concatenated_push_soft_wait(correct_concatenated *cc, const correct_convolutional_soft_t *encoded) {
+    return concatenated_push_soft(cc, encoded, true);
+}
+
+const uint8_t *correct_concatenated_peek(correct_concatenated *cc, correct_concatenated_stats_t *stats) {
+    if (!cc) {
+        return NULL;
+    }
+
+    if (cc->popped == concatenated_cursor_load(&cc->pushed)) {
+        // nothing in flight, so nothing would ever arrive
+        return NULL;
+    }
+
+    if (!concatenated_wait(cc, &cc->decoded_rs, cc->popped + 1)) {
+        return NULL;
+    }
+
+    // the payload is the front of the codeblock, ahead of the interleaved parity
+    concatenated_slot_t *slot = &cc->slots[cc->popped % cc->ring_length];
+    if (stats) {
+        *stats = slot->stats;
+    }
+
+    return slot->codeblock;
+}
+
+ssize_t correct_concatenated_release(correct_concatenated *cc) {
+    if (!cc || concatenated_cursor_load(&cc->decoded_rs) <= cc->popped) {
+        return -1;
+    }
+
+    concatenated_advance(cc, &cc->popped);
+
+    return 0;
+}
+
+ssize_t correct_concatenated_pop(correct_concatenated *cc, uint8_t *frame, correct_concatenated_stats_t *stats) {
+    if (!cc || !frame) {
+        return -1;
+    }
+
+    const uint8_t *decoded = correct_concatenated_peek(cc, stats);
+    if (!decoded) {
+        return -1;
+    }
+
+    memcpy(frame, decoded, cc->frame_length);
+    correct_concatenated_release(cc);
+
+    return (ssize_t)cc->frame_length;
+}
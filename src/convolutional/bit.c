@@ -20,6 +20,35 @@ void bit_writer_reconfigure(bit_writer_t *w, uint8_t *bytes, size_t len) {
     w->current_byte = 0;
     w->current_byte_len = 0;
     w->byte_index = 0;
+
+    if (w->crc) {
+        w->crc_reg = crc_begin(w->crc);
+    }
+}
+
+// fold the bytes from index from up to byte_index into the crc
+static inline void bit_writer_crc_update(bit_writer_t *w, size_t from) {
+    if (!w->crc || from >= w->crc_len) {
+        return;
+    }
+
+    size_t to = (w->byte_index < w->crc_len) ? w->byte_index : w->crc_len;
+    if (to > from) {
+        w->crc_reg = crc_update(w->crc, w->crc_reg, w->bytes + from, to - from);
+    }
+}
+
+// check the first len bytes written after the next reconfigure with crc, or stop
+//   checking if crc is NULL
+void bit_writer_set_crc(bit_writer_t *w, const correct_crc *crc, size_t len) {
+    w->crc = crc;
+    w->crc_len = crc ? len : 0;
+    w->crc_reg = crc ? crc_begin(crc) : 0;
+}
+
+// the crc of the bytes checked so far
+uint32_t bit_writer_crc(bit_writer_t *w) {
+    return crc_finish(w->crc, w->crc_reg);
 }
 
 void bit_writer_destroy(bit_writer_t *w) {
@@ -43,6 +72,7 @@ void bit_writer_write_1(bit_writer_t *w, uint8_t val) {
         // 8 bits in a byte -- move to the next byte
         w->bytes[w->byte_index] = w->current_byte;
         w->byte_index++;
+        bit_writer_crc_update(w, w->byte_index - 1);
         w->current_byte_len = 0;
         w->current_byte = 0;
     } else {
@@ -128,7 +158,9 @@ void bit_writer_write_bitlist(bit_writer_t *w, uint8_t *l, size_t len) {
     }
 
     w->current_byte = (uint8_t)(b & 0xFF);
+    size_t from = w->byte_index;
     w->byte_index = byte_index;
+    bit_writer_crc_update(w, from);
     w->current_byte_len = (len > UINT_MAX) ? UINT_MAX : (unsigned int)len;
 }
 
@@ -210,19 +242,67 @@ void bit_writer_write_bitlist_reversed(bit_writer_t *w, uint8_t *l, size_t len)
     }
 
     w->current_byte = (uint8_t)b;
+    size_t from = w->byte_index;
     w->byte_index = byte_index;
+    bit_writer_crc_update(w, from);
     w->current_byte_len = (len > UINT_MAX) ? UINT_MAX : (unsigned int)len;
 }
 
+// write the low n bits of bits, most significant first
+// like the bitlist writers, this writes nothing if the bits don't fit
+void bit_writer_write_bits(bit_writer_t *w, uint64_t bits, unsigned int n) {
+    if (!w || !w->bytes || n == 0) {
+        return;
+    }
+
+    size_t remaining_space = w->len - w->byte_index;
+    size_t bytes_needed = (n + w->current_byte_len + 7) / 8;
+    if (bytes_needed > remaining_space) {
+        return;
+    }
+
+    // fill in 32 bit pieces so that the pending bits and the new ones fit in 64
+    while (n > 32) {
+        n -= 32;
+        bit_writer_write_bits(w, bits >> n, 32);
+    }
+
+    // bit_writer_write_1 keeps current_byte shifted up once past its last bit
+    unsigned int pending = w->current_byte_len + n;
+    uint64_t acc = ((uint64_t)(w->current_byte >> 1) << n) | (bits & ((1ULL << n) - 1));
+    uint8_t *bytes = w->bytes;
+    size_t byte_index = w->byte_index;
+    while (pending >= 8) {
+        pending -= 8;
+        bytes[byte_index] = (uint8_t)(acc >> pending);
+        byte_index++;
+    }
+
+    size_t from = w->byte_index;
+    w->byte_index = byte_index;
+    bit_writer_crc_update(w, from);
+    w->current_byte_len = pending;
+    w->current_byte = (uint8_t)((acc & ((1ULL << pending) - 1)) << 1);
+}
+
 void bit_writer_flush_byte(bit_writer_t *w) {
     if (w->current_byte_len != 0) {
-        w->current_byte <<= (8 - w->current_byte_len);
+        // bit_writer_write_1 has already shifted current_byte up once past its last bit
+        w->current_byte <<= (7 - w->current_byte_len);
         w->bytes[w->byte_index] = w->current_byte;
         w->byte_index++;
+        bit_writer_crc_update(w, w->byte_index - 1);
         w->current_byte_len = 0;
     }
 }
 
+// count len whole bytes that the caller has written at the write position itself
+void bit_writer_advance(bit_writer_t *w, size_t len) {
+    size_t from = w->byte_index;
+    w->byte_index += len;
+    bit_writer_crc_update(w, from);
+}
+
 size_t bit_writer_length(bit_writer_t *w) {
     return w->byte_index;
 }
@@ -40,7 +40,42 @@ correct_convolutional *_correct_convolutional_init(correct_convolutional *conv,
         return NULL;
     }
 
+    conv->puncture = NULL;
+    conv->sent_distances = NULL;
+
+    conv->tail_biting = false;
+    conv->tail_biting_passes = 0;
+
+    conv->traceback_depth = 0;
+    conv->traceback_group_length = 0;
+
+    conv->survivor_memory = CORRECT_CONV_SURVIVOR_AUTO;
+    // measured with tools/sweep_conv_traceback.c, register exchange is ahead of the
+    //   traceback at order 3, level at 4 and behind from 5 on. the add-compare-select costs
+    //   the same either way, and moving every register costs more than the walk back as
+    //   num_states grows
+    conv->register_exchange_max_order = 4;
+    conv->register_exchange = NULL;
+
+    conv->syndrome_check = NULL;
+
+    conv->m_algorithm_paths = 0;
+    conv->m_algorithm = NULL;
+
+    conv->streaming = false;
+    conv->stream_delay = 0;
+
+    conv->soft_measurement = CORRECT_SOFT_LINEAR;
+    metric_soft_cost_fill(conv->soft_measurement, conv->soft_cost);
+    conv->soft_input = NULL;
+
     conv->has_init_decode = false;
+    conv->frame_history = NULL;
+    conv->frame_slice = NULL;
+    conv->frame_cap = 0;
+    conv->frame_len = 0;
+
+    memset(&conv->stats, 0, sizeof(conv->stats));
     return conv;
 }
 
@@ -75,9 +110,38 @@ void _correct_convolutional_teardown(correct_convolutional *conv) {
     if (conv->has_init_decode) {
         pair_lookup_destroy(conv->pair_lookup);
         history_buffer_destroy(conv->history_buffer);
+        register_exchange_destroy(conv->register_exchange);
         error_buffer_destroy(conv->errors);
         free(conv->distances);
     }
+
+    if (conv->puncture) {
+        correct_convolutional_puncture_destroy(conv->puncture);
+    }
+
+    if (conv->sent_distances) {
+        free(conv->sent_distances);
+    }
+
+    if (conv->soft_input) {
+        soft_input_destroy(conv->soft_input);
+    }
+
+    if (conv->syndrome_check) {
+        syndrome_check_destroy(conv->syndrome_check);
+    }
+
+    if (conv->m_algorithm) {
+        m_algorithm_destroy(conv->m_algorithm);
+    }
+
+    if (conv->frame_history) {
+        free(conv->frame_history);
+    }
+
+    if (conv->frame_slice) {
+        ALIGNED_FREE(conv->frame_slice);
+    }
 }
 
 void correct_convolutional_destroy(correct_convolutional *conv) {
@@ -86,3 +150,150 @@ void correct_convolutional_destroy(correct_convolutional *conv) {
         free(conv);    
     }
 }
+
+ssize_t correct_convolutional_set_puncture(correct_convolutional *conv, const correct_convolutional_puncture *puncture) {
+    if (!conv) {
+        return -1;
+    }
+
+    if (puncture && puncture->inv_rate != conv->rate) {
+        return -1;
+    }
+
+    correct_convolutional_puncture *copy = NULL;
+    if (puncture) {
+        copy = puncture_copy(puncture);
+        if (!copy) {
+            return -1;
+        }
+
+        if (!conv->sent_distances) {
+            conv->sent_distances = (distance_t *)calloc((size_t)1 << conv->rate, sizeof(distance_t));
+            if (!conv->sent_distances) {
+                correct_convolutional_puncture_destroy(copy);
+                return -1;
+            }
+        }
+    }
+
+    if (conv->puncture) {
+        correct_convolutional_puncture_destroy(conv->puncture);
+    }
+    conv->puncture = copy;
+
+    return 0;
+}
+
+ssize_t correct_convolutional_set_tail_biting(correct_convolutional *conv, int tail_biting, size_t passes) {
+    if (!conv) {
+        return -1;
+    }
+
+    conv->tail_biting = (tail_biting != 0);
+    conv->tail_biting_passes = passes;
+
+    return 0;
+}
+
+ssize_t correct_convolutional_set_traceback(correct_convolutional *conv, size_t traceback_depth, size_t traceback_group_length) {
+    if (!conv) {
+        return -1;
+    }
+
+    traceback_depth = traceback_depth ? traceback_depth : 5 * conv->order;
+    traceback_group_length = traceback_group_length ? traceback_group_length : 15 * conv->order;
+
+    return convolutional_decode_set_traceback(conv, traceback_depth, traceback_group_length) ? 0 : -1;
+}
+
+ssize_t correct_convolutional_set_survivor_memory(correct_convolutional *conv, int survivor_memory) {
+    if (!conv) {
+        return -1;
+    }
+
+    if (survivor_memory != CORRECT_CONV_SURVIVOR_AUTO && survivor_memory != CORRECT_CONV_SURVIVOR_TRACEBACK &&
+        survivor_memory != CORRECT_CONV_SURVIVOR_REGISTER_EXCHANGE) {
+        return -1;
+    }
+
+    return convolutional_decode_set_survivor_memory(conv, survivor_memory) ? 0 : -1;
+}
+
+ssize_t correct_convolutional_set_soft_metric(correct_convolutional *conv, int soft_metric) {
+    if (!conv) {
+        return -1;
+    }
+
+    if (soft_metric != CORRECT_SOFT_LINEAR && soft_metric != CORRECT_SOFT_QUADRATIC) {
+        return -1;
+    }
+
+    conv->soft_measurement = soft_metric;
+    metric_soft_cost_fill(conv->soft_measurement, conv->soft_cost);
+
+    return 0;
+}
+
+ssize_t correct_convolutional_set_syndrome_check(correct_convolutional *conv, int syndrome_check) {
+    if (!conv) {
+        return -1;
+    }
+
+    if (!syndrome_check) {
+        syndrome_check_destroy(conv->syndrome_check);
+        conv->syndrome_check = NULL;
+        return 0;
+    }
+
+    if (!conv->syndrome_check) {
+        conv->syndrome_check = syndrome_check_create((unsigned int)conv->rate, (unsigned int)conv->order, conv->table);
+    }
+
+    return conv->syndrome_check ? 0 : -1;
+}
+
+ssize_t correct_convolutional_set_m_algorithm(correct_convolutional *conv, size_t max_paths) {
+    if (!conv) {
+        return -1;
+    }
+
+    if (max_paths > UINT_MAX / 2) {
+        return -1;
+    }
+
+    // the paths are made on the next decode, with the traceback that's set by then
+    m_algorithm_destroy(conv->m_algorithm);
+    conv->m_algorithm = NULL;
+    conv->m_algorithm_paths = max_paths;
+
+    return 0;
+}
+
+ssize_t correct_convolutional_get_stats(const correct_convolutional *conv, correct_convolutional_stats_t *stats) {
+#ifdef CORRECT_CONV_STATS
+    if (!conv || !stats) {
+        return -1;
+    }
+
+    *stats = conv->stats.counts;
+    return 0;
+#else
+    (void)conv;
+    (void)stats;
+    return -1;
+#endif
+}
+
+ssize_t correct_convolutional_reset_stats(correct_convolutional *conv) {
+#ifdef CORRECT_CONV_STATS
+    if (!conv) {
+        return -1;
+    }
+
+    memset(&conv->stats, 0, sizeof(conv->stats));
+    return 0;
+#else
+    (void)conv;
+    return -1;
+#endif
+}
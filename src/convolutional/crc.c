@@ -0,0 +1,155 @@
+#include "correct/convolutional/crc.h"
+
+static uint32_t crc_reflect(uint32_t value, unsigned int width) {
+    uint32_t reflected = 0;
+    for (unsigned int i = 0; i < width; i++) {
+        reflected = (reflected << 1) | ((value >> i) & 1);
+    }
+    return reflected;
+}
+
+correct_crc *correct_crc_create(unsigned int width, uint32_t polynomial, uint32_t init, uint32_t xorout, int reflected) {
+    if (width < 8 || width > 32 || width % 8) {
+        return NULL;
+    }
+
+    correct_crc *crc = (correct_crc *)malloc(sizeof(correct_crc));
+    if (!crc) {
+        return NULL;
+    }
+
+    uint32_t mask = (width == 32) ? UINT32_MAX : ((1u << width) - 1);
+    polynomial &= mask;
+    init &= mask;
+
+    crc->width = width;
+    crc->reflected = reflected != 0;
+    crc->xorout = xorout & mask;
+
+    if (crc->reflected) {
+        uint32_t poly = crc_reflect(polynomial, width);
+        crc->init = crc_reflect(init, width);
+        for (unsigned int b = 0; b < 256; b++) {
+            uint32_t reg = b;
+            for (unsigned int j = 0; j < 8; j++) {
+                reg = (reg & 1) ? ((reg >> 1) ^ poly) : (reg >> 1);
+            }
+            crc->table[0][b] = reg;
+        }
+        for (unsigned int k = 1; k < 8; k++) {
+            for (unsigned int b = 0; b < 256; b++) {
+                uint32_t reg = crc->table[k - 1][b];
+                crc->table[k][b] = (reg >> 8) ^ crc->table[0][reg & 0xff];
+            }
+        }
+    } else {
+        uint32_t poly = polynomial << (32 - width);
+        crc->init = init << (32 - width);
+        for (unsigned int b = 0; b < 256; b++) {
+            uint32_t reg = (uint32_t)b << 24;
+            for (unsigned int j = 0; j < 8; j++) {
+                reg = (reg & 0x80000000u) ? ((reg << 1) ^ poly) : (reg << 1);
+            }
+            crc->table[0][b] = reg;
+        }
+        for (unsigned int k = 1; k < 8; k++) {
+            for (unsigned int b = 0; b < 256; b++) {
+                uint32_t reg = crc->table[k - 1][b];
+                crc->table[k][b] = (reg << 8) ^ crc->table[0][reg >> 24];
+            }
+        }
+    }
+
+    return crc;
+}
+
+correct_crc *correct_crc_create_standard(int standard) {
+    switch (standard) {
+        case CORRECT_CRC16_CCITT:
+            return correct_crc_create(16, 0x1021, 0xffff, 0, 0);
+        case CORRECT_CRC32:
+            return correct_crc_create(32, 0x04c11db7, 0xffffffff, 0xffffffff, 1);
+        case CORRECT_CRC32C:
+            return correct_crc_create(32, 0x1edc6f41, 0xffffffff, 0xffffffff, 1);
+        default:
+            return NULL;
+    }
+}
+
+void correct_crc_destroy(correct_crc *crc) {
+    free(crc);
+}
+
+uint32_t crc_begin(const correct_crc *crc) {
+    return crc->init;
+}
+
+uint32_t crc_update(const correct_crc *crc, uint32_t reg, const uint8_t *data, size_t len) {
+    const uint32_t (*table)[256] = crc->table;
+
+    if (crc->reflected) {
+        for (; len >= 8; len -= 8, data += 8) {
+            uint32_t one = reg ^ ((uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+                                  ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24));
+            uint32_t two = (uint32_t)data[4] | ((uint32_t)data[5] << 8) |
+                           ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24);
+            reg = table[7][one & 0xff] ^ table[6][(one >> 8) & 0xff] ^
+                  table[5][(one >> 16) & 0xff] ^ table[4][one >> 24] ^
+                  table[3][two & 0xff] ^ table[2][(two >> 8) & 0xff] ^
+                  table[1][(two >> 16) & 0xff] ^ table[0][two >> 24];
+        }
+        for (; len; len--, data++) {
+            reg = (reg >> 8) ^ table[0][(reg ^ *data) & 0xff];
+        }
+    } else {
+        for (; len >= 8; len -= 8, data += 8) {
+            uint32_t one = reg ^ (((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) |
+                                  ((uint32_t)data[2] << 8) | (uint32_t)data[3]);
+            uint32_t two = ((uint32_t)data[4] << 24) | ((uint32_t)data[5] << 16) |
+                           ((uint32_t)data[6] << 8) | (uint32_t)data[7];
+            reg = table[7][one >> 24] ^ table[6][(one >> 16) & 0xff] ^
+                  table[5][(one >> 8) & 0xff] ^ table[4][one & 0xff] ^
+                  table[3][two >> 24] ^ table[2][(two >> 16) & 0xff] ^
+                  table[1][(two >> 8) & 0xff] ^ table[0][two & 0xff];
+        }
+        for (; len; len--, data++) {
+            reg = (reg << 8) ^ table[0][(reg >> 24) ^ *data];
+        }
+    }
+
+    return reg;
+}
+
+uint32_t crc_finish(const correct_crc *crc, uint32_t reg) {
+    if (!crc->reflected) {
+        reg >>= 32 - crc->width;
+    }
+    return reg ^ crc->xorout;
+}
+
+void crc_write(const correct_crc *crc, uint32_t value, uint8_t *dst) {
+    unsigned int len = crc->width / 8;
+    for (unsigned int i = 0; i < len; i++) {
+        unsigned int shift = crc->reflected ? 8 * i : 8 * (len - 1 - i);
+        dst[i] = (uint8_t)(value >> shift);
+    }
+}
+
+uint32_t crc_read(const correct_crc *crc, const uint8_t *src) {
+    unsigned int len = crc->width / 8;
+    uint32_t value = 0;
+    for (unsigned int i = 0; i < len; i++) {
+        unsigned int shift = crc->reflected ? 8 * i : 8 * (len - 1 - i);
+        value |= (uint32_t)src[i] << shift;
+    }
+    return value;
+}
+
+uint32_t correct_crc_compute(const correct_crc *crc, const uint8_t *data, size_t len) {
+    return crc_finish(crc, crc_update(crc, crc_begin(crc), data, len));
+}
+
+size_t correct_crc_append(const correct_crc *crc, uint8_t *data, size_t len) {
+    crc_write(crc, correct_crc_compute(crc, data, len), data + len);
+    return len + crc->width / 8;
+}
@@ -6,29 +6,15 @@ void convolutional_decode_warmup(correct_convolutional *conv, unsigned int sets,
     for (unsigned int i = 0; i < conv->order - 1 && i < sets; i++) {
         // peel off rate bits from encoded to recover the same `out` as in the encoding process
         // the difference being that this `out` will have the channel noise/errors applied
-        unsigned int out = 0;
-
-        if (!soft) {
-            out = bit_reader_read(conv->bit_reader, conv->rate);
-        }
+        convolutional_decode_distances(conv, soft, i);
+        const distance_t *distances = conv->distances;
 
         const distance_t *read_errors = conv->errors->read_errors;
         distance_t *write_errors = conv->errors->write_errors;
         // walk all of the state we have so far
         for (size_t j = 0; j < (size_t)((size_t)1u << (i + 1)); j += 1) {
             size_t last = j >> 1;
-            distance_t dist;
-
-            if (soft) {
-                if (conv->soft_measurement == CORRECT_SOFT_LINEAR) {
-                    dist = metric_soft_distance_linear(conv->table[j], soft + i * conv->rate, conv->rate);
-                } else {
-                    dist = metric_soft_distance_quadratic(conv->table[j], soft + i * conv->rate, conv->rate);
-                }
-            } else {
-                dist = metric_distance((unsigned int)conv->table[j], out);
-            }
-
+            distance_t dist = distances[conv->table[j]];
             write_errors[j] = dist + read_errors[last];
         }
 
@@ -36,119 +22,197 @@ void convolutional_decode_warmup(correct_convolutional *conv, unsigned int sets,
     }
 }
 
-void convolutional_decode_inner(correct_convolutional *conv, unsigned int sets, const uint8_t *soft) {
-    shift_register_t highbit = 1 << (conv->order - 1);
-    for (size_t i = conv->order - 1; i < (sets - conv->order + 1); i++) {
-        distance_t *distances = conv->distances;
-        // lasterrors are the aggregate bit errors for the states of shiftregister for the previous
-        // time slice
+// the len soft symbols that start at offset in the soft stream, converted first if the
+//   caller handed over some other format
+static inline const soft_t *convolutional_decode_soft_slice(correct_convolutional *conv, const soft_t *soft, size_t offset, size_t len) {
+    if (conv->soft_input && conv->soft_input->convert) {
+        return soft_input_slice(conv->soft_input, offset, len);
+    }
+    return soft + offset;
+}
+
+static inline void convolutional_decode_distances_fill(correct_convolutional *conv, const soft_t *soft, size_t set) {
+    distance_t *distances = conv->distances;
+    unsigned int num_outputs = 1u << conv->rate;
+
+    if (conv->puncture) {
+        // only the sent bits were received, so measure each packed arrangement of those and
+        //   give every output the distance of its sent bits. dropped bits cost nothing
+        const correct_convolutional_puncture *puncture = conv->puncture;
+        size_t step = set % puncture->period;
+        unsigned int num_sent = puncture->counts[step];
+        distance_t *sent_distances = conv->sent_distances;
+
         if (soft) {
-            if (conv->soft_measurement == CORRECT_SOFT_LINEAR) {
-                for (unsigned int j = 0; j < (unsigned int)(1u << (conv->rate)); j++) {
-                    distances[j] = metric_soft_distance_linear(j, soft + i * conv->rate, conv->rate);
-                }
-            } else {
-                for (unsigned int j = 0; j < (unsigned int)(1u << (conv->rate)); j++) {
-                    distances[j] =
-                        metric_soft_distance_quadratic(j, soft + i * conv->rate, conv->rate);
-                }
-            }
+            const soft_t *slice = convolutional_decode_soft_slice(conv, soft, puncture_offset(puncture, set), num_sent);
+            metric_soft_distances(conv->soft_cost, slice, num_sent, sent_distances);
         } else {
-            unsigned int out = bit_reader_read(conv->bit_reader, conv->rate);
-            for (unsigned int k = 0; k < (unsigned int)(1u << (conv->rate)); k++) {
-                distances[k] = metric_distance(k, out);
+            unsigned int out = bit_reader_read(conv->bit_reader, num_sent);
+            for (unsigned int k = 0; k < (1u << num_sent); k++) {
+                sent_distances[k] = metric_distance(k, out);
             }
         }
-        pair_lookup_t *pair_lookup = conv->pair_lookup;
-        pair_lookup_fill_distance(pair_lookup, distances);
 
-        // a mask to get the high order bit from the shift register
-        unsigned int num_iter = highbit << 1;
-        const distance_t *read_errors = conv->errors->read_errors;
-        // aggregate bit errors for this time slice
-        distance_t *write_errors = conv->errors->write_errors;
+        const unsigned int *compact = puncture->compact + step * num_outputs;
+        for (unsigned int j = 0; j < num_outputs; j++) {
+            distances[j] = sent_distances[compact[j]];
+        }
+        return;
+    }
 
-        uint8_t *history = history_buffer_get_slice(conv->history_buffer);
-        // walk through all states, ignoring oldest bit
-        // we will track a best register state (path) and the number of bit errors at that path at
-        // this time slice
-        // this loop considers two paths per iteration (high order bit set, clear)
-        // so, it only runs numstates/2 iterations
-        // we'll update the history for every state and find the path with the least aggregated bit
-        // errors
-
-        // now run the main loop
-        // we calculate 2 sets of 2 register states here (4 states per iter)
-        // this creates 2 sets which share a predecessor, and 2 sets which share a successor
-        //
-        // the first set definition is the two states that are the same except for the least order
-        // bit
-        // these two share a predecessor because their high n - 1 bits are the same (differ only by
-        // newest bit)
-        //
-        // the second set definition is the two states that are the same except for the high order
-        // bit
-        // these two share a successor because the oldest high order bit will be shifted out, and
-        // the other bits will be present in the successor
-        //
-        shift_register_t highbase = highbit >> 1;
-        for (shift_register_t low = 0, high = highbit, base = 0; high < num_iter;
-             low += 8, high += 8, base += 4) {
-            // shifted-right ancestors
-            // low and low_plus_one share low_past_error
-            //   note that they are the same when shifted right by 1
-            // same goes for high and high_plus_one
-            for (shift_register_t offset = 0, base_offset = 0; base_offset < 4;
-                 offset += 2, base_offset += 1) {
-                distance_pair_key_t low_key = pair_lookup->keys[base + base_offset];
-                distance_pair_key_t high_key = pair_lookup->keys[highbase + base + base_offset];
-                distance_pair_t low_concat_dist = pair_lookup->distances[low_key];
-                distance_pair_t high_concat_dist = pair_lookup->distances[high_key];
-
-                distance_t low_past_error = read_errors[base + base_offset];
-                distance_t high_past_error = read_errors[highbase + base + base_offset];
-
-                distance_t low_error = (low_concat_dist & 0xffff) + low_past_error;
-                distance_t high_error = (high_concat_dist & 0xffff) + high_past_error;
-
-                shift_register_t successor = low + offset;
-                distance_t error;
-                uint8_t history_mask;
-                if (low_error <= high_error) {
-                    error = low_error;
-                    history_mask = 0;
-                } else {
-                    error = high_error;
-                    history_mask = 1;
-                }
-                write_errors[successor] = error;
-                history[successor] = history_mask;
-
-                shift_register_t low_plus_one = low + offset + 1;
-
-                distance_t low_plus_one_error = (low_concat_dist >> 16) + low_past_error;
-                distance_t high_plus_one_error = (high_concat_dist >> 16) + high_past_error;
-
-                shift_register_t plus_one_successor = low_plus_one;
-                distance_t plus_one_error;
-                uint8_t plus_one_history_mask;
-                if (low_plus_one_error <= high_plus_one_error) {
-                    plus_one_error = low_plus_one_error;
-                    plus_one_history_mask = 0;
-                } else {
-                    plus_one_error = high_plus_one_error;
-                    plus_one_history_mask = 1;
-                }
-                write_errors[plus_one_successor] = plus_one_error;
-                history[plus_one_successor] = plus_one_history_mask;
+    if (soft) {
+        const soft_t *slice = convolutional_decode_soft_slice(conv, soft, set * conv->rate, conv->rate);
+        metric_soft_distances(conv->soft_cost, slice, conv->rate, distances);
+    } else {
+        unsigned int out = bit_reader_read(conv->bit_reader, conv->rate);
+        for (unsigned int k = 0; k < num_outputs; k++) {
+            distances[k] = metric_distance(k, out);
+        }
+    }
+}
+
+// fill conv->distances with the distance from every possible output to time slice set
+// soft is the whole soft stream, or NULL to read hard bits from conv->bit_reader
+void convolutional_decode_distances(correct_convolutional *conv, const soft_t *soft, size_t set) {
+    uint64_t start = profile_now();
+    convolutional_decode_distances_fill(conv, soft, set);
+    profile_add(PROFILE_CONV_DISTANCES, start);
+}
+
+// find how many time slices make up num_encoded_bits of the encoded stream
+bool convolutional_decode_sets(const correct_convolutional *conv, size_t num_encoded_bits, size_t *sets) {
+    if (conv->puncture) {
+        return puncture_sets(conv->puncture, num_encoded_bits, sets);
+    }
+
+    if (num_encoded_bits % conv->rate) {
+        return false;
+    }
+
+    *sets = num_encoded_bits / conv->rate;
+    return true;
+}
+
+// add-compare-select over every state for one time slice
+// the error metrics go to conv->errors->write_errors and one choice per state to history
+static inline void convolutional_decode_acs(correct_convolutional *conv, uint8_t *history) {
+    shift_register_t highbit = 1 << (conv->order - 1);
+    distance_t *distances = conv->distances;
+    pair_lookup_t *pair_lookup = conv->pair_lookup;
+    uint64_t start = profile_now();
+    pair_lookup_fill_distance(pair_lookup, distances);
+    profile_add(PROFILE_CONV_FILL, start);
+    start = profile_now();
+
+    // a mask to get the high order bit from the shift register
+    unsigned int num_iter = highbit << 1;
+    const distance_t *read_errors = conv->errors->read_errors;
+    // aggregate bit errors for this time slice
+    distance_t *write_errors = conv->errors->write_errors;
+
+    // walk through all states, ignoring oldest bit
+    // we will track a best register state (path) and the number of bit errors at that path at
+    // this time slice
+    // this loop considers two paths per iteration (high order bit set, clear)
+    // so, it only runs numstates/2 iterations
+    // we'll update the history for every state and find the path with the least aggregated bit
+    // errors
+
+    // now run the main loop
+    // we calculate 2 sets of 2 register states here (4 states per iter)
+    // this creates 2 sets which share a predecessor, and 2 sets which share a successor
+    //
+    // the first set definition is the two states that are the same except for the least order
+    // bit
+    // these two share a predecessor because their high n - 1 bits are the same (differ only by
+    // newest bit)
+    //
+    // the second set definition is the two states that are the same except for the high order
+    // bit
+    // these two share a successor because the oldest high order bit will be shifted out, and
+    // the other bits will be present in the successor
+    //
+    shift_register_t highbase = highbit >> 1;
+    for (shift_register_t low = 0, high = highbit, base = 0; high < num_iter;
+         low += 8, high += 8, base += 4) {
+        // shifted-right ancestors
+        // low and low_plus_one share low_past_error
+        //   note that they are the same when shifted right by 1
+        // same goes for high and high_plus_one
+        for (shift_register_t offset = 0, base_offset = 0; base_offset < 4;
+             offset += 2, base_offset += 1) {
+            distance_pair_key_t low_key = pair_lookup->keys[base + base_offset];
+            distance_pair_key_t high_key = pair_lookup->keys[highbase + base + base_offset];
+            distance_pair_t low_concat_dist = pair_lookup->distances[low_key];
+            distance_pair_t high_concat_dist = pair_lookup->distances[high_key];
+
+            distance_t low_past_error = read_errors[base + base_offset];
+            distance_t high_past_error = read_errors[highbase + base + base_offset];
+
+            distance_t low_error = (low_concat_dist & 0xffff) + low_past_error;
+            distance_t high_error = (high_concat_dist & 0xffff) + high_past_error;
+
+            shift_register_t successor = low + offset;
+            distance_t error;
+            uint8_t history_mask;
+            if (low_error <= high_error) {
+                error = low_error;
+                history_mask = 0;
+            } else {
+                error = high_error;
+                history_mask = 1;
             }
+            write_errors[successor] = error;
+            history[successor] = history_mask;
+
+            shift_register_t low_plus_one = low + offset + 1;
+
+            distance_t low_plus_one_error = (low_concat_dist >> 16) + low_past_error;
+            distance_t high_plus_one_error = (high_concat_dist >> 16) + high_past_error;
+
+            shift_register_t plus_one_successor = low_plus_one;
+            distance_t plus_one_error;
+            uint8_t plus_one_history_mask;
+            if (low_plus_one_error <= high_plus_one_error) {
+                plus_one_error = low_plus_one_error;
+                plus_one_history_mask = 0;
+            } else {
+                plus_one_error = high_plus_one_error;
+                plus_one_history_mask = 1;
+            }
+            write_errors[plus_one_successor] = plus_one_error;
+            history[plus_one_successor] = plus_one_history_mask;
         }
+    }
+    profile_add(PROFILE_CONV_ACS, start);
+}
 
+void convolutional_decode_inner(correct_convolutional *conv, unsigned int sets, const uint8_t *soft) {
+    for (size_t i = conv->order - 1; i < (sets - conv->order + 1); i++) {
+        // lasterrors are the aggregate bit errors for the states of shiftregister for the previous
+        // time slice
+        convolutional_decode_distances(conv, soft, i);
+        uint8_t *history = history_buffer_get_slice(conv->history_buffer);
+        convolutional_decode_acs(conv, history);
+
+        distance_t *write_errors = conv->errors->write_errors;
         history_buffer_process(conv->history_buffer, write_errors, conv->bit_writer);
         error_buffer_swap(conv->errors);
     }
 }
 
+static void convolutional_decode_inner_register_exchange(correct_convolutional *conv, unsigned int sets, const uint8_t *soft) {
+    register_exchange *reg = conv->register_exchange;
+    for (size_t i = conv->order - 1; i < (sets - conv->order + 1); i++) {
+        convolutional_decode_distances(conv, soft, i);
+        convolutional_decode_acs(conv, register_exchange_get_slice(reg));
+
+        distance_t *write_errors = conv->errors->write_errors;
+        register_exchange_process(reg, write_errors, conv->bit_writer);
+        error_buffer_swap(conv->errors);
+    }
+}
+
 void convolutional_decode_tail(correct_convolutional *conv, unsigned int sets, const uint8_t *soft) {
     // flush state registers
     // now we only shift in 0s, skipping 1-successors
@@ -160,26 +224,11 @@ void convolutional_decode_tail(correct_convolutional *conv, unsigned int sets, c
         // aggregate bit errors for this time slice
         distance_t *write_errors = conv->errors->write_errors;
 
-        uint8_t *history = history_buffer_get_slice(conv->history_buffer);
+        uint8_t *history = conv->register_exchange ? register_exchange_get_slice(conv->register_exchange) : history_buffer_get_slice(conv->history_buffer);
 
         // calculate the distance from all output states to our sliced bits
-        distance_t *distances = conv->distances;
-        if (soft) {
-            if (conv->soft_measurement == CORRECT_SOFT_LINEAR) {
-                for (unsigned int j = 0; j < (unsigned int)(1u << (conv->rate)); j++) {
-                    distances[j] = metric_soft_distance_linear(j, soft + i * conv->rate, conv->rate);
-                }
-            } else {
-                for (unsigned int j = 0; j < (unsigned int)(1u << (conv->rate)); j++) {
-                    distances[j] = metric_soft_distance_quadratic(j, soft + i * conv->rate, conv->rate);
-                }
-            }
-        } else {
-            unsigned int out = bit_reader_read(conv->bit_reader, conv->rate);
-            for (unsigned int k = 0; k < (unsigned int)(1u << (conv->rate)); k++) {
-                distances[k] = metric_distance(k, out);
-            }
-        }
+        convolutional_decode_distances(conv, soft, i);
+        const distance_t *distances = conv->distances;
         const unsigned int *table = conv->table;
 
         // a mask to get the high order bit from the shift register
@@ -215,11 +264,80 @@ void convolutional_decode_tail(correct_convolutional *conv, unsigned int sets, c
             history[successor] = history_mask;
         }
 
-        history_buffer_process_skip(conv->history_buffer, write_errors, conv->bit_writer, skip);
+        if (conv->register_exchange) {
+            register_exchange_process_skip(conv->register_exchange, write_errors, conv->bit_writer, skip);
+        } else {
+            history_buffer_process_skip(conv->history_buffer, write_errors, conv->bit_writer, skip);
+        }
         error_buffer_swap(conv->errors);
     }
 }
 
+// survivor memory for the block decoders
+// every decoder keeps a history buffer, which the whole-frame machinery also leans on
+// for small orders the block decoders can instead keep their survivors by register
+//   exchange, which skips the traceback but moves a whole register per state per slice
+static bool convolutional_decode_use_register_exchange(const correct_convolutional *conv) {
+    const history_buffer *history = conv->history_buffer;
+    if (history->min_traceback_length >= register_exchange_max_cap) {
+        return false;
+    }
+
+    switch (conv->survivor_memory) {
+        case CORRECT_CONV_SURVIVOR_TRACEBACK:
+            return false;
+        case CORRECT_CONV_SURVIVOR_REGISTER_EXCHANGE:
+            return true;
+        default:
+            return conv->order <= conv->register_exchange_max_order;
+    }
+}
+
+// (re)build the register exchange to match the history buffer, or drop it
+// the register holds at most register_exchange_max_cap bits, so the group length is
+//   cut down to fit if need be
+// if the new one can't be made, the decoders fall back to the history buffer
+static bool convolutional_decode_choose_survivors(correct_convolutional *conv) {
+    if (conv->register_exchange) {
+        register_exchange_destroy(conv->register_exchange);
+        conv->register_exchange = NULL;
+    }
+
+    if (!convolutional_decode_use_register_exchange(conv)) {
+        return true;
+    }
+
+    const history_buffer *history = conv->history_buffer;
+    unsigned int group_length = register_exchange_max_cap - history->min_traceback_length;
+    if (history->traceback_group_length < group_length) {
+        group_length = history->traceback_group_length;
+    }
+    conv->register_exchange = register_exchange_create(history->min_traceback_length, group_length, history->renormalize_interval, conv->numstates / 2);
+    if (conv->register_exchange) {
+        conv->register_exchange->stats = &conv->stats;
+    }
+
+    return conv->register_exchange != NULL;
+}
+
+void convolutional_decode_survivors_reset(correct_convolutional *conv) {
+    if (conv->register_exchange) {
+        register_exchange_reset(conv->register_exchange);
+    } else {
+        history_buffer_reset(conv->history_buffer);
+    }
+}
+
+// the tail leaves the best path in state 0
+void convolutional_decode_survivors_flush(correct_convolutional *conv) {
+    decoder_stats_end_block(&conv->stats, conv->errors->read_errors[0]);
+    if (conv->register_exchange) {
+        register_exchange_flush(conv->register_exchange, conv->bit_writer);
+    } else {
+        history_buffer_flush(conv->history_buffer, conv->bit_writer);
+    }
+}
+
 bool _convolutional_decode_init(correct_convolutional *conv, unsigned int min_traceback, unsigned int traceback_length, unsigned int renormalize_interval) {
     conv->has_init_decode = true;
 
@@ -233,72 +351,690 @@ bool _convolutional_decode_init(correct_convolutional *conv, unsigned int min_tr
         return false;
     }
 
-    conv->soft_measurement = CORRECT_SOFT_LINEAR;
-
     // we limit history to go back as far as 5 * the order of our polynomial
     conv->history_buffer = history_buffer_create(min_traceback, traceback_length, renormalize_interval, conv->numstates / 2, 1 << (conv->order - 1));
     if (!conv->history_buffer) {
         return false;
     }
+    conv->history_buffer->stats = &conv->stats;
 
     conv->errors = error_buffer_create(conv->numstates);
     if (!conv->errors) {
         return false;
     }
 
-    return true;
+    return convolutional_decode_choose_survivors(conv);
 }
 
-static ssize_t _convolutional_decode(correct_convolutional *conv, size_t num_encoded_bits, size_t num_encoded_bytes, uint8_t *msg, const soft_t *soft_encoded) {
-    if (!conv->has_init_decode) {
-        unsigned int max_error_per_input = (unsigned int)(conv->rate * soft_max);
-        unsigned int renormalize_interval = distance_max / max_error_per_input;
-        if (!_convolutional_decode_init(conv, (unsigned int)(5 * conv->order), (unsigned int)(15 * conv->order), renormalize_interval)) {
-            return -1;
+static bool _convolutional_decode_lazy_init(correct_convolutional *conv) {
+    if (conv->has_init_decode) {
+        return true;
+    }
+
+    unsigned int max_error_per_input = (unsigned int)(conv->rate * soft_max);
+    unsigned int renormalize_interval = distance_max / max_error_per_input;
+    unsigned int traceback_depth = conv->traceback_depth ? conv->traceback_depth : (unsigned int)(5 * conv->order);
+    unsigned int traceback_group_length = conv->traceback_group_length ? conv->traceback_group_length : (unsigned int)(15 * conv->order);
+    return _convolutional_decode_init(conv, traceback_depth, traceback_group_length, renormalize_interval);
+}
+
+// set the traceback for the next decoder init, or swap in a new history buffer if that's
+//   already happened. the old one stays in place if the new one can't be made
+bool convolutional_decode_set_traceback(correct_convolutional *conv, size_t traceback_depth, size_t traceback_group_length) {
+    if (traceback_depth > UINT_MAX / 2 || traceback_group_length > UINT_MAX / 2) {
+        return false;
+    }
+
+    if (conv->has_init_decode) {
+        history_buffer *history = history_buffer_create((unsigned int)traceback_depth, (unsigned int)traceback_group_length, conv->history_buffer->renormalize_interval, conv->numstates / 2, 1 << (conv->order - 1));
+        if (!history) {
+            return false;
         }
+
+        history_buffer_destroy(conv->history_buffer);
+        conv->history_buffer = history;
+        conv->history_buffer->stats = &conv->stats;
+    }
+
+    // remade with the new traceback on the next decode
+    m_algorithm_destroy(conv->m_algorithm);
+    conv->m_algorithm = NULL;
+
+    conv->traceback_depth = (unsigned int)traceback_depth;
+    conv->traceback_group_length = (unsigned int)traceback_group_length;
+
+    return conv->has_init_decode ? convolutional_decode_choose_survivors(conv) : true;
+}
+
+bool convolutional_decode_set_survivor_memory(correct_convolutional *conv, int survivor_memory) {
+    conv->survivor_memory = survivor_memory;
+
+    return conv->has_init_decode ? convolutional_decode_choose_survivors(conv) : true;
+}
+
+static ssize_t convolutional_decode_block(correct_convolutional *conv, size_t sets, size_t num_encoded_bytes, uint8_t *msg, const soft_t *soft_encoded) {
+    if (!_convolutional_decode_lazy_init(conv)) {
+        return -1;
     }
 
-    size_t sets = num_encoded_bits / conv->rate;
     // XXX fix this vvvvvv
     size_t decoded_len_bytes = num_encoded_bytes;
     bit_writer_reconfigure(conv->bit_writer, msg, decoded_len_bytes);
+    decoder_stats_begin_block(&conv->stats, sets);
+
+    if (conv->m_algorithm_paths && !conv->tail_biting) {
+        if (!convolutional_decode_m_algorithm(conv, sets, soft_encoded)) {
+            return -1;
+        }
+        return bit_writer_length(conv->bit_writer);
+    }
 
     error_buffer_reset(conv->errors);
-    history_buffer_reset(conv->history_buffer);
+    convolutional_decode_survivors_reset(conv);
 
     // no outputs are generated during warmup
     convolutional_decode_warmup(conv, (unsigned int)sets, soft_encoded);
-    convolutional_decode_inner(conv, (unsigned int)sets, soft_encoded);
+    if (conv->register_exchange) {
+        convolutional_decode_inner_register_exchange(conv, (unsigned int)sets, soft_encoded);
+    } else {
+        convolutional_decode_inner(conv, (unsigned int)sets, soft_encoded);
+    }
     convolutional_decode_tail(conv, (unsigned int)sets, soft_encoded);
 
-    history_buffer_flush(conv->history_buffer, conv->bit_writer);
+    convolutional_decode_survivors_flush(conv);
 
     return bit_writer_length(conv->bit_writer);
 }
 
+
+// whole-frame decoding
+// the streaming decoder above traces back as it goes and flushes at the end of every call
+// libfec's callers instead hand over a frame a few symbols at a time, so here the path
+//   metrics carry over from one update to the next, every time slice keeps its decisions
+//   (one bit per state), and the traceback runs once when the caller asks for the bits
+
+bool convolutional_decode_frame_init(correct_convolutional *conv, size_t max_sets) {
+    if (!_convolutional_decode_lazy_init(conv)) {
+        return false;
+    }
+
+    size_t slice_len = conv->numstates / 2;
+    conv->frame_slice_bytes = (slice_len % 8) ? (slice_len / 8 + 1) : (slice_len / 8);
+
+    if (conv->frame_history) {
+        free(conv->frame_history);
+    }
+    conv->frame_history = (uint8_t *)malloc(max_sets * conv->frame_slice_bytes);
+    if (!conv->frame_history) {
+        return false;
+    }
+
+    if (!conv->frame_slice) {
+        conv->frame_slice = (uint8_t *)ALIGNED_MALLOC(slice_len, 16);
+        if (!conv->frame_slice) {
+            return false;
+        }
+    }
+
+    conv->frame_cap = max_sets;
+    conv->frame_len = 0;
+
+    return true;
+}
+
+void convolutional_decode_frame_reset(correct_convolutional *conv, shift_register_t start_state) {
+    error_buffer_reset(conv->errors);
+
+    // every path starts out penalized except the one from the known start state. this stands
+    //   in for the warmup, which only walks forward from state 0
+    // the penalty counts against the renormalization budget, so start the counter that far in
+    distance_t *errors = conv->errors->errors[0];
+    unsigned int num_states = conv->numstates / 2;
+    distance_t penalty = (distance_t)((conv->order - 1) * conv->rate * soft_max);
+    for (shift_register_t state = 0; state < num_states; state++) {
+        errors[state] = penalty;
+    }
+    errors[start_state & (num_states - 1)] = 0;
+
+    // we've read from errors[0] and will write errors[1], so the next swap flips them
+    conv->errors->index = 1;
+
+    conv->frame_len = 0;
+    conv->frame_renormalize_counter = (unsigned int)(conv->order - 1);
+}
+
+// renormalize if it's time and move on to the next time slice
+void convolutional_decode_frame_advance(correct_convolutional *conv) {
+    conv->frame_renormalize_counter++;
+    if (conv->frame_renormalize_counter >= conv->history_buffer->renormalize_interval) {
+        conv->frame_renormalize_counter = 0;
+        uint64_t start = profile_now();
+        distance_t *errors = conv->errors->write_errors;
+        unsigned int num_states = conv->numstates / 2;
+        distance_t least = errors[0];
+        for (shift_register_t state = 1; state < num_states; state++) {
+            least = (errors[state] < least) ? errors[state] : least;
+        }
+        for (shift_register_t state = 0; state < num_states; state++) {
+            errors[state] -= least;
+        }
+        decoder_stats_renormalize(&conv->stats, least);
+        profile_add(PROFILE_CONV_RENORMALIZE, start);
+    }
+
+    error_buffer_swap(conv->errors);
+    conv->frame_len++;
+    decoder_stats_step(&conv->stats);
+}
+
+// soft (or the bit reader) starts at time slice 0 of the frame on every call. that's
+//   libfec's convention, and since libfec has no puncturing it doesn't matter there.
+//   punctured callers must start each call at the start of the frame
+size_t convolutional_decode_frame_update(correct_convolutional *conv, const soft_t *soft, size_t sets) {
+    if (sets > conv->frame_cap - conv->frame_len) {
+        sets = conv->frame_cap - conv->frame_len;
+    }
+
+    for (size_t i = 0; i < sets; i++) {
+        uint8_t *decisions = conv->frame_history + conv->frame_len * conv->frame_slice_bytes;
+        convolutional_decode_frame_step(conv, soft, i, decisions);
+    }
+
+    return sets;
+}
+
+// decide time slice set, packing the decisions into one bit per state, and move on
+void convolutional_decode_frame_step(correct_convolutional *conv, const soft_t *soft, size_t set, uint8_t *decisions) {
+    convolutional_decode_distances(conv, soft, set);
+    convolutional_decode_acs(conv, conv->frame_slice);
+
+    unsigned int num_states = conv->numstates / 2;
+    memset(decisions, 0, conv->frame_slice_bytes);
+    for (shift_register_t state = 0; state < num_states; state++) {
+        decisions[state / 8] |= (uint8_t)(conv->frame_slice[state] << (state % 8));
+    }
+
+    convolutional_decode_frame_advance(conv);
+}
+
+// the state with the least error after the last time slice
+shift_register_t convolutional_decode_frame_best_state(const correct_convolutional *conv) {
+    unsigned int num_states = conv->numstates / 2;
+    const distance_t *errors = conv->errors->read_errors;
+    shift_register_t best = 0;
+    for (shift_register_t state = 1; state < num_states; state++) {
+        if (errors[state] < errors[best]) {
+            best = state;
+        }
+    }
+    return best;
+}
+
+size_t convolutional_decode_frame_traceback(correct_convolutional *conv, shift_register_t end_state, size_t num_decoded_bits, uint8_t *msg) {
+    // each time slice decides the input bit from order - 1 slices before it, so the
+    //   final order - 1 slices hold the last message bits and the tail decides nothing
+    size_t tail = conv->order - 1;
+    if (conv->frame_len < tail) {
+        return 0;
+    }
+
+    if (num_decoded_bits > conv->frame_len - tail) {
+        num_decoded_bits = conv->frame_len - tail;
+    }
+
+    unsigned int num_states = conv->numstates / 2;
+    shift_register_t highbit = 1 << (conv->order - 1);
+    shift_register_t state = end_state & (num_states - 1);
+    uint8_t byte = 0;
+    for (size_t i = num_decoded_bits; i-- > 0;) {
+        const uint8_t *decisions = conv->frame_history + (i + tail) * conv->frame_slice_bytes;
+        unsigned int bit = (decisions[state / 8] >> (state % 8)) & 1;
+        state = (state | (bit ? highbit : 0)) >> 1;
+
+        byte |= (uint8_t)(bit << (7 - (i % 8)));
+        if (i % 8 == 0) {
+            msg[i / 8] = byte;
+            byte = 0;
+        }
+    }
+    decoder_stats_traceback(&conv->stats);
+
+    return num_decoded_bits;
+}
+
+// tail-biting decoding
+// the encoder starts in the state the end of the message leaves it in, so the trellis is
+//   a circle with no known state anywhere on it. starting with every state equally
+//   likely, the decoder walks the circle passes times just to settle the path metrics,
+//   then once more keeping its decisions. it then carries on into the start of the
+//   message again for as far as the traceback needs to converge, and traces back from
+//   the best state at the end of that
+
+bool convolutional_decode_tail_biting_init(correct_convolutional *conv, size_t sets) {
+    // the circle must be whole message bytes
+    if (!sets || sets % 8) {
+        return false;
+    }
+
+    size_t max_sets = sets + convolutional_decode_tail_biting_depth(conv, sets);
+    if (max_sets > conv->frame_cap && !convolutional_decode_frame_init(conv, max_sets)) {
+        return false;
+    }
+
+    error_buffer_reset(conv->errors);
+    // as with convolutional_decode_frame_reset, the next swap must flip the buffers
+    conv->errors->index = 1;
+
+    conv->frame_len = 0;
+    conv->frame_renormalize_counter = 0;
+
+    return true;
+}
+
+// how far past the end of the circle to go before tracing back
+size_t convolutional_decode_tail_biting_depth(const correct_convolutional *conv, size_t sets) {
+    size_t depth = conv->history_buffer->min_traceback_length;
+    return (depth < sets) ? depth : sets;
+}
+
+// go back to the start of the encoded block for another time around the circle
+void convolutional_decode_tail_biting_rewind(correct_convolutional *conv) {
+    bit_reader_t *reader = conv->bit_reader;
+    bit_reader_reconfigure(reader, reader->bytes, reader->len);
+}
+
+ssize_t convolutional_decode_tail_biting_traceback(correct_convolutional *conv, size_t sets, uint8_t *msg) {
+    shift_register_t state = convolutional_decode_frame_best_state(conv);
+
+    // the slices past the end of the circle only lead the traceback to the right path
+    shift_register_t highbit = 1 << (conv->order - 1);
+    for (size_t i = conv->frame_len; i-- > sets;) {
+        const uint8_t *decisions = conv->frame_history + i * conv->frame_slice_bytes;
+        unsigned int bit = (decisions[state / 8] >> (state % 8)) & 1;
+        state = (state | (bit ? highbit : 0)) >> 1;
+    }
+
+    // time slice i decides message bit i - (order - 1), wrapping around to the end of
+    //   the message for the first few slices
+    memset(msg, 0, sets / 8);
+    size_t lag = (conv->order - 1) % sets;
+    for (size_t i = sets; i-- > 0;) {
+        const uint8_t *decisions = conv->frame_history + i * conv->frame_slice_bytes;
+        unsigned int bit = (decisions[state / 8] >> (state % 8)) & 1;
+        state = (state | (bit ? highbit : 0)) >> 1;
+
+        size_t index = (i + sets - lag) % sets;
+        msg[index / 8] |= (uint8_t)(bit << (7 - index % 8));
+    }
+    decoder_stats_traceback(&conv->stats);
+
+    return (ssize_t)(sets / 8);
+}
+
+static ssize_t _convolutional_decode_tail_biting(correct_convolutional *conv, size_t sets, uint8_t *msg, const soft_t *soft_encoded) {
+    if (!_convolutional_decode_lazy_init(conv) || !convolutional_decode_tail_biting_init(conv, sets)) {
+        return -1;
+    }
+    // the slices are counted as the frame machinery walks them
+    decoder_stats_begin_block(&conv->stats, 0);
+
+    for (size_t pass = 0; pass <= conv->tail_biting_passes; pass++) {
+        conv->frame_len = 0;
+        convolutional_decode_tail_biting_rewind(conv);
+        convolutional_decode_frame_update(conv, soft_encoded, sets);
+    }
+
+    convolutional_decode_tail_biting_rewind(conv);
+    convolutional_decode_frame_update(conv, soft_encoded, convolutional_decode_tail_biting_depth(conv, sets));
+
+    return convolutional_decode_tail_biting_traceback(conv, sets, msg);
+}
+
+// every frame that comes in through the public decode functions, between the probes that
+//   mark it, whichever way it is decoded
+// the end probe carries the decoded path's metric, which for hard decisions is the number
+//   of encoded bits corrected. a block the syndrome check finds clean had nothing
+//   corrected, so it's 0 there, and the tail-biting decoder doesn't keep one, so it's -1
+static ssize_t _convolutional_decode(correct_convolutional *conv, size_t sets, size_t num_encoded_bytes, uint8_t *msg, const uint8_t *encoded, const soft_t *soft_encoded) {
+    CORRECT_PROBE2(conv_decode_begin, conv, sets);
+    int64_t path_metric = 0;
+    ssize_t decoded_len = convolutional_decode_syndrome(conv, encoded, soft_encoded, sets, msg);
+    if (decoded_len < 0) {
+        if (conv->tail_biting) {
+            decoded_len = _convolutional_decode_tail_biting(conv, sets, msg, soft_encoded);
+            path_metric = -1;
+        } else {
+            decoded_len = convolutional_decode_block(conv, sets, num_encoded_bytes, msg, soft_encoded);
+            path_metric = (int64_t)decoder_stats_path_metric(&conv->stats);
+        }
+    }
+    CORRECT_PROBE4(conv_decode_end, conv, sets, decoded_len, (decoded_len < 0) ? 0 : path_metric);
+    return decoded_len;
+}
+
+// low-delay streaming
+// the decisions for the last delay time slices are kept in a ring on the whole-frame
+//   storage. after every slice, a traceback of exactly delay slices from the best state
+//   gives the bit from delay slices ago, so every bit comes out after the same latency
+//   rather than in bursts of traceback_group_length
+
+bool convolutional_decode_stream_begin(correct_convolutional *conv, size_t delay) {
+    // the ring needs the slice being decided as well as the delay before it
+    if (conv->puncture || conv->tail_biting || !convolutional_decode_frame_init(conv, delay + 1)) {
+        return false;
+    }
+
+    conv->stream_delay = delay;
+    conv->streaming = true;
+    convolutional_decode_frame_reset(conv, 0);
+
+    return true;
+}
+
+// where the decisions for the next time slice go
+uint8_t *convolutional_decode_stream_slot(correct_convolutional *conv) {
+    return conv->frame_history + (conv->frame_len % conv->frame_cap) * conv->frame_slice_bytes;
+}
+
+// walk back from state at time slice last through count slices of the ring
+static shift_register_t convolutional_decode_stream_walk(correct_convolutional *conv, shift_register_t state, size_t last, size_t count) {
+    shift_register_t highbit = 1 << (conv->order - 1);
+    for (size_t i = 0; i < count; i++) {
+        size_t slice = (last - i) % conv->frame_cap;
+        const uint8_t *decisions = conv->frame_history + slice * conv->frame_slice_bytes;
+        unsigned int bit = (decisions[state / 8] >> (state % 8)) & 1;
+        state = (state | (bit ? highbit : 0)) >> 1;
+    }
+    return state;
+}
+
+// write the bit from delay slices before the last one, if there has been one yet
+size_t convolutional_decode_stream_output(correct_convolutional *conv) {
+    if (conv->frame_len <= conv->stream_delay) {
+        return 0;
+    }
+
+    // the newest bit of each state is the input that led to it
+    shift_register_t state = convolutional_decode_frame_best_state(conv);
+    state = convolutional_decode_stream_walk(conv, state, conv->frame_len - 1, conv->stream_delay);
+    bit_writer_write_1(conv->bit_writer, (uint8_t)(state & 1));
+    decoder_stats_traceback(&conv->stats);
+
+    return 1;
+}
+
+size_t convolutional_decode_stream_end(correct_convolutional *conv, uint8_t *msg) {
+    size_t num_decoded_bits = (conv->frame_len < conv->stream_delay) ? conv->frame_len : conv->stream_delay;
+
+    memset(msg, 0, (num_decoded_bits + 7) / 8);
+    shift_register_t state = convolutional_decode_frame_best_state(conv);
+    for (size_t i = num_decoded_bits; i-- > 0;) {
+        msg[i / 8] |= (uint8_t)((state & 1) << (7 - i % 8));
+        state = convolutional_decode_stream_walk(conv, state, conv->frame_len - (num_decoded_bits - i), 1);
+    }
+    decoder_stats_traceback(&conv->stats);
+
+    convolutional_decode_frame_reset(conv, 0);
+
+    return num_decoded_bits;
+}
+
+static ssize_t _convolutional_stream_decode(correct_convolutional *conv, size_t sets, uint8_t *msg, const soft_t *soft_encoded) {
+    bit_writer_reconfigure(conv->bit_writer, msg, (sets + 7) / 8);
+
+    size_t num_decoded_bits = 0;
+    for (size_t i = 0; i < sets; i++) {
+        convolutional_decode_frame_step(conv, soft_encoded, i, convolutional_decode_stream_slot(conv));
+        num_decoded_bits += convolutional_decode_stream_output(conv);
+    }
+
+    bit_writer_flush_byte(conv->bit_writer);
+
+    return (ssize_t)num_decoded_bits;
+}
+
+ssize_t correct_convolutional_stream_begin(correct_convolutional *conv, size_t delay) {
+    if (!conv || !convolutional_decode_stream_begin(conv, delay)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+ssize_t correct_convolutional_stream_decode(correct_convolutional *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    size_t sets;
+    if (!conv->streaming || !convolutional_decode_sets(conv, num_encoded_bits, &sets)) {
+        return -1;
+    }
+
+    size_t num_encoded_bytes = (num_encoded_bits % 8) ? (num_encoded_bits / 8 + 1) : (num_encoded_bits / 8);
+    bit_reader_reconfigure(conv->bit_reader, encoded, num_encoded_bytes);
+
+    return _convolutional_stream_decode(conv, sets, msg, NULL);
+}
+
+ssize_t correct_convolutional_stream_decode_soft(correct_convolutional *conv, const soft_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    size_t sets;
+    if (!conv->streaming || !convolutional_decode_sets(conv, num_encoded_bits, &sets)) {
+        return -1;
+    }
+
+    return _convolutional_stream_decode(conv, sets, msg, encoded);
+}
+
+ssize_t correct_convolutional_stream_end(correct_convolutional *conv, uint8_t *msg) {
+    if (!conv->streaming) {
+        return -1;
+    }
+
+    return (ssize_t)convolutional_decode_stream_end(conv, msg);
+}
+
 // perform viterbi decoding
 // hard decoder
 ssize_t correct_convolutional_decode(correct_convolutional *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
-    if (num_encoded_bits % conv->rate) {
+    size_t sets;
+    if (!convolutional_decode_sets(conv, num_encoded_bits, &sets)) {
         // XXX turn this into an error code
-        // printf("encoded length of message must be a multiple of rate\n");
+        // printf("encoded length of message must end on a whole time slice\n");
         return -1;
     }
 
     size_t num_encoded_bytes = (num_encoded_bits % 8) ? (num_encoded_bits / 8 + 1) : (num_encoded_bits / 8);
     bit_reader_reconfigure(conv->bit_reader, encoded, num_encoded_bytes);
 
-    return _convolutional_decode(conv, num_encoded_bits, num_encoded_bytes, msg, NULL);
+    return _convolutional_decode(conv, sets, num_encoded_bytes, msg, encoded, NULL);
 }
 
 ssize_t correct_convolutional_decode_soft(correct_convolutional *conv, const soft_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
-    if (num_encoded_bits % conv->rate) {
+    size_t sets;
+    if (!convolutional_decode_sets(conv, num_encoded_bits, &sets)) {
         // XXX turn this into an error code
-        // printf("encoded length of message must be a multiple of rate\n");
+        // printf("encoded length of message must end on a whole time slice\n");
         return -1;
     }
 
     size_t num_encoded_bytes = (num_encoded_bits % 8) ? (num_encoded_bits / 8 + 1) : (num_encoded_bits / 8);
 
-    return _convolutional_decode(conv, num_encoded_bits, num_encoded_bytes, msg, encoded);
+    return _convolutional_decode(conv, sets, num_encoded_bytes, msg, NULL, encoded);
+}
+
+// reduced-state decoding, see m_algorithm_t
+// runs the whole block through the m-algorithm in place of the viterbi decoder, writing
+//   the same number of bits to conv->bit_writer. it shares the distances with the viterbi
+//   decoder, so hard, soft, punctured and converted input all work the same way
+bool convolutional_decode_m_algorithm(correct_convolutional *conv, size_t sets, const soft_t *soft) {
+    if (!conv->m_algorithm) {
+        history_buffer *history = conv->history_buffer;
+        conv->m_algorithm = m_algorithm_create((unsigned int)conv->m_algorithm_paths, (unsigned int)conv->order,
+                                               history->min_traceback_length, history->traceback_group_length);
+        if (!conv->m_algorithm) {
+            return false;
+        }
+        conv->m_algorithm->stats = &conv->stats;
+    }
+
+    m_algorithm_t *m = conv->m_algorithm;
+    m_algorithm_reset(m);
+
+    // the last order - 1 time slices only flush the encoder with zeros
+    size_t tail_start = (sets > conv->order - 1) ? sets - (conv->order - 1) : 0;
+    for (size_t set = 0; set < sets; set++) {
+        convolutional_decode_distances(conv, soft, set);
+        m_algorithm_step(m, conv->table, conv->distances, set >= tail_start, conv->bit_writer);
+    }
+    m_algorithm_flush(m, conv->bit_writer);
+
+    return true;
+}
+
+// the syndrome pre-check, see syndrome_check_t
+// returns the message length if the block came through clean and msg holds it, or -1 if
+//   it needs the viterbi decoder. punctured and tail-biting blocks always do
+ssize_t convolutional_decode_syndrome(correct_convolutional *conv, const uint8_t *encoded, const soft_t *soft, size_t sets, uint8_t *msg) {
+    syndrome_check_t *check = conv->syndrome_check;
+    if (!check || conv->puncture || conv->tail_biting || !syndrome_check_reset(check, sets)) {
+        return -1;
+    }
+
+    if (soft) {
+        // whole time slices at a time, each starting on a whole byte of packed input
+        size_t num_symbols = sets * conv->rate;
+        size_t step = soft_input_chunk_cap - soft_input_chunk_cap % (8 * conv->rate);
+        for (size_t offset = 0; offset < num_symbols; offset += step) {
+            size_t len = (num_symbols - offset < step) ? num_symbols - offset : step;
+            if (!syndrome_check_load_soft(check, convolutional_decode_soft_slice(conv, soft, offset, len), offset, len)) {
+                return -1;
+            }
+        }
+    } else {
+        syndrome_check_load_hard(check, encoded, sets);
+    }
+
+    ssize_t msg_len = syndrome_check_decode(check, sets, msg);
+    if (msg_len > 0) {
+        // the message went straight to msg, but the crc decoders look to the bit writer
+        bit_writer_reconfigure(conv->bit_writer, msg, (size_t)msg_len);
+        bit_writer_advance(conv->bit_writer, (size_t)msg_len);
+    }
+    return msg_len;
+}
+
+// crc-checked decoding
+// the message bytes of the block end in a crc of the rest. the bit writer folds each byte
+//   into the crc as the traceback writes it, so checking costs no pass over msg. the
+//   tail-biting traceback fills msg from the end without the bit writer, so for those
+//   blocks the crc is taken afterwards
+
+// the whole message bytes in a block of sets time slices
+static size_t convolutional_decode_msg_len(const correct_convolutional *conv, size_t sets) {
+    if (conv->tail_biting) {
+        return sets / 8;
+    }
+
+    size_t tail = conv->order + 1;
+    return (sets > tail) ? (sets - tail) / 8 : 0;
+}
+
+bool convolutional_decode_crc_begin(correct_convolutional *conv, const correct_crc *crc, size_t sets, size_t *msg_len) {
+    size_t len = convolutional_decode_msg_len(conv, sets);
+    if (!crc || len < crc->width / 8) {
+        return false;
+    }
+
+    bit_writer_set_crc(conv->bit_writer, crc, len - crc->width / 8);
+    *msg_len = len;
+    return true;
+}
+
+ssize_t convolutional_decode_crc_end(correct_convolutional *conv, const correct_crc *crc, ssize_t decoded_len, const uint8_t *msg, size_t msg_len) {
+    size_t checked_len = msg_len - crc->width / 8;
+    uint32_t value = conv->tail_biting ? correct_crc_compute(crc, msg, checked_len) : bit_writer_crc(conv->bit_writer);
+    bit_writer_set_crc(conv->bit_writer, NULL, 0);
+
+    if (decoded_len < 0) {
+        return -1;
+    }
+
+    if ((size_t)decoded_len < msg_len) {
+        return 0;
+    }
+
+    return (value == crc_read(crc, msg + checked_len)) ? 1 : 0;
+}
+
+ssize_t correct_convolutional_decode_crc(correct_convolutional *conv, const uint8_t *encoded, size_t num_encoded_bits, const correct_crc *crc, uint8_t *msg) {
+    size_t sets;
+    size_t msg_len;
+    if (!convolutional_decode_sets(conv, num_encoded_bits, &sets) || !convolutional_decode_crc_begin(conv, crc, sets, &msg_len)) {
+        return -1;
+    }
+
+    ssize_t decoded_len = correct_convolutional_decode(conv, encoded, num_encoded_bits, msg);
+    return convolutional_decode_crc_end(conv, crc, decoded_len, msg, msg_len);
+}
+
+ssize_t correct_convolutional_decode_soft_crc(correct_convolutional *conv, const soft_t *encoded, size_t num_encoded_bits, const correct_crc *crc, uint8_t *msg) {
+    size_t sets;
+    size_t msg_len;
+    if (!convolutional_decode_sets(conv, num_encoded_bits, &sets) || !convolutional_decode_crc_begin(conv, crc, sets, &msg_len)) {
+        return -1;
+    }
+
+    ssize_t decoded_len = correct_convolutional_decode_soft(conv, encoded, num_encoded_bits, msg);
+    return convolutional_decode_crc_end(conv, crc, decoded_len, msg, msg_len);
+}
+
+// ready conv to convert encoded as the decoder reads it
+// the decoder is then handed encoded as if it were soft_t, which only marks it as soft
+bool convolutional_decode_soft_input_begin(correct_convolutional *conv, soft_convert_t convert, const void *encoded, size_t symbol_bits, size_t num_encoded_bits, float scale) {
+    if (!conv->soft_input) {
+        conv->soft_input = soft_input_create();
+        if (!conv->soft_input) {
+            return false;
+        }
+    }
+
+    soft_input_begin(conv->soft_input, convert, encoded, symbol_bits, num_encoded_bits, scale);
+    return true;
+}
+
+ssize_t correct_convolutional_decode_soft_s8(correct_convolutional *conv, const int8_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    if (!convolutional_decode_soft_input_begin(conv, soft_convert_s8, encoded, 8 * sizeof(int8_t), num_encoded_bits, 0.0f)) {
+        return -1;
+    }
+
+    ssize_t res = correct_convolutional_decode_soft(conv, (const soft_t *)encoded, num_encoded_bits, msg);
+    soft_input_end(conv->soft_input);
+    return res;
+}
+
+ssize_t correct_convolutional_decode_soft_llr_f32(correct_convolutional *conv, const float *encoded, size_t num_encoded_bits, float scale, uint8_t *msg) {
+    if (!convolutional_decode_soft_input_begin(conv, soft_convert_llr_f32, encoded, 8 * sizeof(float), num_encoded_bits, scale)) {
+        return -1;
+    }
+
+    ssize_t res = correct_convolutional_decode_soft(conv, (const soft_t *)encoded, num_encoded_bits, msg);
+    soft_input_end(conv->soft_input);
+    return res;
+}
+
+ssize_t correct_convolutional_decode_soft_u4(correct_convolutional *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    if (!convolutional_decode_soft_input_begin(conv, soft_convert_u4, encoded, 4, num_encoded_bits, 0.0f)) {
+        return -1;
+    }
+
+    ssize_t res = correct_convolutional_decode_soft(conv, (const soft_t *)encoded, num_encoded_bits, msg);
+    soft_input_end(conv->soft_input);
+    return res;
+}
+
+ssize_t correct_convolutional_decode_soft_u3(correct_convolutional *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    if (!convolutional_decode_soft_input_begin(conv, soft_convert_u3, encoded, 3, num_encoded_bits, 0.0f)) {
+        return -1;
+    }
+
+    ssize_t res = correct_convolutional_decode_soft(conv, (const soft_t *)encoded, num_encoded_bits, msg);
+    soft_input_end(conv->soft_input);
+    return res;
 }
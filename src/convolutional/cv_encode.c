@@ -2,11 +2,35 @@
 
 size_t correct_convolutional_encode_len(correct_convolutional *conv, size_t msg_len) {
     size_t msgbits = 8 * msg_len;
-    size_t encodedbits = conv->rate * (msgbits + conv->order + 1);
+    // a tail-biting block has no tail
+    size_t sets = conv->tail_biting ? msgbits : msgbits + conv->order + 1;
+
+    if (conv->puncture) {
+        return puncture_offset(conv->puncture, sets);
+    }
+
+    size_t encodedbits = conv->rate * sets;
 
     return encodedbits;
 }
 
+// write the outputs for one time slice, leaving out any that are punctured
+static inline void convolutional_encode_write(correct_convolutional *conv, size_t set, unsigned int out) {
+    if (!conv->puncture) {
+        // bit_writer_write expects uint8_t for first arg and unsigned int for second arg
+        // Make sure the out value fits within uint8_t range
+        bit_writer_write(conv->bit_writer, (uint8_t)(out & 0xFF), (unsigned int)(conv->rate < UINT_MAX ? conv->rate : UINT_MAX));
+        return;
+    }
+
+    unsigned int mask = conv->puncture->masks[set % conv->puncture->period];
+    for (unsigned int j = 0; j < conv->rate; j++) {
+        if (mask & (1u << j)) {
+            bit_writer_write_1(conv->bit_writer, (uint8_t)((out >> j) & 1));
+        }
+    }
+}
+
 // shift in most significant bit every time, one byte at a time
 // shift register takes most recent bit on right, shifts left
 // poly is written in same order, just & mask message w/ poly
@@ -29,6 +53,20 @@ size_t correct_convolutional_encode(correct_convolutional *conv, const uint8_t *
 
     bit_reader_reconfigure(conv->bit_reader, msg, msg_len);
 
+    size_t msgbits = 8 * msg_len;
+    if (conv->tail_biting && msgbits) {
+        // start from where the message will leave the shiftregister, i.e. with the last
+        //   order - 1 message bits already shifted in. the encoder then ends up back
+        //   where it started, and there is nothing to flush
+        size_t start = msgbits - (conv->order - 1) % msgbits;
+        for (size_t i = 0; i < conv->order - 1; i++) {
+            size_t index = (start + i) % msgbits;
+            shiftregister <<= 1;
+            shiftregister |= (msg[index / 8] >> (7 - index % 8)) & 1;
+        }
+        shiftregister &= shiftmask;
+    }
+
     for (size_t i = 0; i < 8 * msg_len; i++) {
         // shiftregister has oldest bits on left, newest on right
         shiftregister <<= 1;
@@ -40,20 +78,18 @@ size_t correct_convolutional_encode(correct_convolutional *conv, const uint8_t *
         // we do direct lookup of our convolutional output here
         // all of the bits from this convolution are stored in this row
         unsigned int out = conv->table[shiftregister];
-        
-        // bit_writer_write expects uint8_t for first arg and unsigned int for second arg
-        // Make sure the out value fits within uint8_t range
-        bit_writer_write(conv->bit_writer, (uint8_t)(out & 0xFF), (unsigned int)(conv->rate < UINT_MAX ? conv->rate : UINT_MAX));
+        convolutional_encode_write(conv, i, out);
     }
 
     // now flush the shiftregister
     // this is simply running the loop as above but without any new inputs
     // or rather, the new input string is all 0s
-    for (size_t i = 0; i < conv->order + 1; i++) {
+    size_t tail_len = conv->tail_biting ? 0 : conv->order + 1;
+    for (size_t i = 0; i < tail_len; i++) {
         shiftregister <<= 1;
         shiftregister &= shiftmask;
         unsigned int out = conv->table[shiftregister];
-        bit_writer_write(conv->bit_writer, (uint8_t)(out & 0xFF), (unsigned int)(conv->rate < UINT_MAX ? conv->rate : UINT_MAX));
+        convolutional_encode_write(conv, 8 * msg_len + i, out);
     }
 
     // 0-fill any remaining bits on our final byte
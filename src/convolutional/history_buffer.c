@@ -92,13 +92,17 @@ shift_register_t history_buffer_search(history_buffer *buf, const distance_t *di
 }
 
 void history_buffer_renormalize(history_buffer *buf, distance_t *distances, shift_register_t min_register) {
+    uint64_t start = profile_now();
     distance_t min_distance = distances[min_register];
     for (shift_register_t i = 0; i < buf->num_states; i++) {
         distances[i] -= min_distance;
     }
+    decoder_stats_renormalize(buf->stats, min_distance);
+    profile_add(PROFILE_CONV_RENORMALIZE, start);
 }
 
 void history_buffer_traceback(history_buffer *buf, shift_register_t bestpath, unsigned int min_traceback_length, bit_writer_t *output) {
+    uint64_t start = profile_now();
     unsigned int fetched_index = 0;
     shift_register_t highbit = buf->highbit;
     unsigned int index = buf->index;
@@ -147,8 +151,13 @@ void history_buffer_traceback(history_buffer *buf, shift_register_t bestpath, un
         fetched_index++;
     }
 
+    profile_add(PROFILE_CONV_TRACEBACK, start);
+
+    start = profile_now();
     bit_writer_write_bitlist_reversed(output, buf->fetched, fetched_index);
+    profile_add(PROFILE_CONV_OUTPUT, start);
     buf->len -= fetched_index;
+    decoder_stats_traceback(buf->stats);
 }
 
 void history_buffer_process_skip(history_buffer *buf, distance_t *distances, bit_writer_t *output, unsigned int skip) {
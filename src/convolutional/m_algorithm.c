@@ -0,0 +1,265 @@
+#include "correct/convolutional/m_algorithm.h"
+
+m_algorithm_t *m_algorithm_create(unsigned int max_paths, unsigned int order, unsigned int min_traceback_length, unsigned int traceback_group_length) {
+    m_algorithm_t *m = (m_algorithm_t *)calloc(1, sizeof(m_algorithm_t));
+    if (!m) {
+        return NULL;
+    }
+
+    m->order = order;
+    m->num_states = 1u << (order - 1);
+    // more paths than states can't survive, as extensions into one state merge
+    m->max_paths = (max_paths < m->num_states) ? max_paths : m->num_states;
+    m->min_traceback_length = min_traceback_length;
+    m->traceback_group_length = traceback_group_length;
+    m->cap = min_traceback_length + traceback_group_length;
+
+    size_t max_candidates = 2 * (size_t)m->max_paths;
+    m->states = (shift_register_t *)malloc(m->max_paths * sizeof(shift_register_t));
+    m->metrics = (uint32_t *)malloc(m->max_paths * sizeof(uint32_t));
+    m->candidate_states = (shift_register_t *)malloc(max_candidates * sizeof(shift_register_t));
+    m->candidate_metrics = (uint32_t *)malloc(max_candidates * sizeof(uint32_t));
+    m->candidate_links = (uint32_t *)malloc(max_candidates * sizeof(uint32_t));
+    // selection writes one past the last path it keeps
+    m->kept = (unsigned int *)malloc((m->max_paths + 1) * sizeof(unsigned int));
+    m->state_paths = (m_algorithm_state_t *)malloc(m->num_states * sizeof(m_algorithm_state_t));
+    m->links = (uint32_t *)malloc((size_t)m->cap * m->max_paths * sizeof(uint32_t));
+    m->fetched = (uint8_t *)malloc(m->cap);
+    if (!m->states || !m->metrics || !m->candidate_states || !m->candidate_metrics || !m->candidate_links ||
+        !m->kept || !m->state_paths || !m->links || !m->fetched) {
+        m_algorithm_destroy(m);
+        return NULL;
+    }
+
+    m_algorithm_reset(m);
+
+    return m;
+}
+
+void m_algorithm_destroy(m_algorithm_t *m) {
+    if (!m) {
+        return;
+    }
+
+    free(m->states);
+    free(m->metrics);
+    free(m->candidate_states);
+    free(m->candidate_metrics);
+    free(m->candidate_links);
+    free(m->kept);
+    free(m->state_paths);
+    free(m->links);
+    free(m->fetched);
+    free(m);
+}
+
+// start a block from state 0, where the encoder starts
+void m_algorithm_reset(m_algorithm_t *m) {
+    m->num_paths = 1;
+    m->states[0] = 0;
+    m->metrics[0] = 0;
+
+    memset(m->state_paths, 0, m->num_states * sizeof(m_algorithm_state_t));
+    m->slice = 0;
+
+    m->index = 0;
+    m->len = 0;
+}
+
+// pick the max_paths candidates with the lowest metrics into m->kept
+// a full sort isn't needed, just the metric at the cut between kept and dropped. a
+//   histogram of 256 buckets over the spread of the metrics finds the bucket the cut
+//   falls in, and if that bucket is wider than one metric and holds more candidates
+//   than there's room for, it is itself split into 256, and so on. counting into
+//   buckets has no branches, where partitioning around a pivot mispredicts half of them
+static unsigned int m_algorithm_select(m_algorithm_t *m, unsigned int num_candidates, uint32_t low, uint32_t high) {
+    const uint32_t *metrics = m->candidate_metrics;
+    unsigned int *kept = m->kept;
+    unsigned int max_paths = m->max_paths;
+
+    if (num_candidates <= max_paths) {
+        for (unsigned int c = 0; c < num_candidates; c++) {
+            kept[c] = c;
+        }
+        return num_candidates;
+    }
+
+    unsigned int shift = 0;
+    while (((high - low) >> shift) > 255) {
+        shift++;
+    }
+
+    // every candidate below low is kept, and need more are wanted from low up. the last
+    //   bucket catches everything outside the 256
+    unsigned int *counts = m->select_counts;
+    unsigned int need = max_paths;
+    unsigned int below;
+    unsigned int cut_bucket;
+    for (;;) {
+        memset(counts, 0, 257 * sizeof(unsigned int));
+        for (unsigned int c = 0; c < num_candidates; c++) {
+            uint32_t bucket = (metrics[c] - low) >> shift;
+            counts[(bucket < 256) ? bucket : 256]++;
+        }
+
+        below = 0;
+        cut_bucket = 0;
+        while (below + counts[cut_bucket] < need) {
+            below += counts[cut_bucket];
+            cut_bucket++;
+        }
+
+        if (below + counts[cut_bucket] == need || shift == 0) {
+            break;
+        }
+
+        need -= below;
+        low += (uint32_t)cut_bucket << shift;
+        shift = (shift > 8) ? shift - 8 : 0;
+    }
+
+    // everything under the cut bucket, then as much of it as there's room for
+    uint32_t cut = low + ((uint32_t)cut_bucket << shift);
+    uint32_t cut_width = 1u << shift;
+    unsigned int room = need - below;
+    unsigned int num_kept = 0;
+    for (unsigned int c = 0; c < num_candidates; c++) {
+        bool on_cut = metrics[c] - cut < cut_width;
+        bool take_on_cut = on_cut && room;
+        kept[num_kept] = c;
+        num_kept += (metrics[c] < cut) || take_on_cut;
+        room -= take_on_cut;
+    }
+
+    return num_kept;
+}
+
+// trace back from path, skipping the newest skip time slices and writing out the rest
+static void m_algorithm_traceback(m_algorithm_t *m, unsigned int path, unsigned int skip, bit_writer_t *output) {
+    if (m->len <= skip) {
+        return;
+    }
+
+    unsigned int index = m->index;
+    unsigned int fetched_index = 0;
+    for (unsigned int j = 0; j < m->len; j++) {
+        index = index ? index - 1 : m->cap - 1;
+        uint32_t link = m->links[(size_t)index * m->max_paths + path];
+        if (j >= skip) {
+            m->fetched[fetched_index++] = (uint8_t)(link & 1);
+        }
+        path = link >> 1;
+    }
+
+    bit_writer_write_bitlist_reversed(output, m->fetched, fetched_index);
+    m->len = skip;
+    decoder_stats_traceback(m->stats);
+}
+
+static unsigned int m_algorithm_best_path(const m_algorithm_t *m) {
+    unsigned int best = 0;
+    for (unsigned int p = 1; p < m->num_paths; p++) {
+        if (m->metrics[p] < m->metrics[best]) {
+            best = p;
+        }
+    }
+    return best;
+}
+
+// extend the paths by one time slice. with zero_input, only by a 0, as in the tail
+void m_algorithm_step(m_algorithm_t *m, const unsigned int *table, const distance_t *distances, bool zero_input, bit_writer_t *output) {
+    uint32_t slice = ++m->slice;
+    unsigned int num_paths = m->num_paths;
+    const shift_register_t *states = m->states;
+    const uint32_t *metrics = m->metrics;
+    shift_register_t high_bit = m->num_states >> 1;
+    shift_register_t state_mask = m->num_states - 1;
+    shift_register_t register_mask = 2 * m->num_states - 1;
+
+    m_algorithm_state_t *state_paths = m->state_paths;
+    shift_register_t *candidate_states = m->candidate_states;
+    uint32_t *candidate_metrics = m->candidate_metrics;
+    uint32_t *candidate_links = m->candidate_links;
+
+    // the encoder's output is linear in its register, so every output here is one
+    //   lookup and some xors. the table is too big to stay in cache for large orders
+    unsigned int input_output = table[1];
+    unsigned int partner_output = table[high_bit << 1];
+
+    // two paths only meet in the next slice if their states differ in just the high bit,
+    //   which shifts out. mark which states have a path first, so that each path can
+    //   find its partner without a chain of lookups through the candidates
+    for (unsigned int p = 0; p < num_paths; p++) {
+        state_paths[states[p]].slice = slice;
+        state_paths[states[p]].path = p;
+    }
+
+    // the path with the high bit clear extends both, and its partner none. the metrics
+    //   are noise, so this is written without branches. both inputs are always worked
+    //   out, and with zero_input the second is a copy of the first that isn't counted
+    unsigned int num_candidates = 0;
+    unsigned int inputs = zero_input ? 1 : 2;
+    uint32_t low = UINT32_MAX;
+    uint32_t high = 0;
+    for (unsigned int p = 0; p < num_paths; p++) {
+        shift_register_t state = states[p];
+        m_algorithm_state_t partner_state = state_paths[state ^ high_bit];
+        bool paired = partner_state.slice == slice;
+        unsigned int partner = paired ? partner_state.path : p;
+        bool extends = !paired || !(state & high_bit);
+
+        // an unpaired path competes with a partner that can't win
+        uint32_t path_metric = metrics[p];
+        uint32_t partner_metric = paired ? metrics[partner] : UINT32_MAX / 2;
+
+        shift_register_t reg = (state << 1) & register_mask;
+        unsigned int out = table[reg];
+        uint32_t zero = path_metric + distances[out];
+        uint32_t partner_zero = partner_metric + distances[out ^ partner_output];
+        uint32_t one = path_metric + distances[out ^ input_output];
+        uint32_t partner_one = partner_metric + distances[out ^ input_output ^ partner_output];
+        bool zero_better = zero <= partner_zero;
+        bool one_better = one <= partner_one;
+        uint32_t best_zero = zero_better ? zero : partner_zero;
+        uint32_t best_one = zero_input ? best_zero : (one_better ? one : partner_one);
+
+        candidate_states[num_candidates] = reg & state_mask;
+        candidate_metrics[num_candidates] = best_zero;
+        candidate_links[num_candidates] = (zero_better ? p : partner) << 1;
+        candidate_states[num_candidates + 1] = (reg | 1) & state_mask;
+        candidate_metrics[num_candidates + 1] = best_one;
+        candidate_links[num_candidates + 1] = ((one_better ? p : partner) << 1) | 1;
+
+        low = (best_zero < low) ? best_zero : low;
+        low = (best_one < low) ? best_one : low;
+        high = (best_zero > high) ? best_zero : high;
+        high = (best_one > high) ? best_one : high;
+        num_candidates += extends ? inputs : 0;
+    }
+
+    unsigned int num_kept = m_algorithm_select(m, num_candidates, low, high);
+
+    // keep the metrics relative to the best path, so that they never overflow
+    uint32_t *links = m->links + (size_t)m->index * m->max_paths;
+    for (unsigned int k = 0; k < num_kept; k++) {
+        unsigned int c = m->kept[k];
+        m->states[k] = candidate_states[c];
+        m->metrics[k] = candidate_metrics[c] - low;
+        links[k] = candidate_links[c];
+    }
+    m->num_paths = num_kept;
+    decoder_stats_renormalize(m->stats, low);
+
+    m->index = (m->index + 1 == m->cap) ? 0 : m->index + 1;
+    m->len++;
+    if (m->len == m->cap) {
+        m_algorithm_traceback(m, m_algorithm_best_path(m), m->min_traceback_length, output);
+    }
+}
+
+// write out the rest of the block, leaving off the zero tail of order - 1 bits
+void m_algorithm_flush(m_algorithm_t *m, bit_writer_t *output) {
+    unsigned int best = m_algorithm_best_path(m);
+    decoder_stats_end_block(m->stats, m->metrics[best]);
+    m_algorithm_traceback(m, best, m->order - 1, output);
+}
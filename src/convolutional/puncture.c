@@ -0,0 +1,113 @@
+#include "correct/convolutional/puncture.h"
+
+void correct_convolutional_puncture_destroy(correct_convolutional_puncture *puncture) {
+    if (!puncture) {
+        return;
+    }
+
+    if (puncture->pattern) {
+        free(puncture->pattern);
+    }
+
+    if (puncture->masks) {
+        free(puncture->masks);
+    }
+
+    if (puncture->counts) {
+        free(puncture->counts);
+    }
+
+    if (puncture->offsets) {
+        free(puncture->offsets);
+    }
+
+    if (puncture->compact) {
+        free(puncture->compact);
+    }
+
+    free(puncture);
+}
+
+correct_convolutional_puncture *correct_convolutional_puncture_create(size_t inv_rate, const uint8_t *pattern, size_t period) {
+    if (!pattern || inv_rate < 2 || inv_rate > 8 || period == 0) {
+        return NULL;
+    }
+
+    correct_convolutional_puncture *puncture = (correct_convolutional_puncture *)calloc(1, sizeof(correct_convolutional_puncture));
+    if (!puncture) {
+        return NULL;
+    }
+
+    puncture->inv_rate = inv_rate;
+    puncture->period = period;
+
+    unsigned int num_outputs = 1u << inv_rate;
+    puncture->pattern = (uint8_t *)malloc(period * inv_rate);
+    puncture->masks = (unsigned int *)malloc(period * sizeof(unsigned int));
+    puncture->counts = (unsigned int *)malloc(period * sizeof(unsigned int));
+    puncture->offsets = (size_t *)malloc(period * sizeof(size_t));
+    puncture->compact = (unsigned int *)malloc(period * num_outputs * sizeof(unsigned int));
+    if (!puncture->pattern || !puncture->masks || !puncture->counts || !puncture->offsets || !puncture->compact) {
+        correct_convolutional_puncture_destroy(puncture);
+        return NULL;
+    }
+
+    memcpy(puncture->pattern, pattern, period * inv_rate);
+
+    puncture->sent = 0;
+    for (size_t step = 0; step < period; step++) {
+        unsigned int mask = 0;
+        unsigned int count = 0;
+        for (size_t j = 0; j < inv_rate; j++) {
+            if (pattern[step * inv_rate + j]) {
+                mask |= 1u << j;
+                count++;
+            }
+        }
+
+        if (count == 0) {
+            // a time slice with nothing sent couldn't be found again in the stream
+            correct_convolutional_puncture_destroy(puncture);
+            return NULL;
+        }
+
+        puncture->masks[step] = mask;
+        puncture->counts[step] = count;
+        puncture->offsets[step] = puncture->sent;
+        puncture->sent += count;
+
+        for (unsigned int output = 0; output < num_outputs; output++) {
+            unsigned int packed = 0;
+            unsigned int packed_bit = 0;
+            for (size_t j = 0; j < inv_rate; j++) {
+                if (mask & (1u << j)) {
+                    packed |= ((output >> j) & 1) << packed_bit;
+                    packed_bit++;
+                }
+            }
+            puncture->compact[step * num_outputs + output] = packed;
+        }
+    }
+
+    return puncture;
+}
+
+correct_convolutional_puncture *puncture_copy(const correct_convolutional_puncture *puncture) {
+    return correct_convolutional_puncture_create(puncture->inv_rate, puncture->pattern, puncture->period);
+}
+
+// find how many time slices make up num_encoded_bits of punctured stream
+// this fails if the stream ends partway through a time slice
+bool puncture_sets(const correct_convolutional_puncture *puncture, size_t num_encoded_bits, size_t *sets) {
+    size_t periods = num_encoded_bits / puncture->sent;
+    size_t rem = num_encoded_bits % puncture->sent;
+
+    for (size_t step = 0; step < puncture->period; step++) {
+        if (puncture->offsets[step] == rem) {
+            *sets = periods * puncture->period + step;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,171 @@
+#include "correct/convolutional/register_exchange.h"
+
+void register_exchange_destroy(register_exchange *reg) {
+    if (!reg) {
+        return;
+    }
+
+    if (reg->registers) {
+        free(reg->registers);
+    }
+
+    if (reg->next_registers) {
+        free(reg->next_registers);
+    }
+
+    if (reg->decisions) {
+        free(reg->decisions);
+    }
+
+    free(reg);
+}
+
+register_exchange *register_exchange_create(unsigned int min_traceback_length, unsigned int traceback_group_length, unsigned int renormalize_interval, unsigned int num_states) {
+    if (!traceback_group_length || min_traceback_length + traceback_group_length > register_exchange_max_cap) {
+        return NULL;
+    }
+
+    register_exchange *reg = (register_exchange *)calloc(1, sizeof(register_exchange));
+    if (!reg) {
+        return NULL;
+    }
+
+    reg->min_traceback_length = min_traceback_length;
+    reg->traceback_group_length = traceback_group_length;
+    reg->cap = min_traceback_length + traceback_group_length;
+    reg->num_states = num_states;
+
+    reg->registers = (path_t *)calloc(num_states, sizeof(path_t));
+    reg->next_registers = (path_t *)calloc(num_states, sizeof(path_t));
+    // the sse add-compare-select writes decisions 64 states at a time
+    reg->decisions = (uint8_t *)calloc(num_states < 64 ? 64 : num_states, sizeof(uint8_t));
+    if (!reg->registers || !reg->next_registers || !reg->decisions) {
+        register_exchange_destroy(reg);
+        return NULL;
+    }
+
+    reg->len = 0;
+
+    reg->renormalize_counter = 0;
+    reg->renormalize_interval = renormalize_interval;
+
+    return reg;
+}
+
+void register_exchange_reset(register_exchange *reg) {
+    reg->len = 0;
+}
+
+uint8_t *register_exchange_get_slice(register_exchange *reg) {
+    return reg->decisions;
+}
+
+void register_exchange_swap(register_exchange *reg) {
+    path_t *temp = reg->registers;
+    reg->registers = reg->next_registers;
+    reg->next_registers = temp;
+}
+
+// move every register along one time slice, using the decisions in reg->decisions
+// a decision is nonzero when the predecessor had its high order bit set, which is also
+//   the decoded bit for the slice, so that's what gets shifted in
+// only every skip'th state is updated, as the trellis narrows during the tail
+void register_exchange_update_skip(register_exchange *reg, unsigned int skip) {
+    const uint8_t *decisions = reg->decisions;
+    const path_t *registers = reg->registers;
+    path_t *next_registers = reg->next_registers;
+    shift_register_t highbase = reg->num_states >> 1;
+
+    if (skip == 1) {
+        // states 2*base and 2*base + 1 share their two predecessors, base and highbase + base
+        for (shift_register_t base = 0; base < highbase; base++) {
+            path_t low = registers[base];
+            path_t high = registers[highbase + base];
+            path_t select = low ^ high;
+
+            path_t even = decisions[2 * base] & 1;
+            path_t odd = decisions[2 * base + 1] & 1;
+            next_registers[2 * base] = ((low ^ (select & -even)) << 1) | even;
+            next_registers[2 * base + 1] = ((low ^ (select & -odd)) << 1) | odd;
+        }
+    } else {
+        for (shift_register_t state = 0; state < reg->num_states; state += skip) {
+            path_t bit = decisions[state] & 1;
+            shift_register_t predecessor = (state >> 1) | (bit ? highbase : 0);
+            next_registers[state] = (registers[predecessor] << 1) | bit;
+        }
+    }
+
+    register_exchange_swap(reg);
+}
+
+static shift_register_t register_exchange_search(register_exchange *reg, const distance_t *distances, unsigned int search_every) {
+    shift_register_t bestpath = 0;
+    distance_t leasterror = USHRT_MAX;
+
+    // search for a state with the least error
+    for (shift_register_t state = 0; state < reg->num_states; state += search_every) {
+        if (distances[state] < leasterror) {
+            leasterror = distances[state];
+            bestpath = state;
+        }
+    }
+
+    return bestpath;
+}
+
+static void register_exchange_renormalize(register_exchange *reg, distance_t *distances, shift_register_t min_register) {
+    uint64_t start = profile_now();
+    distance_t min_distance = distances[min_register];
+    for (shift_register_t i = 0; i < reg->num_states; i++) {
+        distances[i] -= min_distance;
+    }
+    decoder_stats_renormalize(reg->stats, min_distance);
+    profile_add(PROFILE_CONV_RENORMALIZE, start);
+}
+
+// write out the bits of bestpath's register that are at least min_traceback_length old,
+//   oldest first
+static void register_exchange_output(register_exchange *reg, shift_register_t bestpath, unsigned int min_traceback_length, bit_writer_t *output) {
+    if (reg->len > min_traceback_length) {
+        uint64_t start = profile_now();
+        path_t path = reg->registers[bestpath] >> min_traceback_length;
+        bit_writer_write_bits(output, path, reg->len - min_traceback_length);
+        profile_add(PROFILE_CONV_OUTPUT, start);
+    }
+    reg->len = min_traceback_length;
+}
+
+// the bookkeeping half of register_exchange_process_skip, for decoders that move the
+//   registers along themselves
+void register_exchange_output_skip(register_exchange *reg, distance_t *distances, bit_writer_t *output, unsigned int skip) {
+    reg->renormalize_counter++;
+    reg->len++;
+
+    // as in history_buffer_process_skip, reuse the bestpath when we both renormalize and
+    //   output on the same slice
+    if (reg->renormalize_counter == reg->renormalize_interval) {
+        reg->renormalize_counter = 0;
+        shift_register_t bestpath = register_exchange_search(reg, distances, skip);
+        register_exchange_renormalize(reg, distances, bestpath);
+        if (reg->len == reg->cap) {
+            register_exchange_output(reg, bestpath, reg->min_traceback_length, output);
+        }
+    } else if (reg->len == reg->cap) {
+        shift_register_t bestpath = register_exchange_search(reg, distances, skip);
+        register_exchange_output(reg, bestpath, reg->min_traceback_length, output);
+    }
+}
+
+void register_exchange_process_skip(register_exchange *reg, distance_t *distances, bit_writer_t *output, unsigned int skip) {
+    register_exchange_update_skip(reg, skip);
+    register_exchange_output_skip(reg, distances, output, skip);
+}
+
+void register_exchange_process(register_exchange *reg, distance_t *distances, bit_writer_t *output) {
+    register_exchange_process_skip(reg, distances, output, 1);
+}
+
+void register_exchange_flush(register_exchange *reg, bit_writer_t *output) {
+    register_exchange_output(reg, 0, 0, output);
+}
@@ -0,0 +1,319 @@
+#include <math.h>
+
+#include "correct/convolutional/sequential.h"
+
+// the metrics are in units of 1/sequential_metric_scale bits
+static const double sequential_metric_scale = 16.0;
+
+// no symbol can take a path's metric lower than this, so an erasure or a symbol far
+//   out in the noise can't bury the right path for good
+static const int32_t sequential_metric_floor = -16 * 16;
+
+static const double sequential_default_eb_n0 = 3.0;
+static const size_t sequential_default_compute_budget = 1000;
+
+// P(lo <= x < hi) for x normal with the given mean and standard deviation
+static double sequential_normal_mass(double lo, double hi, double mean, double sigma) {
+    return 0.5 * (erfc((lo - mean) / (sigma * sqrt(2.0))) - erfc((hi - mean) / (sigma * sqrt(2.0))));
+}
+
+static int32_t sequential_metric(double p, double p_total, double bias) {
+    if (p <= 0) {
+        return sequential_metric_floor;
+    }
+    double metric = floor(0.5 + sequential_metric_scale * (log2(p / p_total) - bias));
+    return (metric < sequential_metric_floor) ? sequential_metric_floor : (int32_t)metric;
+}
+
+// the soft symbols are bpsk at +-1, scaled from [-1, 1] to [0, 255] and clamped, as
+//   decode_bpsk_soft makes them. symbol s covers [s - 127.5, s - 126.5) / 127.5 and
+//   0 and 255 cover everything beyond
+static void sequential_fill_metrics(correct_convolutional_sequential *seq) {
+    double bias = 1.0 / seq->rate;
+    double es_n0 = pow(10.0, seq->eb_n0 / 10.0) * bias;
+    double sigma = sqrt(1.0 / (2.0 * es_n0));
+
+    for (unsigned int s = 0; s < 256; s++) {
+        double lo = (s == 0) ? -HUGE_VAL : (s - 127.5) / 127.5;
+        double hi = (s == 255) ? HUGE_VAL : (s - 126.5) / 127.5;
+        double p0 = sequential_normal_mass(lo, hi, -1.0, sigma);
+        double p1 = sequential_normal_mass(lo, hi, 1.0, sigma);
+        double p_total = 0.5 * (p0 + p1);
+        seq->soft_metrics[0][s] = sequential_metric(p0, p_total, bias);
+        seq->soft_metrics[1][s] = sequential_metric(p1, p_total, bias);
+    }
+
+    // hard decisions see the same channel as a binary symmetric one
+    double crossover = sequential_normal_mass(-HUGE_VAL, 0.0, 1.0, sigma);
+    for (unsigned int s = 0; s < 256; s++) {
+        unsigned int bit = s >> 7;
+        seq->hard_metrics[bit][s] = sequential_metric(1.0 - crossover, 0.5, bias);
+        seq->hard_metrics[bit ^ 1][s] = sequential_metric(crossover, 0.5, bias);
+    }
+
+    // the threshold moves by about what a time slice of clean symbols adds
+    int32_t delta = 0;
+    for (size_t k = 0; k < seq->rate; k++) {
+        delta += seq->soft_metrics[1][255];
+    }
+    seq->delta = (delta > 0) ? delta : 1;
+}
+
+correct_convolutional_sequential *correct_convolutional_sequential_create(size_t inv_rate, size_t order, const correct_convolutional_long_polynomial_t *poly) {
+    if (order < 2 || order > 8 * sizeof(path_t)) {
+        return NULL;
+    }
+
+    // bit_writer_write takes a byte of outputs
+    if (inv_rate < 2 || inv_rate > 8) {
+        return NULL;
+    }
+
+    correct_convolutional_sequential *seq = (correct_convolutional_sequential *)calloc(1, sizeof(correct_convolutional_sequential));
+    if (!seq) {
+        return NULL;
+    }
+
+    seq->rate = inv_rate;
+    seq->order = order;
+    seq->register_mask = (order == 8 * sizeof(path_t)) ? ~(path_t)0 : (((path_t)1 << order) - 1);
+
+    // each byte of the register meets a byte of every polynomial, which is a code of
+    //   order 8 for fill_table
+    for (unsigned int i = 0; i < 8; i++) {
+        polynomial_t byte_poly[8];
+        for (size_t k = 0; k < inv_rate; k++) {
+            byte_poly[k] = (polynomial_t)((poly[k] & seq->register_mask) >> (8 * i) & 0xff);
+        }
+        fill_table((unsigned int)inv_rate, 8, byte_poly, seq->table[i]);
+    }
+
+    seq->eb_n0 = sequential_default_eb_n0;
+    sequential_fill_metrics(seq);
+    seq->compute_budget = sequential_default_compute_budget;
+
+    seq->bit_writer = bit_writer_create(NULL, 0);
+    seq->bit_reader = bit_reader_create(NULL, 0);
+    if (!seq->bit_writer || !seq->bit_reader) {
+        correct_convolutional_sequential_destroy(seq);
+        return NULL;
+    }
+
+    return seq;
+}
+
+void correct_convolutional_sequential_destroy(correct_convolutional_sequential *seq) {
+    if (!seq) {
+        return;
+    }
+
+    free(seq->nodes);
+    free(seq->soft);
+    bit_writer_destroy(seq->bit_writer);
+    bit_reader_destroy(seq->bit_reader);
+    free(seq);
+}
+
+ssize_t correct_convolutional_sequential_set_channel(correct_convolutional_sequential *seq, double eb_n0) {
+    if (!seq) {
+        return -1;
+    }
+
+    if (!(eb_n0 > -10.0 && eb_n0 < 30.0)) {
+        return -1;
+    }
+
+    seq->eb_n0 = eb_n0;
+    sequential_fill_metrics(seq);
+    return 0;
+}
+
+ssize_t correct_convolutional_sequential_set_compute_budget(correct_convolutional_sequential *seq, size_t cycles_per_bit) {
+    if (!seq) {
+        return -1;
+    }
+
+    if (!cycles_per_bit) {
+        return -1;
+    }
+
+    seq->compute_budget = cycles_per_bit;
+    return 0;
+}
+
+static inline unsigned int sequential_output(const correct_convolutional_sequential *seq, path_t reg) {
+    unsigned int out = 0;
+    for (unsigned int i = 0; i < 8 && reg; i++, reg >>= 8) {
+        out ^= seq->table[i][reg & 0xff];
+    }
+    return out;
+}
+
+// as correct_convolutional_encode, the message is followed by order + 1 0 bits
+size_t correct_convolutional_sequential_encode_len(correct_convolutional_sequential *seq, size_t msg_len) {
+    return seq->rate * (8 * msg_len + seq->order + 1);
+}
+
+size_t correct_convolutional_sequential_encode(correct_convolutional_sequential *seq, const uint8_t *msg, size_t msg_len, uint8_t *encoded) {
+    size_t encoded_len_bits = correct_convolutional_sequential_encode_len(seq, msg_len);
+    size_t encoded_len = (encoded_len_bits % 8) ? (encoded_len_bits / 8 + 1) : (encoded_len_bits / 8);
+    bit_writer_reconfigure(seq->bit_writer, encoded, encoded_len);
+    bit_reader_reconfigure(seq->bit_reader, msg, msg_len);
+
+    path_t reg = 0;
+    size_t sets = 8 * msg_len + seq->order + 1;
+    for (size_t i = 0; i < sets; i++) {
+        path_t bit = (i < 8 * msg_len) ? bit_reader_read(seq->bit_reader, 1) : 0;
+        reg = ((reg << 1) | bit) & seq->register_mask;
+        bit_writer_write(seq->bit_writer, (uint8_t)sequential_output(seq, reg), (unsigned int)seq->rate);
+    }
+
+    bit_writer_flush_byte(seq->bit_writer);
+
+    return encoded_len_bits;
+}
+
+// work out the metrics of both branches out of node, whose next symbols are at symbols.
+//   the encoder is linear, so the output for a 1 in is the output for a 0 xor the
+//   output of the register holding just the 1
+static inline void sequential_branches(const correct_convolutional_sequential *seq, sequential_node_t *node,
+                                       const soft_t *symbols, const int32_t (*metrics)[256]) {
+    unsigned int out = sequential_output(seq, (node->reg << 1) & seq->register_mask);
+    unsigned int out_one = out ^ seq->table[0][1];
+    int32_t zero = 0;
+    int32_t one = 0;
+    for (size_t k = 0; k < seq->rate; k++) {
+        zero += metrics[(out >> k) & 1][symbols[k]];
+        one += metrics[(out_one >> k) & 1][symbols[k]];
+    }
+
+    bool one_better = one > zero;
+    node->best = one_better;
+    node->metrics[0] = one_better ? one : zero;
+    node->metrics[1] = one_better ? zero : one;
+    node->tried = 0;
+}
+
+// in the tail only a 0 goes in
+static inline void sequential_tail_branch(const correct_convolutional_sequential *seq, sequential_node_t *node,
+                                          const soft_t *symbols, const int32_t (*metrics)[256]) {
+    unsigned int out = sequential_output(seq, (node->reg << 1) & seq->register_mask);
+    int32_t zero = 0;
+    for (size_t k = 0; k < seq->rate; k++) {
+        zero += metrics[(out >> k) & 1][symbols[k]];
+    }
+
+    node->best = 0;
+    node->metrics[0] = zero;
+    node->tried = 0;
+}
+
+static ssize_t sequential_decode(correct_convolutional_sequential *seq, const soft_t *soft, size_t num_encoded_bits,
+                                 const int32_t (*metrics)[256], uint8_t *msg) {
+    size_t rate = seq->rate;
+    size_t tail = seq->order + 1;
+    if (num_encoded_bits % rate) {
+        return -1;
+    }
+    size_t sets = num_encoded_bits / rate;
+    if (sets < tail || (sets - tail) % 8) {
+        return -1;
+    }
+    size_t msg_bits = sets - tail;
+
+    if (sets + 1 > seq->nodes_cap) {
+        sequential_node_t *nodes = (sequential_node_t *)realloc(seq->nodes, (sets + 1) * sizeof(sequential_node_t));
+        if (!nodes) {
+            return -1;
+        }
+        seq->nodes = nodes;
+        seq->nodes_cap = sets + 1;
+    }
+
+    // a budget too big to count to is no budget at all
+    size_t max_cycles = (seq->compute_budget > SIZE_MAX / sets) ? SIZE_MAX : seq->compute_budget * sets;
+
+    sequential_node_t *nodes = seq->nodes;
+    nodes[0].reg = 0;
+    nodes[0].gamma = 0;
+    if (msg_bits) {
+        sequential_branches(seq, &nodes[0], soft, metrics);
+    } else {
+        sequential_tail_branch(seq, &nodes[0], soft, metrics);
+    }
+
+    int64_t threshold = 0;
+    int64_t delta = seq->delta;
+    size_t depth = 0;
+    for (size_t cycles = 0; depth < sets; cycles++) {
+        if (cycles == max_cycles) {
+            return -1;
+        }
+
+        sequential_node_t *node = &nodes[depth];
+        int64_t gamma = node->gamma + node->metrics[node->tried];
+        if (gamma >= threshold) {
+            // the first time through a node, raise the threshold as far as it goes
+            if (node->gamma < threshold + delta) {
+                while (gamma >= threshold + delta) {
+                    threshold += delta;
+                }
+            }
+
+            sequential_node_t *next = node + 1;
+            next->reg = ((node->reg << 1) | (path_t)(node->best ^ node->tried)) & seq->register_mask;
+            next->gamma = gamma;
+            depth++;
+            if (depth < msg_bits) {
+                sequential_branches(seq, next, soft + depth * rate, metrics);
+            } else if (depth < sets) {
+                sequential_tail_branch(seq, next, soft + depth * rate, metrics);
+            }
+            continue;
+        }
+
+        // back up to a node with a branch left to try. if there's none above the
+        //   threshold, lower it and go forward again from here
+        for (;;) {
+            if (!depth || nodes[depth - 1].gamma < threshold) {
+                threshold -= delta;
+                nodes[depth].tried = 0;
+                break;
+            }
+            depth--;
+            if (depth < msg_bits && !nodes[depth].tried) {
+                nodes[depth].tried = 1;
+                break;
+            }
+        }
+    }
+
+    // the input bit of each slice is the low bit of the register after it
+    memset(msg, 0, msg_bits / 8);
+    for (size_t i = 0; i < msg_bits; i++) {
+        msg[i / 8] |= (uint8_t)((nodes[i + 1].reg & 1) << (7 - i % 8));
+    }
+
+    return (ssize_t)(msg_bits / 8);
+}
+
+ssize_t correct_convolutional_sequential_decode(correct_convolutional_sequential *seq, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    if (num_encoded_bits > seq->soft_cap) {
+        soft_t *soft = (soft_t *)realloc(seq->soft, num_encoded_bits);
+        if (!soft) {
+            return -1;
+        }
+        seq->soft = soft;
+        seq->soft_cap = num_encoded_bits;
+    }
+
+    for (size_t i = 0; i < num_encoded_bits; i++) {
+        seq->soft[i] = ((encoded[i / 8] >> (7 - i % 8)) & 1) ? soft_max : 0;
+    }
+
+    return sequential_decode(seq, seq->soft, num_encoded_bits, (const int32_t (*)[256])seq->hard_metrics, msg);
+}
+
+ssize_t correct_convolutional_sequential_decode_soft(correct_convolutional_sequential *seq, const correct_convolutional_soft_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    return sequential_decode(seq, encoded, num_encoded_bits, (const int32_t (*)[256])seq->soft_metrics, msg);
+}
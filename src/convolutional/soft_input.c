@@ -0,0 +1,106 @@
+#include "correct/convolutional/soft_input.h"
+
+soft_input_t *soft_input_create(void) {
+    soft_input_t *in = (soft_input_t *)calloc(1, sizeof(soft_input_t));
+    if (!in) {
+        return NULL;
+    }
+
+    in->chunk = (soft_t *)malloc(soft_input_chunk_cap * sizeof(soft_t));
+    if (!in->chunk) {
+        free(in);
+        return NULL;
+    }
+
+    return in;
+}
+
+void soft_input_destroy(soft_input_t *in) {
+    if (!in) {
+        return;
+    }
+
+    free(in->chunk);
+    free(in);
+}
+
+void soft_input_begin(soft_input_t *in, soft_convert_t convert, const void *src, size_t symbol_bits, size_t len, float scale) {
+    in->convert = convert;
+    in->src = (const uint8_t *)src;
+    in->symbol_bits = symbol_bits;
+    in->align = 1;
+    while ((in->align * symbol_bits) % 8) {
+        in->align++;
+    }
+    in->len = len;
+    in->scale = scale;
+
+    in->chunk_start = 0;
+    in->chunk_len = 0;
+}
+
+void soft_input_end(soft_input_t *in) {
+    in->convert = NULL;
+    in->src = NULL;
+    in->chunk_len = 0;
+}
+
+// convert the chunk that holds offset
+// the decoders walk forward through the block, with a jump back to the start for each
+//   tail-biting pass, so the next chunk always starts at the slice that missed, or just
+//   before it if that slice doesn't start on a whole byte
+const soft_t *soft_input_fill(soft_input_t *in, size_t offset, size_t len) {
+    size_t chunk_start = offset - offset % in->align;
+    size_t chunk_len = in->len - chunk_start;
+    if (chunk_len > soft_input_chunk_cap) {
+        chunk_len = soft_input_chunk_cap;
+    }
+    assert(offset + len <= chunk_start + chunk_len);
+
+    in->convert(in->src + chunk_start * in->symbol_bits / 8, chunk_len, in->scale, in->chunk);
+    in->chunk_start = chunk_start;
+    in->chunk_len = chunk_len;
+
+    return in->chunk + (offset - chunk_start);
+}
+
+void soft_convert_s8(const void *src, size_t n, float scale, soft_t *dst) {
+    (void)scale;
+    const int8_t *s8 = (const int8_t *)src;
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = (soft_t)(s8[i] + 128);
+    }
+}
+
+void soft_convert_llr_f32(const void *src, size_t n, float scale, soft_t *dst) {
+    const float *llr = (const float *)src;
+    for (size_t i = 0; i < n; i++) {
+        // 0 lands on 128, the erasure. written so that a NaN also becomes 0
+        float v = 128.0f + llr[i] * scale;
+        dst[i] = (v >= 255.0f) ? 255 : (v > 0.0f) ? (soft_t)(v + 0.5f) : 0;
+    }
+}
+
+void soft_convert_u4(const void *src, size_t n, float scale, soft_t *dst) {
+    (void)scale;
+    const uint8_t *packed = (const uint8_t *)src;
+    for (size_t i = 0; i < n; i++) {
+        uint8_t nibble = (i % 2) ? (packed[i / 2] & 0x0f) : (packed[i / 2] >> 4);
+        dst[i] = soft_input_u4_levels[nibble];
+    }
+}
+
+void soft_convert_u3(const void *src, size_t n, float scale, soft_t *dst) {
+    (void)scale;
+    const uint8_t *packed = (const uint8_t *)src;
+    for (size_t i = 0; i < n; i++) {
+        // a symbol can straddle two bytes, so read it out of the 16 bits that start at its
+        //   first byte. the second byte is only read when the symbol reaches into it
+        size_t bit = 3 * i;
+        unsigned int window = (unsigned int)packed[bit / 8] << 8;
+        if (bit % 8 > 5) {
+            window |= packed[bit / 8 + 1];
+        }
+        dst[i] = soft_input_u3_levels[(window >> (13 - bit % 8)) & 7];
+    }
+}
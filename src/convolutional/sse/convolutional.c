@@ -5,9 +5,16 @@ correct_convolutional_sse *correct_convolutional_sse_create(size_t rate, size_t
     correct_convolutional *init_conv = _correct_convolutional_init(&conv->base_conv, rate, order, poly);
     if (!init_conv) {
         free(conv);
-        conv = NULL;
+        return NULL;
     }
 
+    // the sse traceback runs in groups of 100 * order, which makes it nearly free per bit,
+    //   while the sse register exchange still costs about half of the add-compare-select
+    //   every slice. it's slower at every order this decoder runs, so it's only used when
+    //   asked for
+    conv->base_conv.register_exchange_max_order = 0;
+    conv->team = NULL;
+
     return conv;
 }
 
@@ -16,6 +23,7 @@ void correct_convolutional_sse_destroy(correct_convolutional_sse *conv) {
         return;
     }
 
+    acs_team_destroy(conv->team);
     if (conv->base_conv.has_init_decode) {
         oct_lookup_destroy(conv->oct_lookup);
     }
@@ -23,3 +31,103 @@ void correct_convolutional_sse_destroy(correct_convolutional_sse *conv) {
 
     free(conv);
 }
+
+ssize_t correct_convolutional_sse_set_puncture(correct_convolutional_sse *conv, const correct_convolutional_puncture *puncture) {
+    if (!conv) {
+        return -1;
+    }
+
+    return correct_convolutional_set_puncture(&conv->base_conv, puncture);
+}
+
+ssize_t correct_convolutional_sse_set_tail_biting(correct_convolutional_sse *conv, int tail_biting, size_t passes) {
+    if (!conv) {
+        return -1;
+    }
+
+    return correct_convolutional_set_tail_biting(&conv->base_conv, tail_biting, passes);
+}
+
+ssize_t correct_convolutional_sse_set_traceback(correct_convolutional_sse *conv, size_t traceback_depth, size_t traceback_group_length) {
+    if (!conv) {
+        return -1;
+    }
+
+    // the sse decoder's traceback is the same, but it defaults to longer groups
+    correct_convolutional *base_conv = &conv->base_conv;
+    traceback_depth = traceback_depth ? traceback_depth : 5 * base_conv->order;
+    traceback_group_length = traceback_group_length ? traceback_group_length : 100 * base_conv->order;
+
+    return convolutional_decode_set_traceback(base_conv, traceback_depth, traceback_group_length) ? 0 : -1;
+}
+
+ssize_t correct_convolutional_sse_set_survivor_memory(correct_convolutional_sse *conv, int survivor_memory) {
+    if (!conv) {
+        return -1;
+    }
+
+    return correct_convolutional_set_survivor_memory(&conv->base_conv, survivor_memory);
+}
+
+ssize_t correct_convolutional_sse_set_soft_metric(correct_convolutional_sse *conv, int soft_metric) {
+    if (!conv) {
+        return -1;
+    }
+
+    return correct_convolutional_set_soft_metric(&conv->base_conv, soft_metric);
+}
+
+ssize_t correct_convolutional_sse_set_syndrome_check(correct_convolutional_sse *conv, int syndrome_check) {
+    if (!conv) {
+        return -1;
+    }
+
+    return correct_convolutional_set_syndrome_check(&conv->base_conv, syndrome_check);
+}
+
+ssize_t correct_convolutional_sse_set_m_algorithm(correct_convolutional_sse *conv, size_t max_paths) {
+    if (!conv) {
+        return -1;
+    }
+
+    return correct_convolutional_set_m_algorithm(&conv->base_conv, max_paths);
+}
+
+ssize_t correct_convolutional_sse_get_stats(const correct_convolutional_sse *conv, correct_convolutional_stats_t *stats) {
+    if (!conv) {
+        return -1;
+    }
+
+    return correct_convolutional_get_stats(&conv->base_conv, stats);
+}
+
+ssize_t correct_convolutional_sse_reset_stats(correct_convolutional_sse *conv) {
+    if (!conv) {
+        return -1;
+    }
+
+    return correct_convolutional_reset_stats(&conv->base_conv);
+}
+
+ssize_t correct_convolutional_sse_set_threads(correct_convolutional_sse *conv, size_t num_threads) {
+    if (!conv) {
+        return -1;
+    }
+
+    acs_team_destroy(conv->team);
+    conv->team = NULL;
+    if (num_threads < 2) {
+        return 0;
+    }
+
+    // more threads than the trellis has ranges for are left out
+    unsigned int num_states = 1u << (conv->base_conv.order - 1);
+    unsigned int max_threads = (num_states < 64) ? 1 : num_states / 64;
+    if (max_threads < 2) {
+        return 0;
+    }
+
+    unsigned int team_threads = (num_threads < max_threads) ? (unsigned int)num_threads : max_threads;
+    conv->team = acs_team_create(conv, team_threads, num_states);
+    return conv->team ? 0 : -1;
+}
@@ -1,8 +1,208 @@
 #include "correct/convolutional/sse/convolutional.h"
 
-static void convolutional_sse_decode_inner(correct_convolutional_sse *sse_conv, unsigned int sets, const uint8_t *soft) {
+// add-compare-select over the states from begin to end for one time slice, 32 states at
+//   a time, with oct_lookup already filled for the slice
+// the error metrics go to write_errors and one choice per state to history, 0 or 0xff
+void convolutional_sse_decode_acs_range(correct_convolutional_sse *sse_conv, uint8_t *history, shift_register_t begin, shift_register_t end) {
     correct_convolutional *conv = &sse_conv->base_conv;
     shift_register_t highbit = 1 << (conv->order - 1);
+    oct_lookup_t *oct_lookup = sse_conv->oct_lookup;
+
+    // high runs over the same range with the high order bit set
+    unsigned int num_iter = highbit + end;
+    const distance_t *read_errors = conv->errors->read_errors;
+    // aggregate bit errors for this time slice
+    distance_t *write_errors = conv->errors->write_errors;
+
+    // walk through all states, ignoring oldest bit
+    // we will track a best register state (path) and the number of bit
+    // errors at that path at this time slice
+    // this loop considers two paths per iteration (high order bit set,
+    // clear)
+    // so, it only runs numstates/2 iterations
+    // we'll update the history for every state and find the path with the
+    // least aggregated bit errors
+
+    // now run the main loop
+    // we calculate 2 sets of 2 register states here (4 states per iter)
+    // this creates 2 sets which share a predecessor, and 2 sets which share
+    // a successor
+    //
+    // the first set definition is the two states that are the same except
+    // for the least order bit
+    // these two share a predecessor because their high n - 1 bits are the
+    // same (differ only by newest bit)
+    //
+    // the second set definition is the two states that are the same except
+    // for the high order bit
+    // these two share a successor because the oldest high order bit will be
+    // shifted out, and the other bits will be present in the successor
+    //
+    shift_register_t highbase = highbit >> 1;
+    shift_register_t oct_highbase = highbase >> 2;
+    for (shift_register_t low = begin, high = highbit + begin, base = begin / 2, oct = begin / 8; high < num_iter;
+         low += 32, high += 32, base += 16, oct += 4) {
+        // shifted-right ancestors
+        // low and low_plus_one share low_past_error
+        //   note that they are the same when shifted right by 1
+        // same goes for high and high_plus_one
+        __m128i past_shuffle_mask = _mm_set_epi32(0x07060706, 0x05040504, 0x03020302, 0x01000100);
+        __m128i hist_mask = _mm_set_epi32(0x80808080, 0x80808080, 0x0e0c0a09, 0x07050301);
+
+        // the loop below calculates 64 register states per loop iteration
+        // it does this by packing the 128-bit xmm registers with 8, 16-bit
+        // distances
+        // 4 of these registers hold distances for convolutional shift
+        // register states with the high bit cleared
+        //      and 4 hold distances for the corresponding shift register
+        //      states with the high bit set
+        // since each xmm register holds 8 distances, this adds up to a
+        // total of 8 * 8 = 64 shift register states
+        for (shift_register_t offset = 0, base_offset = 0; base_offset < 16;
+             offset += 32, base_offset += 16) {
+            // load the past error for the register states with the high
+            // order bit cleared
+            __m128i low_past_error = _mm_loadl_epi64((const __m128i *)(read_errors + base + base_offset));
+            __m128i low_past_error0 = _mm_loadl_epi64((const __m128i *)(read_errors + base + base_offset + 4));
+            __m128i low_past_error1 = _mm_loadl_epi64((const __m128i *)(read_errors + base + base_offset + 8));
+            __m128i low_past_error2 = _mm_loadl_epi64((const __m128i *)(read_errors + base + base_offset + 12));
+
+            // shuffle the low past error
+            // register states that differ only by their low order bit share
+            // a past error
+            low_past_error = _mm_shuffle_epi8(low_past_error, past_shuffle_mask);
+            low_past_error0 = _mm_shuffle_epi8(low_past_error0, past_shuffle_mask);
+            low_past_error1 = _mm_shuffle_epi8(low_past_error1, past_shuffle_mask);
+            low_past_error2 = _mm_shuffle_epi8(low_past_error2, past_shuffle_mask);
+
+            // repeat past error lookup for register states with high order
+            // bit set
+            __m128i high_past_error = _mm_loadl_epi64((const __m128i *)(read_errors + highbase + base + base_offset));
+            __m128i high_past_error0 = _mm_loadl_epi64((const __m128i *)(read_errors + highbase + base + base_offset + 4));
+            __m128i high_past_error1 = _mm_loadl_epi64((const __m128i *)(read_errors + highbase + base + base_offset + 8));
+            __m128i high_past_error2 = _mm_loadl_epi64((const __m128i *)(read_errors + highbase + base + base_offset + 12));
+
+            high_past_error = _mm_shuffle_epi8(high_past_error, past_shuffle_mask);
+            high_past_error0 = _mm_shuffle_epi8(high_past_error0, past_shuffle_mask);
+            high_past_error1 = _mm_shuffle_epi8(high_past_error1, past_shuffle_mask);
+            high_past_error2 = _mm_shuffle_epi8(high_past_error2, past_shuffle_mask);
+
+            // __m128i this_shuffle_mask = (__m128i){0x80800100, 0x80800302,
+            // 0x80800504, 0x80800706};
+
+            // load the opaque oct distance table keys from out loop index
+            distance_oct_key_t low_key = oct_lookup->keys[oct + (base_offset / 4)];
+            distance_oct_key_t low_key0 = oct_lookup->keys[oct + (base_offset / 4) + 1];
+            distance_oct_key_t low_key1 = oct_lookup->keys[oct + (base_offset / 4) + 2];
+            distance_oct_key_t low_key2 = oct_lookup->keys[oct + (base_offset / 4) + 3];
+
+            // load the distances for the register states with high order
+            // bit cleared
+            __m128i low_this_error = _mm_load_si128((const __m128i *)(oct_lookup->distances + low_key));
+            __m128i low_this_error0 = _mm_load_si128((const __m128i *)(oct_lookup->distances + low_key0));
+            __m128i low_this_error1 = _mm_load_si128((const __m128i *)(oct_lookup->distances + low_key1));
+            __m128i low_this_error2 = _mm_load_si128((const __m128i *)(oct_lookup->distances + low_key2));
+
+            // add the distance for this time slice to the past distances
+            __m128i low_error = _mm_add_epi16(low_past_error, low_this_error);
+            __m128i low_error0 = _mm_add_epi16(low_past_error0, low_this_error0);
+            __m128i low_error1 = _mm_add_epi16(low_past_error1, low_this_error1);
+            __m128i low_error2 = _mm_add_epi16(low_past_error2, low_this_error2);
+
+            // repeat oct distance table lookup for registers with high
+            // order bit set
+            distance_oct_key_t high_key = oct_lookup->keys[oct_highbase + oct + (base_offset / 4)];
+            distance_oct_key_t high_key0 = oct_lookup->keys[oct_highbase + oct + (base_offset / 4) + 1];
+            distance_oct_key_t high_key1 = oct_lookup->keys[oct_highbase + oct + (base_offset / 4) + 2];
+            distance_oct_key_t high_key2 = oct_lookup->keys[oct_highbase + oct + (base_offset / 4) + 3];
+
+            __m128i high_this_error = _mm_load_si128((const __m128i *)(oct_lookup->distances + high_key));
+            __m128i high_this_error0 = _mm_load_si128((const __m128i *)(oct_lookup->distances + high_key0));
+            __m128i high_this_error1 = _mm_load_si128((const __m128i *)(oct_lookup->distances + high_key1));
+            __m128i high_this_error2 = _mm_load_si128((const __m128i *)(oct_lookup->distances + high_key2));
+
+            __m128i high_error = _mm_add_epi16(high_past_error, high_this_error);
+            __m128i high_error0 = _mm_add_epi16(high_past_error0, high_this_error0);
+            __m128i high_error1 = _mm_add_epi16(high_past_error1, high_this_error1);
+            __m128i high_error2 = _mm_add_epi16(high_past_error2, high_this_error2);
+
+            // distances for this time slice calculated
+
+            // find the least error between registers who differ only in
+            // their high order bit
+            __m128i min_error = _mm_min_epu16(low_error, high_error);
+            __m128i min_error0 = _mm_min_epu16(low_error0, high_error0);
+            __m128i min_error1 = _mm_min_epu16(low_error1, high_error1);
+            __m128i min_error2 = _mm_min_epu16(low_error2, high_error2);
+
+            _mm_store_si128((__m128i *)(write_errors + low + offset), min_error);
+            _mm_store_si128((__m128i *)(write_errors + low + offset + 8), min_error0);
+            _mm_store_si128((__m128i *)(write_errors + low + offset + 16), min_error1);
+            _mm_store_si128((__m128i *)(write_errors + low + offset + 24), min_error2);
+
+            // generate history bits as (low_error > least_error)
+            // this operation fills each element with all 1s if true and 0s
+            // if false
+            // in other words, we set the history bit to 1 if
+            //      the register state with high order bit set was the least
+            //      error
+            __m128i hist = _mm_cmpgt_epi16(low_error, min_error);
+            // pack the bits down from 16-bit wide to 8-bit wide to
+            // accomodate history table
+            hist = _mm_shuffle_epi8(hist, hist_mask);
+
+            __m128i hist0 = _mm_cmpgt_epi16(low_error0, min_error0);
+            hist0 = _mm_shuffle_epi8(hist0, hist_mask);
+
+            __m128i hist1 = _mm_cmpgt_epi16(low_error1, min_error1);
+            hist1 = _mm_shuffle_epi8(hist1, hist_mask);
+
+            __m128i hist2 = _mm_cmpgt_epi16(low_error2, min_error2);
+            hist2 = _mm_shuffle_epi8(hist2, hist_mask);
+
+            // write the least error so that the next time slice sees it as
+            // the past error
+            // store the history bits set by cmp and shuffle operations
+            _mm_storel_epi64((__m128i *)(history + low + offset), hist);
+            _mm_storel_epi64((__m128i *)(history + low + offset + 8), hist0);
+            _mm_storel_epi64((__m128i *)(history + low + offset + 16), hist1);
+            _mm_storel_epi64((__m128i *)(history + low + offset + 24), hist2);
+        }
+    }
+}
+
+// add-compare-select over every state for one time slice, split across the team if
+//   there is one
+static inline void convolutional_sse_decode_acs(correct_convolutional_sse *sse_conv, uint8_t *history) {
+    correct_convolutional *conv = &sse_conv->base_conv;
+    uint64_t start = profile_now();
+    oct_lookup_fill_distance(sse_conv->oct_lookup, conv->distances);
+    profile_add(PROFILE_CONV_FILL, start);
+
+    start = profile_now();
+    if (sse_conv->team) {
+        acs_team_run(sse_conv->team, history);
+    } else {
+        convolutional_sse_decode_acs_range(sse_conv, history, 0, 1u << (conv->order - 1));
+    }
+    profile_add(PROFILE_CONV_ACS, start);
+}
+
+// the team spins through the slices of a block and sleeps between blocks
+static inline void convolutional_sse_team_begin(correct_convolutional_sse *sse_conv) {
+    if (sse_conv->team) {
+        acs_team_begin(sse_conv->team);
+    }
+}
+
+static inline void convolutional_sse_team_end(correct_convolutional_sse *sse_conv) {
+    if (sse_conv->team) {
+        acs_team_end(sse_conv->team);
+    }
+}
+
+static void convolutional_sse_decode_inner(correct_convolutional_sse *sse_conv, unsigned int sets, const uint8_t *soft) {
+    correct_convolutional *conv = &sse_conv->base_conv;
     unsigned int hist_buf_index = conv->history_buffer->index;
     unsigned int hist_buf_cap = conv->history_buffer->cap;
     unsigned int hist_buf_len = conv->history_buffer->len;
@@ -10,191 +210,12 @@ static void convolutional_sse_decode_inner(correct_convolutional_sse *sse_conv,
     unsigned int hist_buf_rn_cnt = conv->history_buffer->renormalize_counter;
 
     for (unsigned int i = (unsigned int)conv->order - 1; i < (sets - conv->order + 1); i++) {
-        distance_t *distances = conv->distances;
         // lasterrors are the aggregate bit errors for the states of
         // shiftregister for the previous time slice
-        if (soft) {
-            if (conv->soft_measurement == CORRECT_SOFT_LINEAR) {
-                for (unsigned int j = 0; j < (unsigned int)(1 << (conv->rate)); j++) {
-                    distances[j] = metric_soft_distance_linear(j, soft + i * conv->rate, conv->rate);
-                }
-            } else {
-                for (unsigned int j = 0; j < (unsigned int)(1 << (conv->rate)); j++) {
-                    distances[j] = metric_soft_distance_quadratic(j, soft + i * conv->rate, conv->rate);
-                }
-            }
-        } else {
-            unsigned int out = bit_reader_read(conv->bit_reader, conv->rate);
-            for (i = 0; i < (unsigned int)(1 << conv->rate); i++) {
-                distances[i] = metric_distance(i, out);
-            }
-        }
-        oct_lookup_t *oct_lookup = sse_conv->oct_lookup;
-        oct_lookup_fill_distance(oct_lookup, distances);
-
-        // a mask to get the high order bit from the shift register
-        unsigned int num_iter = highbit << 1;
-        const distance_t *read_errors = conv->errors->read_errors;
-        // aggregate bit errors for this time slice
-        distance_t *write_errors = conv->errors->write_errors;
-
+        convolutional_decode_distances(conv, soft, i);
         uint8_t *history = conv->history_buffer->history[hist_buf_index];
-
-        // walk through all states, ignoring oldest bit
-        // we will track a best register state (path) and the number of bit
-        // errors at that path at this time slice
-        // this loop considers two paths per iteration (high order bit set,
-        // clear)
-        // so, it only runs numstates/2 iterations
-        // we'll update the history for every state and find the path with the
-        // least aggregated bit errors
-
-        // now run the main loop
-        // we calculate 2 sets of 2 register states here (4 states per iter)
-        // this creates 2 sets which share a predecessor, and 2 sets which share
-        // a successor
-        //
-        // the first set definition is the two states that are the same except
-        // for the least order bit
-        // these two share a predecessor because their high n - 1 bits are the
-        // same (differ only by newest bit)
-        //
-        // the second set definition is the two states that are the same except
-        // for the high order bit
-        // these two share a successor because the oldest high order bit will be
-        // shifted out, and the other bits will be present in the successor
-        //
-        shift_register_t highbase = highbit >> 1;
-        shift_register_t oct_highbase = highbase >> 2;
-        for (shift_register_t low = 0, high = highbit, base = 0, oct = 0; high < num_iter;
-             low += 32, high += 32, base += 16, oct += 4) {
-            // shifted-right ancestors
-            // low and low_plus_one share low_past_error
-            //   note that they are the same when shifted right by 1
-            // same goes for high and high_plus_one
-            __m128i past_shuffle_mask = _mm_set_epi32(0x07060706, 0x05040504, 0x03020302, 0x01000100);
-            __m128i hist_mask = _mm_set_epi32(0x80808080, 0x80808080, 0x0e0c0a09, 0x07050301);
-
-            // the loop below calculates 64 register states per loop iteration
-            // it does this by packing the 128-bit xmm registers with 8, 16-bit
-            // distances
-            // 4 of these registers hold distances for convolutional shift
-            // register states with the high bit cleared
-            //      and 4 hold distances for the corresponding shift register
-            //      states with the high bit set
-            // since each xmm register holds 8 distances, this adds up to a
-            // total of 8 * 8 = 64 shift register states
-            for (shift_register_t offset = 0, base_offset = 0; base_offset < 16;
-                 offset += 32, base_offset += 16) {
-                // load the past error for the register states with the high
-                // order bit cleared
-                __m128i low_past_error = _mm_loadl_epi64((const __m128i *)(read_errors + base + base_offset));
-                __m128i low_past_error0 = _mm_loadl_epi64((const __m128i *)(read_errors + base + base_offset + 4));
-                __m128i low_past_error1 = _mm_loadl_epi64((const __m128i *)(read_errors + base + base_offset + 8));
-                __m128i low_past_error2 = _mm_loadl_epi64((const __m128i *)(read_errors + base + base_offset + 12));
-
-                // shuffle the low past error
-                // register states that differ only by their low order bit share
-                // a past error
-                low_past_error = _mm_shuffle_epi8(low_past_error, past_shuffle_mask);
-                low_past_error0 = _mm_shuffle_epi8(low_past_error0, past_shuffle_mask);
-                low_past_error1 = _mm_shuffle_epi8(low_past_error1, past_shuffle_mask);
-                low_past_error2 = _mm_shuffle_epi8(low_past_error2, past_shuffle_mask);
-
-                // repeat past error lookup for register states with high order
-                // bit set
-                __m128i high_past_error = _mm_loadl_epi64((const __m128i *)(read_errors + highbase + base + base_offset));
-                __m128i high_past_error0 = _mm_loadl_epi64((const __m128i *)(read_errors + highbase + base + base_offset + 4));
-                __m128i high_past_error1 = _mm_loadl_epi64((const __m128i *)(read_errors + highbase + base + base_offset + 8));
-                __m128i high_past_error2 = _mm_loadl_epi64((const __m128i *)(read_errors + highbase + base + base_offset + 12));
-
-                high_past_error = _mm_shuffle_epi8(high_past_error, past_shuffle_mask);
-                high_past_error0 = _mm_shuffle_epi8(high_past_error0, past_shuffle_mask);
-                high_past_error1 = _mm_shuffle_epi8(high_past_error1, past_shuffle_mask);
-                high_past_error2 = _mm_shuffle_epi8(high_past_error2, past_shuffle_mask);
-
-                // __m128i this_shuffle_mask = (__m128i){0x80800100, 0x80800302,
-                // 0x80800504, 0x80800706};
-
-                // load the opaque oct distance table keys from out loop index
-                distance_oct_key_t low_key = oct_lookup->keys[oct + (base_offset / 4)];
-                distance_oct_key_t low_key0 = oct_lookup->keys[oct + (base_offset / 4) + 1];
-                distance_oct_key_t low_key1 = oct_lookup->keys[oct + (base_offset / 4) + 2];
-                distance_oct_key_t low_key2 = oct_lookup->keys[oct + (base_offset / 4) + 3];
-
-                // load the distances for the register states with high order
-                // bit cleared
-                __m128i low_this_error = _mm_load_si128((const __m128i *)(oct_lookup->distances + low_key));
-                __m128i low_this_error0 = _mm_load_si128((const __m128i *)(oct_lookup->distances + low_key0));
-                __m128i low_this_error1 = _mm_load_si128((const __m128i *)(oct_lookup->distances + low_key1));
-                __m128i low_this_error2 = _mm_load_si128((const __m128i *)(oct_lookup->distances + low_key2));
-
-                // add the distance for this time slice to the past distances
-                __m128i low_error = _mm_add_epi16(low_past_error, low_this_error);
-                __m128i low_error0 = _mm_add_epi16(low_past_error0, low_this_error0);
-                __m128i low_error1 = _mm_add_epi16(low_past_error1, low_this_error1);
-                __m128i low_error2 = _mm_add_epi16(low_past_error2, low_this_error2);
-
-                // repeat oct distance table lookup for registers with high
-                // order bit set
-                distance_oct_key_t high_key = oct_lookup->keys[oct_highbase + oct + (base_offset / 4)];
-                distance_oct_key_t high_key0 = oct_lookup->keys[oct_highbase + oct + (base_offset / 4) + 1];
-                distance_oct_key_t high_key1 = oct_lookup->keys[oct_highbase + oct + (base_offset / 4) + 2];
-                distance_oct_key_t high_key2 = oct_lookup->keys[oct_highbase + oct + (base_offset / 4) + 3];
-
-                __m128i high_this_error = _mm_load_si128((const __m128i *)(oct_lookup->distances + high_key));
-                __m128i high_this_error0 = _mm_load_si128((const __m128i *)(oct_lookup->distances + high_key0));
-                __m128i high_this_error1 = _mm_load_si128((const __m128i *)(oct_lookup->distances + high_key1));
-                __m128i high_this_error2 = _mm_load_si128((const __m128i *)(oct_lookup->distances + high_key2));
-
-                __m128i high_error = _mm_add_epi16(high_past_error, high_this_error);
-                __m128i high_error0 = _mm_add_epi16(high_past_error0, high_this_error0);
-                __m128i high_error1 = _mm_add_epi16(high_past_error1, high_this_error1);
-                __m128i high_error2 = _mm_add_epi16(high_past_error2, high_this_error2);
-
-                // distances for this time slice calculated
-
-                // find the least error between registers who differ only in
-                // their high order bit
-                __m128i min_error = _mm_min_epu16(low_error, high_error);
-                __m128i min_error0 = _mm_min_epu16(low_error0, high_error0);
-                __m128i min_error1 = _mm_min_epu16(low_error1, high_error1);
-                __m128i min_error2 = _mm_min_epu16(low_error2, high_error2);
-
-                _mm_store_si128((__m128i *)(write_errors + low + offset), min_error);
-                _mm_store_si128((__m128i *)(write_errors + low + offset + 8), min_error0);
-                _mm_store_si128((__m128i *)(write_errors + low + offset + 16), min_error1);
-                _mm_store_si128((__m128i *)(write_errors + low + offset + 24), min_error2);
-
-                // generate history bits as (low_error > least_error)
-                // this operation fills each element with all 1s if true and 0s
-                // if false
-                // in other words, we set the history bit to 1 if
-                //      the register state with high order bit set was the least
-                //      error
-                __m128i hist = _mm_cmpgt_epi16(low_error, min_error);
-                // pack the bits down from 16-bit wide to 8-bit wide to
-                // accomodate history table
-                hist = _mm_shuffle_epi8(hist, hist_mask);
-
-                __m128i hist0 = _mm_cmpgt_epi16(low_error0, min_error0);
-                hist0 = _mm_shuffle_epi8(hist0, hist_mask);
-
-                __m128i hist1 = _mm_cmpgt_epi16(low_error1, min_error1);
-                hist1 = _mm_shuffle_epi8(hist1, hist_mask);
-
-                __m128i hist2 = _mm_cmpgt_epi16(low_error2, min_error2);
-                hist2 = _mm_shuffle_epi8(hist2, hist_mask);
-
-                // write the least error so that the next time slice sees it as
-                // the past error
-                // store the history bits set by cmp and shuffle operations
-                _mm_storel_epi64((__m128i *)(history + low + offset), hist);
-                _mm_storel_epi64((__m128i *)(history + low + offset + 8), hist0);
-                _mm_storel_epi64((__m128i *)(history + low + offset + 16), hist1);
-                _mm_storel_epi64((__m128i *)(history + low + offset + 24), hist2);
-            }
-        }
+        convolutional_sse_decode_acs(sse_conv, history);
+        distance_t *write_errors = conv->errors->write_errors;
 
         // bypass the call to history buffer
         // we should really make that function inline and remove this below
@@ -226,6 +247,52 @@ static void convolutional_sse_decode_inner(correct_convolutional_sse *sse_conv,
     conv->history_buffer->renormalize_counter = hist_buf_rn_cnt;
 }
 
+// move every register along one time slice, four states at a time
+// states 2 * base and 2 * base + 1 pick between the same two predecessors, base and
+//   highbase + base. the decisions are 0 or 0xff, so each one widens into a blend mask
+//   and, subtracted, sets the new low bit
+static inline void convolutional_sse_register_exchange_update(register_exchange *reg) {
+    const uint8_t *decisions = reg->decisions;
+    const path_t *registers = reg->registers;
+    path_t *next_registers = reg->next_registers;
+    shift_register_t highbase = reg->num_states >> 1;
+    // gathers the decisions of the even states into the low two bytes, odd into the next two
+    __m128i split_mask = _mm_set_epi32(0x80808080, 0x80808080, 0x80808080, 0x03010200);
+
+    for (shift_register_t base = 0; base < highbase; base += 2) {
+        __m128i low = _mm_loadu_si128((const __m128i *)(registers + base));
+        __m128i high = _mm_loadu_si128((const __m128i *)(registers + highbase + base));
+
+        int32_t packed_decisions;
+        memcpy(&packed_decisions, decisions + 2 * base, sizeof(packed_decisions));
+        __m128i decision = _mm_shuffle_epi8(_mm_cvtsi32_si128(packed_decisions), split_mask);
+        __m128i even_mask = _mm_cvtepi8_epi64(decision);
+        __m128i odd_mask = _mm_cvtepi8_epi64(_mm_srli_si128(decision, 2));
+
+        __m128i even = _mm_sub_epi64(_mm_slli_epi64(_mm_blendv_epi8(low, high, even_mask), 1), even_mask);
+        __m128i odd = _mm_sub_epi64(_mm_slli_epi64(_mm_blendv_epi8(low, high, odd_mask), 1), odd_mask);
+
+        _mm_storeu_si128((__m128i *)(next_registers + 2 * base), _mm_unpacklo_epi64(even, odd));
+        _mm_storeu_si128((__m128i *)(next_registers + 2 * base + 2), _mm_unpackhi_epi64(even, odd));
+    }
+
+    register_exchange_swap(reg);
+}
+
+static void convolutional_sse_decode_inner_register_exchange(correct_convolutional_sse *sse_conv, unsigned int sets, const uint8_t *soft) {
+    correct_convolutional *conv = &sse_conv->base_conv;
+    register_exchange *reg = conv->register_exchange;
+    for (unsigned int i = (unsigned int)conv->order - 1; i < (sets - conv->order + 1); i++) {
+        convolutional_decode_distances(conv, soft, i);
+        convolutional_sse_decode_acs(sse_conv, reg->decisions);
+        convolutional_sse_register_exchange_update(reg);
+
+        distance_t *write_errors = conv->errors->write_errors;
+        register_exchange_output_skip(reg, write_errors, conv->bit_writer, 1);
+        error_buffer_swap(conv->errors);
+    }
+}
+
 static bool _convolutional_sse_decode_init(correct_convolutional_sse *conv, unsigned int min_traceback, unsigned int traceback_length, unsigned int renormalize_interval) {
     if (!_convolutional_decode_init(&conv->base_conv, min_traceback, traceback_length, renormalize_interval)) {
         return false;
@@ -240,57 +307,362 @@ static bool _convolutional_sse_decode_init(correct_convolutional_sse *conv, unsi
     return true;
 }
 
-static ssize_t _convolutional_sse_decode(correct_convolutional_sse *sse_conv, size_t num_encoded_bits, size_t num_encoded_bytes, uint8_t *msg, const soft_t *soft_encoded) {
+static bool _convolutional_sse_decode_lazy_init(correct_convolutional_sse *sse_conv) {
     correct_convolutional *conv = &sse_conv->base_conv;
-    if (!conv->has_init_decode) {
-        uint64_t max_error_per_input = conv->rate * soft_max;
-        // sse implementation unfortunately uses signed math on our unsigned values
-        // reduces usable distance by /2
-        unsigned int renormalize_interval = (distance_max / 2) / (unsigned int)max_error_per_input;
-        if(!_convolutional_sse_decode_init(sse_conv, (unsigned int)(5 * conv->order), (unsigned int)(100 * conv->order), renormalize_interval)) {
-            return -1;
-        }
+    if (conv->has_init_decode) {
+        return true;
+    }
+
+    uint64_t max_error_per_input = conv->rate * soft_max;
+    // sse implementation unfortunately uses signed math on our unsigned values
+    // reduces usable distance by /2
+    unsigned int renormalize_interval = (distance_max / 2) / (unsigned int)max_error_per_input;
+    unsigned int traceback_depth = conv->traceback_depth ? conv->traceback_depth : (unsigned int)(5 * conv->order);
+    unsigned int traceback_group_length = conv->traceback_group_length ? conv->traceback_group_length : (unsigned int)(100 * conv->order);
+    return _convolutional_sse_decode_init(sse_conv, traceback_depth, traceback_group_length, renormalize_interval);
+}
+
+static ssize_t convolutional_sse_decode_block(correct_convolutional_sse *sse_conv, size_t sets, size_t num_encoded_bytes, uint8_t *msg, const soft_t *soft_encoded) {
+    correct_convolutional *conv = &sse_conv->base_conv;
+    if (!_convolutional_sse_decode_lazy_init(sse_conv)) {
+        return -1;
     }
 
-    size_t sets = num_encoded_bits / conv->rate;
     // XXX fix this vvvvvv
     size_t decoded_len_bytes = num_encoded_bytes;
     bit_writer_reconfigure(conv->bit_writer, msg, decoded_len_bytes);
+    decoder_stats_begin_block(&conv->stats, sets);
+
+    // the m-algorithm has no sse version, so this is the portable one
+    if (conv->m_algorithm_paths && !conv->tail_biting) {
+        if (!convolutional_decode_m_algorithm(conv, sets, soft_encoded)) {
+            return -1;
+        }
+        return bit_writer_length(conv->bit_writer);
+    }
 
     error_buffer_reset(conv->errors);
-    history_buffer_reset(conv->history_buffer);
+    convolutional_decode_survivors_reset(conv);
 
     // no outputs are generated during warmup
     convolutional_decode_warmup(conv, (unsigned int)sets, soft_encoded);
-    convolutional_sse_decode_inner(sse_conv, (unsigned int)sets, soft_encoded);
+    convolutional_sse_team_begin(sse_conv);
+    if (conv->register_exchange) {
+        convolutional_sse_decode_inner_register_exchange(sse_conv, (unsigned int)sets, soft_encoded);
+    } else {
+        convolutional_sse_decode_inner(sse_conv, (unsigned int)sets, soft_encoded);
+    }
+    convolutional_sse_team_end(sse_conv);
     convolutional_decode_tail(conv, (unsigned int)sets, soft_encoded);
 
-    history_buffer_flush(conv->history_buffer, conv->bit_writer);
+    convolutional_decode_survivors_flush(conv);
 
     return bit_writer_length(conv->bit_writer);
 }
 
+
+// whole-frame decoding, as in cv_decode.c, with the sse add-compare-select
+bool convolutional_sse_decode_frame_init(correct_convolutional_sse *conv, size_t max_sets) {
+    if (!_convolutional_sse_decode_lazy_init(conv)) {
+        return false;
+    }
+
+    return convolutional_decode_frame_init(&conv->base_conv, max_sets);
+}
+
+size_t convolutional_sse_decode_frame_update(correct_convolutional_sse *sse_conv, const soft_t *soft, size_t sets) {
+    correct_convolutional *conv = &sse_conv->base_conv;
+    if (sets > conv->frame_cap - conv->frame_len) {
+        sets = conv->frame_cap - conv->frame_len;
+    }
+
+    for (size_t i = 0; i < sets; i++) {
+        uint8_t *decisions = conv->frame_history + conv->frame_len * conv->frame_slice_bytes;
+        convolutional_sse_decode_frame_step(sse_conv, soft, i, decisions);
+    }
+
+    return sets;
+}
+
+void convolutional_sse_decode_frame_step(correct_convolutional_sse *sse_conv, const soft_t *soft, size_t set, uint8_t *decisions) {
+    correct_convolutional *conv = &sse_conv->base_conv;
+    convolutional_decode_distances(conv, soft, set);
+    convolutional_sse_decode_acs(sse_conv, conv->frame_slice);
+
+    // the choices are 0 or 0xff, so their sign bits pack straight down to one bit per state
+    unsigned int num_states = conv->numstates / 2;
+    for (shift_register_t state = 0; state < num_states; state += 16) {
+        __m128i choices = _mm_load_si128((const __m128i *)(conv->frame_slice + state));
+        int packed = _mm_movemask_epi8(choices);
+        decisions[state / 8] = (uint8_t)packed;
+        decisions[state / 8 + 1] = (uint8_t)(packed >> 8);
+    }
+
+    convolutional_decode_frame_advance(conv);
+}
+
+// tail-biting decoding, as in cv_decode.c, with the sse add-compare-select
+static ssize_t _convolutional_sse_decode_tail_biting(correct_convolutional_sse *sse_conv, size_t sets, uint8_t *msg, const soft_t *soft_encoded) {
+    correct_convolutional *conv = &sse_conv->base_conv;
+    if (!_convolutional_sse_decode_lazy_init(sse_conv) || !convolutional_decode_tail_biting_init(conv, sets)) {
+        return -1;
+    }
+    decoder_stats_begin_block(&conv->stats, 0);
+
+    convolutional_sse_team_begin(sse_conv);
+    for (size_t pass = 0; pass <= conv->tail_biting_passes; pass++) {
+        conv->frame_len = 0;
+        convolutional_decode_tail_biting_rewind(conv);
+        convolutional_sse_decode_frame_update(sse_conv, soft_encoded, sets);
+    }
+
+    convolutional_decode_tail_biting_rewind(conv);
+    convolutional_sse_decode_frame_update(sse_conv, soft_encoded, convolutional_decode_tail_biting_depth(conv, sets));
+    convolutional_sse_team_end(sse_conv);
+
+    return convolutional_decode_tail_biting_traceback(conv, sets, msg);
+}
+
+// every frame from the public decode functions, between the probes, as in cv_decode.c
+static ssize_t _convolutional_sse_decode(correct_convolutional_sse *sse_conv, size_t sets, size_t num_encoded_bytes, uint8_t *msg, const uint8_t *encoded, const soft_t *soft_encoded) {
+    correct_convolutional *conv = &sse_conv->base_conv;
+    CORRECT_PROBE2(conv_sse_decode_begin, sse_conv, sets);
+    int64_t path_metric = 0;
+    ssize_t decoded_len = convolutional_decode_syndrome(conv, encoded, soft_encoded, sets, msg);
+    if (decoded_len < 0) {
+        if (conv->tail_biting) {
+            decoded_len = _convolutional_sse_decode_tail_biting(sse_conv, sets, msg, soft_encoded);
+            path_metric = -1;
+        } else {
+            decoded_len = convolutional_sse_decode_block(sse_conv, sets, num_encoded_bytes, msg, soft_encoded);
+            path_metric = (int64_t)decoder_stats_path_metric(&conv->stats);
+        }
+    }
+    CORRECT_PROBE4(conv_sse_decode_end, sse_conv, sets, decoded_len, (decoded_len < 0) ? 0 : path_metric);
+    return decoded_len;
+}
+
+// low-delay streaming, as in cv_decode.c, with the sse add-compare-select
+static ssize_t _convolutional_sse_stream_decode(correct_convolutional_sse *sse_conv, size_t sets, uint8_t *msg, const soft_t *soft_encoded) {
+    correct_convolutional *conv = &sse_conv->base_conv;
+    bit_writer_reconfigure(conv->bit_writer, msg, (sets + 7) / 8);
+
+    size_t num_decoded_bits = 0;
+    convolutional_sse_team_begin(sse_conv);
+    for (size_t i = 0; i < sets; i++) {
+        convolutional_sse_decode_frame_step(sse_conv, soft_encoded, i, convolutional_decode_stream_slot(conv));
+        num_decoded_bits += convolutional_decode_stream_output(conv);
+    }
+    convolutional_sse_team_end(sse_conv);
+
+    bit_writer_flush_byte(conv->bit_writer);
+
+    return (ssize_t)num_decoded_bits;
+}
+
+ssize_t correct_convolutional_sse_stream_begin(correct_convolutional_sse *conv, size_t delay) {
+    if (!conv || !_convolutional_sse_decode_lazy_init(conv) || !convolutional_decode_stream_begin(&conv->base_conv, delay)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+ssize_t correct_convolutional_sse_stream_decode(correct_convolutional_sse *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    size_t sets;
+    if (!conv->base_conv.streaming || !convolutional_decode_sets(&conv->base_conv, num_encoded_bits, &sets)) {
+        return -1;
+    }
+
+    size_t num_encoded_bytes = (num_encoded_bits % 8) ? (num_encoded_bits / 8 + 1) : (num_encoded_bits / 8);
+    bit_reader_reconfigure(conv->base_conv.bit_reader, encoded, num_encoded_bytes);
+
+    return _convolutional_sse_stream_decode(conv, sets, msg, NULL);
+}
+
+ssize_t correct_convolutional_sse_stream_decode_soft(correct_convolutional_sse *conv, const soft_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    size_t sets;
+    if (!conv->base_conv.streaming || !convolutional_decode_sets(&conv->base_conv, num_encoded_bits, &sets)) {
+        return -1;
+    }
+
+    return _convolutional_sse_stream_decode(conv, sets, msg, encoded);
+}
+
+ssize_t correct_convolutional_sse_stream_end(correct_convolutional_sse *conv, uint8_t *msg) {
+    return correct_convolutional_stream_end(&conv->base_conv, msg);
+}
+
 ssize_t correct_convolutional_sse_decode(correct_convolutional_sse *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
-    if (num_encoded_bits % conv->base_conv.rate) {
+    size_t sets;
+    if (!convolutional_decode_sets(&conv->base_conv, num_encoded_bits, &sets)) {
         // XXX turn this into an error code
-        // printf("encoded length of message must be a multiple of rate\n");
+        // printf("encoded length of message must end on a whole time slice\n");
         return -1;
     }
 
     size_t num_encoded_bytes = (num_encoded_bits % 8) ? (num_encoded_bits / 8 + 1) : (num_encoded_bits / 8);
     bit_reader_reconfigure(conv->base_conv.bit_reader, encoded, num_encoded_bytes);
 
-    return _convolutional_sse_decode(conv, num_encoded_bits, num_encoded_bytes, msg, NULL);
+    return _convolutional_sse_decode(conv, sets, num_encoded_bytes, msg, encoded, NULL);
 }
 
 ssize_t correct_convolutional_sse_decode_soft(correct_convolutional_sse *conv, const soft_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
-    if (num_encoded_bits % conv->base_conv.rate) {
+    size_t sets;
+    if (!convolutional_decode_sets(&conv->base_conv, num_encoded_bits, &sets)) {
         // XXX turn this into an error code
-        // printf("encoded length of message must be a multiple of rate\n");
+        // printf("encoded length of message must end on a whole time slice\n");
         return -1;
     }
 
     size_t num_encoded_bytes = (num_encoded_bits % 8) ? (num_encoded_bits / 8 + 1) : (num_encoded_bits / 8);
 
-    return _convolutional_sse_decode(conv, num_encoded_bits, num_encoded_bytes, msg, encoded);
+    return _convolutional_sse_decode(conv, sets, num_encoded_bytes, msg, NULL, encoded);
+}
+
+// crc-checked decoding, as in cv_decode.c
+ssize_t correct_convolutional_sse_decode_crc(correct_convolutional_sse *conv, const uint8_t *encoded, size_t num_encoded_bits, const correct_crc *crc, uint8_t *msg) {
+    correct_convolutional *base_conv = &conv->base_conv;
+    size_t sets;
+    size_t msg_len;
+    if (!convolutional_decode_sets(base_conv, num_encoded_bits, &sets) || !convolutional_decode_crc_begin(base_conv, crc, sets, &msg_len)) {
+        return -1;
+    }
+
+    ssize_t decoded_len = correct_convolutional_sse_decode(conv, encoded, num_encoded_bits, msg);
+    return convolutional_decode_crc_end(base_conv, crc, decoded_len, msg, msg_len);
+}
+
+ssize_t correct_convolutional_sse_decode_soft_crc(correct_convolutional_sse *conv, const soft_t *encoded, size_t num_encoded_bits, const correct_crc *crc, uint8_t *msg) {
+    correct_convolutional *base_conv = &conv->base_conv;
+    size_t sets;
+    size_t msg_len;
+    if (!convolutional_decode_sets(base_conv, num_encoded_bits, &sets) || !convolutional_decode_crc_begin(base_conv, crc, sets, &msg_len)) {
+        return -1;
+    }
+
+    ssize_t decoded_len = correct_convolutional_sse_decode_soft(conv, encoded, num_encoded_bits, msg);
+    return convolutional_decode_crc_end(base_conv, crc, decoded_len, msg, msg_len);
+}
+
+// soft_convert_s8 and soft_convert_llr_f32, 16 symbols at a time
+static void convolutional_sse_soft_convert_s8(const void *src, size_t n, float scale, soft_t *dst) {
+    const int8_t *s8 = (const int8_t *)src;
+    __m128i flip = _mm_set1_epi8((char)0x80);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s8 + i));
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(v, flip));
+    }
+    soft_convert_s8(s8 + i, n - i, scale, dst + i);
+}
+
+static void convolutional_sse_soft_convert_llr_f32(const void *src, size_t n, float scale, soft_t *dst) {
+    const float *llr = (const float *)src;
+    __m128 scale_v = _mm_set1_ps(scale);
+    __m128 erasure = _mm_set1_ps(128.0f);
+    __m128 zero = _mm_setzero_ps();
+    __m128 top = _mm_set1_ps(255.0f);
+    __m128 half = _mm_set1_ps(0.5f);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i quad[4];
+        for (unsigned int j = 0; j < 4; j++) {
+            __m128 v = _mm_add_ps(erasure, _mm_mul_ps(_mm_loadu_ps(llr + i + 4 * j), scale_v));
+            // clamp before truncating, with max first so that a NaN becomes 0, and round
+            //   half up as the portable conversion does
+            v = _mm_min_ps(_mm_max_ps(v, zero), top);
+            quad[j] = _mm_cvttps_epi32(_mm_add_ps(v, half));
+        }
+        __m128i words = _mm_packs_epi32(quad[0], quad[1]);
+        __m128i words0 = _mm_packs_epi32(quad[2], quad[3]);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(words, words0));
+    }
+    soft_convert_llr_f32(llr + i, n - i, scale, dst + i);
+}
+
+// soft_convert_u4, 16 symbols from 8 bytes at a time
+// the nibbles are split apart, interleaved back into symbol order and then looked up in
+//   soft_input_u4_levels with a byte shuffle
+static void convolutional_sse_soft_convert_u4(const void *src, size_t n, float scale, soft_t *dst) {
+    const uint8_t *packed = (const uint8_t *)src;
+    __m128i levels = _mm_loadu_si128((const __m128i *)soft_input_u4_levels);
+    __m128i low_nibbles = _mm_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i bytes = _mm_loadl_epi64((const __m128i *)(packed + i / 2));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibbles);
+        __m128i low = _mm_and_si128(bytes, low_nibbles);
+        __m128i symbols = _mm_unpacklo_epi8(high, low);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_shuffle_epi8(levels, symbols));
+    }
+    soft_convert_u4(packed + i / 2, n - i, scale, dst + i);
+}
+
+// soft_convert_u3, 16 symbols from 6 bytes at a time
+// each 16 bit lane gets the two bytes that hold its symbol, most significant first, and a
+//   multiply shifts the symbol up to the top of the lane, since sse has no per-lane shift.
+//   the symbols then go through soft_input_u3_levels as in the 4-bit conversion
+static void convolutional_sse_soft_convert_u3(const void *src, size_t n, float scale, soft_t *dst) {
+    const uint8_t *packed = (const uint8_t *)src;
+    __m128i levels = _mm_loadl_epi64((const __m128i *)soft_input_u3_levels);
+    // symbol k starts at bit 3k, in byte 3k / 8, and is bit 3k % 8 of its window
+    // the second eight symbols are laid out as the first, three bytes on
+    __m128i windows = _mm_set_epi8(2, 3, 2, 3, 1, 2, 1, 2, 1, 2, 0, 1, 0, 1, 0, 1);
+    __m128i windows0 = _mm_set_epi8(5, 6, 5, 6, 4, 5, 4, 5, 4, 5, 3, 4, 3, 4, 3, 4);
+    __m128i shifts = _mm_set_epi16(1 << 5, 1 << 2, 1 << 7, 1 << 4, 1 << 1, 1 << 6, 1 << 3, 1 << 0);
+    size_t i = 0;
+    // each step reads 8 bytes, 2 past the 6 it converts
+    for (; i + 24 <= n; i += 16) {
+        __m128i bytes = _mm_loadl_epi64((const __m128i *)(packed + 3 * i / 8));
+        __m128i symbols = _mm_srli_epi16(_mm_mullo_epi16(_mm_shuffle_epi8(bytes, windows), shifts), 13);
+        __m128i symbols0 = _mm_srli_epi16(_mm_mullo_epi16(_mm_shuffle_epi8(bytes, windows0), shifts), 13);
+        __m128i packed_symbols = _mm_packus_epi16(symbols, symbols0);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_shuffle_epi8(levels, packed_symbols));
+    }
+    soft_convert_u3(packed + 3 * i / 8, n - i, scale, dst + i);
+}
+
+ssize_t correct_convolutional_sse_decode_soft_s8(correct_convolutional_sse *conv, const int8_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    correct_convolutional *base_conv = &conv->base_conv;
+    if (!convolutional_decode_soft_input_begin(base_conv, convolutional_sse_soft_convert_s8, encoded, 8 * sizeof(int8_t), num_encoded_bits, 0.0f)) {
+        return -1;
+    }
+
+    ssize_t res = correct_convolutional_sse_decode_soft(conv, (const soft_t *)encoded, num_encoded_bits, msg);
+    soft_input_end(base_conv->soft_input);
+    return res;
+}
+
+ssize_t correct_convolutional_sse_decode_soft_llr_f32(correct_convolutional_sse *conv, const float *encoded, size_t num_encoded_bits, float scale, uint8_t *msg) {
+    correct_convolutional *base_conv = &conv->base_conv;
+    if (!convolutional_decode_soft_input_begin(base_conv, convolutional_sse_soft_convert_llr_f32, encoded, 8 * sizeof(float), num_encoded_bits, scale)) {
+        return -1;
+    }
+
+    ssize_t res = correct_convolutional_sse_decode_soft(conv, (const soft_t *)encoded, num_encoded_bits, msg);
+    soft_input_end(base_conv->soft_input);
+    return res;
+}
+
+ssize_t correct_convolutional_sse_decode_soft_u4(correct_convolutional_sse *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    correct_convolutional *base_conv = &conv->base_conv;
+    if (!convolutional_decode_soft_input_begin(base_conv, convolutional_sse_soft_convert_u4, encoded, 4, num_encoded_bits, 0.0f)) {
+        return -1;
+    }
+
+    ssize_t res = correct_convolutional_sse_decode_soft(conv, (const soft_t *)encoded, num_encoded_bits, msg);
+    soft_input_end(base_conv->soft_input);
+    return res;
+}
+
+ssize_t correct_convolutional_sse_decode_soft_u3(correct_convolutional_sse *conv, const uint8_t *encoded, size_t num_encoded_bits, uint8_t *msg) {
+    correct_convolutional *base_conv = &conv->base_conv;
+    if (!convolutional_decode_soft_input_begin(base_conv, convolutional_sse_soft_convert_u3, encoded, 3, num_encoded_bits, 0.0f)) {
+        return -1;
+    }
+
+    ssize_t res = correct_convolutional_sse_decode_soft(conv, (const soft_t *)encoded, num_encoded_bits, msg);
+    soft_input_end(base_conv->soft_input);
+    return res;
 }
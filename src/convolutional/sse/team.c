@@ -0,0 +1,255 @@
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "correct/convolutional/sse/convolutional.h"
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#include <sched.h>
+
+// the add-compare-select runs 32 states at a time, writing 32 bytes of history. two of
+//   those fill a cache line, so the ranges split on 64 states and no two threads write
+//   the same line
+static const unsigned int acs_team_grain = 64;
+
+typedef struct {
+    acs_team_t *team;
+    unsigned int id;
+} acs_team_member_t;
+
+struct acs_team {
+    correct_convolutional_sse *conv;
+    unsigned int num_threads;       // including the caller
+    unsigned int *bounds;           // thread t runs states bounds[t] to bounds[t + 1]
+
+    pthread_t *threads;
+    unsigned int num_started;
+    acs_team_member_t *members;
+
+    // the slice in progress. the caller bumps step once history is set, and each
+    //   worker bumps done when its range is written
+    uint8_t *history;
+    unsigned int step;
+    unsigned int done;
+
+    // workers spin while running and sleep on wake otherwise
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool running;
+    bool shutdown;
+};
+
+// a slice of a large trellis takes a few microseconds, so waiting for one is a spin.
+//   an occasional yield keeps a team with more threads than cores from starving
+static inline void acs_team_pause(unsigned int spins) {
+    if (spins % 256 == 255) {
+        sched_yield();
+    } else {
+        _mm_pause();
+    }
+}
+
+static void *acs_team_worker(void *arg) {
+    acs_team_member_t *member = (acs_team_member_t *)arg;
+    acs_team_t *team = member->team;
+    unsigned int begin = team->bounds[member->id];
+    unsigned int end = team->bounds[member->id + 1];
+    // the team is made before its first slice, so every worker starts from step 0
+    unsigned int seen = 0;
+
+    for (;;) {
+        unsigned int step;
+        for (unsigned int spins = 0; (step = __atomic_load_n(&team->step, __ATOMIC_ACQUIRE)) == seen; spins++) {
+            if (!__atomic_load_n(&team->running, __ATOMIC_ACQUIRE)) {
+                pthread_mutex_lock(&team->lock);
+                while (!team->running && !team->shutdown) {
+                    pthread_cond_wait(&team->wake, &team->lock);
+                }
+                bool shutdown = team->shutdown;
+                pthread_mutex_unlock(&team->lock);
+                if (shutdown) {
+                    return NULL;
+                }
+                spins = 0;
+                continue;
+            }
+            acs_team_pause(spins);
+        }
+
+        seen = step;
+        convolutional_sse_decode_acs_range(team->conv, team->history, begin, end);
+        __atomic_fetch_add(&team->done, 1, __ATOMIC_RELEASE);
+    }
+}
+
+// pin worker id to the id-th cpu after the one the caller is on, out of those the caller
+//   may run on. the caller itself is left where it is
+static void acs_team_pin(acs_team_t *team, unsigned int id) {
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed) || CPU_COUNT(&allowed) < 2) {
+        return;
+    }
+
+    int cpus[CPU_SETSIZE];
+    int num_cpus = 0;
+    int current = 0;
+    int caller_cpu = sched_getcpu();
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            current = (cpu == caller_cpu) ? num_cpus : current;
+            cpus[num_cpus++] = cpu;
+        }
+    }
+
+    cpu_set_t pinned;
+    CPU_ZERO(&pinned);
+    CPU_SET(cpus[(current + id) % num_cpus], &pinned);
+    pthread_setaffinity_np(team->threads[id - 1], sizeof(pinned), &pinned);
+#else
+    (void)team;
+    (void)id;
+#endif
+}
+
+acs_team_t *acs_team_create(correct_convolutional_sse *conv, unsigned int num_threads, unsigned int num_states) {
+    // every thread gets at least one run of the add-compare-select
+    unsigned int num_grains = (num_states + acs_team_grain - 1) / acs_team_grain;
+    if (num_threads > num_grains) {
+        num_threads = num_grains;
+    }
+    if (num_threads < 2) {
+        return NULL;
+    }
+
+    acs_team_t *team = (acs_team_t *)calloc(1, sizeof(acs_team_t));
+    if (!team) {
+        return NULL;
+    }
+
+    team->conv = conv;
+    team->num_threads = num_threads;
+    team->bounds = (unsigned int *)malloc((num_threads + 1) * sizeof(unsigned int));
+    team->threads = (pthread_t *)malloc((num_threads - 1) * sizeof(pthread_t));
+    team->members = (acs_team_member_t *)malloc((num_threads - 1) * sizeof(acs_team_member_t));
+    if (!team->bounds || !team->threads || !team->members) {
+        free(team->bounds);
+        free(team->threads);
+        free(team->members);
+        free(team);
+        return NULL;
+    }
+
+    for (unsigned int t = 0; t <= num_threads; t++) {
+        team->bounds[t] = (unsigned int)(((uint64_t)num_grains * t / num_threads) * acs_team_grain);
+    }
+
+    if (pthread_mutex_init(&team->lock, NULL)) {
+        free(team->bounds);
+        free(team->threads);
+        free(team->members);
+        free(team);
+        return NULL;
+    }
+    if (pthread_cond_init(&team->wake, NULL)) {
+        pthread_mutex_destroy(&team->lock);
+        free(team->bounds);
+        free(team->threads);
+        free(team->members);
+        free(team);
+        return NULL;
+    }
+
+    for (unsigned int id = 1; id < num_threads; id++) {
+        team->members[id - 1].team = team;
+        team->members[id - 1].id = id;
+        if (pthread_create(&team->threads[id - 1], NULL, acs_team_worker, &team->members[id - 1])) {
+            acs_team_destroy(team);
+            return NULL;
+        }
+        team->num_started++;
+        acs_team_pin(team, id);
+    }
+
+    return team;
+}
+
+void acs_team_destroy(acs_team_t *team) {
+    if (!team) {
+        return;
+    }
+
+    pthread_mutex_lock(&team->lock);
+    team->shutdown = true;
+    __atomic_store_n(&team->running, false, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&team->wake);
+    pthread_mutex_unlock(&team->lock);
+
+    for (unsigned int i = 0; i < team->num_started; i++) {
+        pthread_join(team->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&team->wake);
+    pthread_mutex_destroy(&team->lock);
+    free(team->bounds);
+    free(team->threads);
+    free(team->members);
+    free(team);
+}
+
+void acs_team_begin(acs_team_t *team) {
+    pthread_mutex_lock(&team->lock);
+    __atomic_store_n(&team->running, true, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&team->wake);
+    pthread_mutex_unlock(&team->lock);
+}
+
+void acs_team_end(acs_team_t *team) {
+    pthread_mutex_lock(&team->lock);
+    __atomic_store_n(&team->running, false, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&team->lock);
+}
+
+void acs_team_run(acs_team_t *team, uint8_t *history) {
+    if (!__atomic_load_n(&team->running, __ATOMIC_RELAXED)) {
+        convolutional_sse_decode_acs_range(team->conv, history, 0, team->bounds[team->num_threads]);
+        return;
+    }
+
+    unsigned int num_workers = team->num_threads - 1;
+    team->history = history;
+    __atomic_store_n(&team->done, 0, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&team->step, 1, __ATOMIC_RELEASE);
+
+    convolutional_sse_decode_acs_range(team->conv, history, team->bounds[0], team->bounds[1]);
+
+    for (unsigned int spins = 0; __atomic_load_n(&team->done, __ATOMIC_ACQUIRE) != num_workers; spins++) {
+        acs_team_pause(spins);
+    }
+}
+#else
+acs_team_t *acs_team_create(correct_convolutional_sse *conv, unsigned int num_threads, unsigned int num_states) {
+    (void)conv;
+    (void)num_threads;
+    (void)num_states;
+    return NULL;
+}
+
+void acs_team_destroy(acs_team_t *team) {
+    (void)team;
+}
+
+void acs_team_begin(acs_team_t *team) {
+    (void)team;
+}
+
+void acs_team_end(acs_team_t *team) {
+    (void)team;
+}
+
+void acs_team_run(acs_team_t *team, uint8_t *history) {
+    (void)team;
+    (void)history;
+}
+#endif
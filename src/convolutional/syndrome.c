@@ -0,0 +1,296 @@
+#include "correct/convolutional/syndrome.h"
+
+// polynomials over GF(2), bit j holding the coefficient of D^j
+
+static int syndrome_poly_degree(uint32_t p) {
+    int degree = -1;
+    while (p) {
+        degree++;
+        p >>= 1;
+    }
+    return degree;
+}
+
+static uint32_t syndrome_poly_mul(uint32_t x, uint32_t y) {
+    uint32_t product = 0;
+    for (unsigned int j = 0; y >> j; j++) {
+        if ((y >> j) & 1) {
+            product ^= x << j;
+        }
+    }
+    return product;
+}
+
+// extended euclid: returns gcd(x, y) and sets a, b so that a x + b y = gcd(x, y)
+static uint32_t syndrome_poly_gcd(uint32_t x, uint32_t y, uint32_t *a, uint32_t *b) {
+    uint32_t r0 = x, r1 = y;
+    uint32_t s0 = 1, s1 = 0;
+    uint32_t t0 = 0, t1 = 1;
+    while (r1) {
+        uint32_t quotient = 0;
+        uint32_t remainder = r0;
+        int divisor_degree = syndrome_poly_degree(r1);
+        for (int degree = syndrome_poly_degree(remainder); degree >= divisor_degree; degree = syndrome_poly_degree(remainder)) {
+            quotient |= 1u << (degree - divisor_degree);
+            remainder ^= r1 << (degree - divisor_degree);
+        }
+
+        uint32_t next_s = s0 ^ syndrome_poly_mul(quotient, s1);
+        uint32_t next_t = t0 ^ syndrome_poly_mul(quotient, t1);
+        r0 = r1;
+        r1 = remainder;
+        s0 = s1;
+        s1 = next_s;
+        t0 = t1;
+        t1 = next_t;
+    }
+
+    *a = s0;
+    *b = t0;
+    return r0;
+}
+
+static unsigned int syndrome_poly_taps(uint32_t p, unsigned int *taps) {
+    unsigned int num_taps = 0;
+    for (unsigned int j = 0; p >> j; j++) {
+        if ((p >> j) & 1) {
+            taps[num_taps++] = j;
+        }
+    }
+    return num_taps;
+}
+
+syndrome_check_t *syndrome_check_create(unsigned int rate, unsigned int order, const unsigned int *table) {
+    syndrome_check_t *check = (syndrome_check_t *)calloc(1, sizeof(syndrome_check_t));
+    if (!check) {
+        return NULL;
+    }
+
+    check->rate = rate;
+    check->order = order;
+
+    // bits 0, 2, 4, 6 of the byte to the low nibble and bits 1, 3, 5, 7 to the high,
+    //   both with the first bit sent, the most significant, lowest
+    for (unsigned int byte = 0; byte < 256; byte++) {
+        uint8_t nibbles = 0;
+        for (unsigned int j = 0; j < 4; j++) {
+            nibbles |= (uint8_t)(((byte >> (7 - 2 * j)) & 1) << j);
+            nibbles |= (uint8_t)(((byte >> (6 - 2 * j)) & 1) << (4 + j));
+        }
+        check->unzip[byte] = nibbles;
+    }
+    check->num_taps = (unsigned int *)malloc(rate * sizeof(unsigned int));
+    check->taps = (unsigned int *)malloc(rate * order * sizeof(unsigned int));
+    uint32_t *generators = (uint32_t *)calloc(rate, sizeof(uint32_t));
+    if (!check->num_taps || !check->taps || !generators) {
+        free(generators);
+        syndrome_check_destroy(check);
+        return NULL;
+    }
+
+    // table holds every generator's output for each shift register, and the register
+    //   with just bit j set picks out each generator's coefficient of D^j
+    for (unsigned int j = 0; j < order; j++) {
+        unsigned int out = table[1u << j];
+        for (unsigned int k = 0; k < rate; k++) {
+            generators[k] |= ((out >> k) & 1u) << j;
+        }
+    }
+
+    for (unsigned int k = 0; k < rate; k++) {
+        check->num_taps[k] = syndrome_poly_taps(generators[k], check->taps + k * order);
+    }
+
+    // any pair of generators with no common factor gives an inverse
+    bool found = false;
+    for (unsigned int i = 0; i < rate && !found; i++) {
+        for (unsigned int j = i + 1; j < rate && !found; j++) {
+            uint32_t a, b;
+            if (generators[i] && generators[j] && syndrome_poly_gcd(generators[i], generators[j], &a, &b) == 1) {
+                check->inverse_i = i;
+                check->inverse_j = j;
+                check->num_a_taps = syndrome_poly_taps(a, check->a_taps);
+                check->num_b_taps = syndrome_poly_taps(b, check->b_taps);
+                found = true;
+            }
+        }
+    }
+
+    free(generators);
+    if (!found) {
+        syndrome_check_destroy(check);
+        return NULL;
+    }
+
+    return check;
+}
+
+void syndrome_check_destroy(syndrome_check_t *check) {
+    if (!check) {
+        return;
+    }
+
+    free(check->num_taps);
+    free(check->taps);
+    free(check->streams);
+    free(check);
+}
+
+// clear the streams for a block of sets time slices, with room for the products to run
+//   order slices past its end
+bool syndrome_check_reset(syndrome_check_t *check, size_t sets) {
+    size_t words = (sets + check->order) / 64 + 1;
+    if (words > check->words_cap) {
+        uint64_t *streams = (uint64_t *)realloc(check->streams, check->rate * words * sizeof(uint64_t));
+        if (!streams) {
+            return false;
+        }
+        check->streams = streams;
+        check->words_cap = words;
+    }
+
+    check->words = words;
+    for (unsigned int k = 0; k < check->rate; k++) {
+        memset(check->streams + k * check->words_cap, 0, words * sizeof(uint64_t));
+    }
+    return true;
+}
+
+void syndrome_check_load_hard(syndrome_check_t *check, const uint8_t *encoded, size_t sets) {
+    unsigned int rate = check->rate;
+    size_t words_cap = check->words_cap;
+    uint64_t *streams = check->streams;
+
+    if (rate == 2) {
+        // each byte holds 4 time slices, which unzip splits into a nibble per stream
+        const uint8_t *unzip = check->unzip;
+        size_t whole_words = sets / 64;
+        for (size_t w = 0; w < whole_words; w++) {
+            uint64_t r0 = 0, r1 = 0;
+            for (unsigned int j = 0; j < 16; j++) {
+                uint8_t nibbles = unzip[encoded[16 * w + j]];
+                r0 |= (uint64_t)(nibbles & 0xf) << (4 * j);
+                r1 |= (uint64_t)(nibbles >> 4) << (4 * j);
+            }
+            streams[w] = r0;
+            streams[words_cap + w] = r1;
+        }
+        sets -= 64 * whole_words;
+        encoded += 16 * whole_words;
+        streams += whole_words;
+    }
+
+    // the rest a bit at a time
+    size_t bit = 0;
+    for (size_t set = 0; set < sets; set++) {
+        for (unsigned int k = 0; k < rate; k++, bit++) {
+            uint64_t b = (encoded[bit / 8] >> (7 - bit % 8)) & 1;
+            streams[k * words_cap + set / 64] |= b << (set % 64);
+        }
+    }
+}
+
+// slice the len soft symbols that start at symbol offset of the encoded stream, both
+//   whole time slices
+// an erased symbol has no hard decision, so this returns false if it finds one
+bool syndrome_check_load_soft(syndrome_check_t *check, const soft_t *soft, size_t offset, size_t len) {
+    bool erased = false;
+    for (size_t i = 0; i < len; i++) {
+        erased |= (soft[i] == 128);
+    }
+    if (erased) {
+        return false;
+    }
+
+    unsigned int rate = check->rate;
+    size_t words_cap = check->words_cap;
+    uint64_t *streams = check->streams;
+
+    size_t set = offset / rate;
+    size_t end = set + len / rate;
+    while (set < end) {
+        size_t w = set / 64;
+        size_t stop = (end < 64 * (w + 1)) ? end : 64 * (w + 1);
+        for (unsigned int k = 0; k < rate; k++) {
+            const soft_t *symbols = soft + k;
+            uint64_t r = 0;
+            for (size_t s = set; s < stop; s++, symbols += rate) {
+                r |= (uint64_t)(*symbols >> 7) << (s % 64);
+            }
+            streams[k * words_cap + w] |= r;
+        }
+        soft += (stop - set) * rate;
+        set = stop;
+    }
+
+    return true;
+}
+
+// word w of the product of src and the polynomial with the given taps
+static inline uint64_t syndrome_mul_word(const uint64_t *src, size_t w, const unsigned int *taps, unsigned int num_taps) {
+    uint64_t cur = src[w];
+    uint64_t prev = w ? src[w - 1] : 0;
+    uint64_t product = 0;
+    for (unsigned int n = 0; n < num_taps; n++) {
+        unsigned int shift = taps[n];
+        product ^= shift ? ((cur << shift) | (prev >> (64 - shift))) : cur;
+    }
+    return product;
+}
+
+// check the loaded block and, if it is a codeword with a zero tail, write its message
+//   to msg. returns the length of the message in bytes, or -1 if the block needs the
+//   viterbi decoder
+ssize_t syndrome_check_decode(syndrome_check_t *check, size_t sets, uint8_t *msg) {
+    size_t tail = check->order + 1;
+    if (sets <= tail || (sets - tail) % 8) {
+        return -1;
+    }
+    size_t msg_bits = sets - tail;
+
+    size_t words = check->words;
+    size_t words_cap = check->words_cap;
+    unsigned int order = check->order;
+    unsigned int i = check->inverse_i;
+    const uint64_t *ri = check->streams + i * words_cap;
+
+    for (unsigned int k = 0; k < check->rate; k++) {
+        if (k == i) {
+            continue;
+        }
+
+        const uint64_t *rk = check->streams + k * words_cap;
+        for (size_t w = 0; w < words; w++) {
+            uint64_t syndrome = syndrome_mul_word(ri, w, check->taps + k * order, check->num_taps[k]) ^
+                                syndrome_mul_word(rk, w, check->taps + i * order, check->num_taps[i]);
+            if (syndrome) {
+                return -1;
+            }
+        }
+    }
+
+    const uint64_t *rj = check->streams + check->inverse_j * words_cap;
+    for (size_t w = 0; w < words; w++) {
+        uint64_t u = syndrome_mul_word(ri, w, check->a_taps, check->num_a_taps) ^
+                     syndrome_mul_word(rj, w, check->b_taps, check->num_b_taps);
+
+        size_t start = 64 * w;
+        if (start + 64 > msg_bits) {
+            // nothing may follow the message
+            uint64_t tail_mask = (start >= msg_bits) ? ~0ULL : ~((1ULL << (msg_bits - start)) - 1);
+            if (u & tail_mask) {
+                return -1;
+            }
+        }
+
+        // msg holds the earliest time slice in the most significant bit of each byte, so
+        //   each byte is reversed, with the 64-bit multiply from bit twiddling hacks
+        for (size_t m = 0; m < 8 && start + 8 * m < msg_bits; m++) {
+            uint8_t b = (uint8_t)(u >> (8 * m));
+            b = (uint8_t)(((b * 0x80200802ULL) & 0x0884422110ULL) * 0x0101010101ULL >> 32);
+            msg[start / 8 + m] = b;
+        }
+    }
+
+    return (ssize_t)(msg_bits / 8);
+}
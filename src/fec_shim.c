@@ -1,14 +1,24 @@
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
 
 #include "fec_shim.h"
 
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#ifdef HAVE_SSE
+#include "correct/convolutional/sse/convolutional.h"
+#else
+#include "correct/convolutional/convolutional.h"
+#endif
+
 typedef struct {
     correct_reed_solomon *rs;
     unsigned int msg_length;
     unsigned int block_length;
     unsigned int num_roots;
-    uint8_t *msg_out;
     unsigned int pad;
     uint8_t *erasures;
 } reed_solomon_shim;
@@ -24,10 +34,6 @@ void free_rs_char(void *rs) {
         correct_reed_solomon_destroy(shim->rs);
     }
 
-    if (shim->msg_out) {
-        free(shim->msg_out);
-    }
-
     if (shim->erasures) {
         free(shim->erasures);
     }
@@ -40,7 +46,7 @@ void *init_rs_char(int symbol_size, int primitive_polynomial, int first_consecut
         return NULL;
     }
 
-    reed_solomon_shim *shim = (reed_solomon_shim *)malloc(sizeof(reed_solomon_shim));
+    reed_solomon_shim *shim = (reed_solomon_shim *)calloc(1, sizeof(reed_solomon_shim));
     if (!shim) {
         return NULL;
     }
@@ -55,14 +61,8 @@ void *init_rs_char(int symbol_size, int primitive_polynomial, int first_consecut
         return NULL;        
     }
 
-    shim->msg_out = (uint8_t *)malloc(shim->block_length);
-    if (!shim->msg_out) {
-        free_rs_char(shim);
-        return NULL; 
-    }
-
     shim->erasures = (uint8_t *)malloc((size_t)number_roots);
-    if (!shim->msg_out) {
+    if (!shim->erasures) {
         free_rs_char(shim);
         return NULL; 
     }
@@ -72,8 +72,11 @@ void *init_rs_char(int symbol_size, int primitive_polynomial, int first_consecut
 
 void encode_rs_char(void *rs, const unsigned char *msg, unsigned char *parity) {
     reed_solomon_shim *shim = (reed_solomon_shim *)rs;
-    correct_reed_solomon_encode(shim->rs, msg, shim->msg_length, shim->msg_out);
-    memcpy(parity, shim->msg_out + shim->msg_length, shim->num_roots);
+
+    // the incremental encoder writes parity straight to the caller
+    correct_reed_solomon_encode_begin(shim->rs);
+    correct_reed_solomon_encode_update(shim->rs, msg, shim->msg_length);
+    correct_reed_solomon_encode_final(shim->rs, parity);
 }
 
 int decode_rs_char(void *rs, unsigned char *block, int *erasure_locations, int num_erasures) {
@@ -86,228 +89,524 @@ int decode_rs_char(void *rs, unsigned char *block, int *erasure_locations, int n
     return (int)correct_reed_solomon_decode_with_erasures(shim->rs, block, shim->block_length, shim->erasures, (size_t)num_erasures, block);
 }
 
-typedef struct {
-    correct_convolutional *conv;
-    unsigned int rate;
-    unsigned int order;
-    uint8_t *buf;
-    size_t buf_len;
-    uint8_t *read_iter;
-    uint8_t *write_iter;
-} convolutional_shim;
+// libfec's fixed-parameter functions all use the CCSDS (255, 223) code
+// _8 takes symbols in the conventional basis, _ccsds in Berlekamp's dual basis
+#define CCSDS_RS_NUM_ROOTS 32
+#define CCSDS_RS_MSG_LENGTH (255 - CCSDS_RS_NUM_ROOTS)
+
+// the change of basis is linear, so it's the bits of a symbol times the matrix with rows
+//   0x8d 0xef 0xec 0x86 0xfa 0x99 0xaf 0x7b. these are the same as libfec's Taltab and Tal1tab
+static const uint8_t ccsds_to_dual[256] = {
+    0x00, 0x7b, 0xaf, 0xd4, 0x99, 0xe2, 0x36, 0x4d, 0xfa, 0x81, 0x55, 0x2e, 0x63, 0x18, 0xcc, 0xb7,
+    0x86, 0xfd, 0x29, 0x52, 0x1f, 0x64, 0xb0, 0xcb, 0x7c, 0x07, 0xd3, 0xa8, 0xe5, 0x9e, 0x4a, 0x31,
+    0xec, 0x97, 0x43, 0x38, 0x75, 0x0e, 0xda, 0xa1, 0x16, 0x6d, 0xb9, 0xc2, 0x8f, 0xf4, 0x20, 0x5b,
+    0x6a, 0x11, 0xc5, 0xbe, 0xf3, 0x88, 0x5c, 0x27, 0x90, 0xeb, 0x3f, 0x44, 0x09, 0x72, 0xa6, 0xdd,
+    0xef, 0x94, 0x40, 0x3b, 0x76, 0x0d, 0xd9, 0xa2, 0x15, 0x6e, 0xba, 0xc1, 0x8c, 0xf7, 0x23, 0x58,
+    0x69, 0x12, 0xc6, 0xbd, 0xf0, 0x8b, 0x5f, 0x24, 0x93, 0xe8, 0x3c, 0x47, 0x0a, 0x71, 0xa5, 0xde,
+    0x03, 0x78, 0xac, 0xd7, 0x9a, 0xe1, 0x35, 0x4e, 0xf9, 0x82, 0x56, 0x2d, 0x60, 0x1b, 0xcf, 0xb4,
+    0x85, 0xfe, 0x2a, 0x51, 0x1c, 0x67, 0xb3, 0xc8, 0x7f, 0x04, 0xd0, 0xab, 0xe6, 0x9d, 0x49, 0x32,
+    0x8d, 0xf6, 0x22, 0x59, 0x14, 0x6f, 0xbb, 0xc0, 0x77, 0x0c, 0xd8, 0xa3, 0xee, 0x95, 0x41, 0x3a,
+    0x0b, 0x70, 0xa4, 0xdf, 0x92, 0xe9, 0x3d, 0x46, 0xf1, 0x8a, 0x5e, 0x25, 0x68, 0x13, 0xc7, 0xbc,
+    0x61, 0x1a, 0xce, 0xb5, 0xf8, 0x83, 0x57, 0x2c, 0x9b, 0xe0, 0x34, 0x4f, 0x02, 0x79, 0xad, 0xd6,
+    0xe7, 0x9c, 0x48, 0x33, 0x7e, 0x05, 0xd1, 0xaa, 0x1d, 0x66, 0xb2, 0xc9, 0x84, 0xff, 0x2b, 0x50,
+    0x62, 0x19, 0xcd, 0xb6, 0xfb, 0x80, 0x54, 0x2f, 0x98, 0xe3, 0x37, 0x4c, 0x01, 0x7a, 0xae, 0xd5,
+    0xe4, 0x9f, 0x4b, 0x30, 0x7d, 0x06, 0xd2, 0xa9, 0x1e, 0x65, 0xb1, 0xca, 0x87, 0xfc, 0x28, 0x53,
+    0x8e, 0xf5, 0x21, 0x5a, 0x17, 0x6c, 0xb8, 0xc3, 0x74, 0x0f, 0xdb, 0xa0, 0xed, 0x96, 0x42, 0x39,
+    0x08, 0x73, 0xa7, 0xdc, 0x91, 0xea, 0x3e, 0x45, 0xf2, 0x89, 0x5d, 0x26, 0x6b, 0x10, 0xc4, 0xbf,
+};
+
+static const uint8_t ccsds_from_dual[256] = {
+    0x00, 0xcc, 0xac, 0x60, 0x79, 0xb5, 0xd5, 0x19, 0xf0, 0x3c, 0x5c, 0x90, 0x89, 0x45, 0x25, 0xe9,
+    0xfd, 0x31, 0x51, 0x9d, 0x84, 0x48, 0x28, 0xe4, 0x0d, 0xc1, 0xa1, 0x6d, 0x74, 0xb8, 0xd8, 0x14,
+    0x2e, 0xe2, 0x82, 0x4e, 0x57, 0x9b, 0xfb, 0x37, 0xde, 0x12, 0x72, 0xbe, 0xa7, 0x6b, 0x0b, 0xc7,
+    0xd3, 0x1f, 0x7f, 0xb3, 0xaa, 0x66, 0x06, 0xca, 0x23, 0xef, 0x8f, 0x43, 0x5a, 0x96, 0xf6, 0x3a,
+    0x42, 0x8e, 0xee, 0x22, 0x3b, 0xf7, 0x97, 0x5b, 0xb2, 0x7e, 0x1e, 0xd2, 0xcb, 0x07, 0x67, 0xab,
+    0xbf, 0x73, 0x13, 0xdf, 0xc6, 0x0a, 0x6a, 0xa6, 0x4f, 0x83, 0xe3, 0x2f, 0x36, 0xfa, 0x9a, 0x56,
+    0x6c, 0xa0, 0xc0, 0x0c, 0x15, 0xd9, 0xb9, 0x75, 0x9c, 0x50, 0x30, 0xfc, 0xe5, 0x29, 0x49, 0x85,
+    0x91, 0x5d, 0x3d, 0xf1, 0xe8, 0x24, 0x44, 0x88, 0x61, 0xad, 0xcd, 0x01, 0x18, 0xd4, 0xb4, 0x78,
+    0xc5, 0x09, 0x69, 0xa5, 0xbc, 0x70, 0x10, 0xdc, 0x35, 0xf9, 0x99, 0x55, 0x4c, 0x80, 0xe0, 0x2c,
+    0x38, 0xf4, 0x94, 0x58, 0x41, 0x8d, 0xed, 0x21, 0xc8, 0x04, 0x64, 0xa8, 0xb1, 0x7d, 0x1d, 0xd1,
+    0xeb, 0x27, 0x47, 0x8b, 0x92, 0x5e, 0x3e, 0xf2, 0x1b, 0xd7, 0xb7, 0x7b, 0x62, 0xae, 0xce, 0x02,
+    0x16, 0xda, 0xba, 0x76, 0x6f, 0xa3, 0xc3, 0x0f, 0xe6, 0x2a, 0x4a, 0x86, 0x9f, 0x53, 0x33, 0xff,
+    0x87, 0x4b, 0x2b, 0xe7, 0xfe, 0x32, 0x52, 0x9e, 0x77, 0xbb, 0xdb, 0x17, 0x0e, 0xc2, 0xa2, 0x6e,
+    0x7a, 0xb6, 0xd6, 0x1a, 0x03, 0xcf, 0xaf, 0x63, 0x8a, 0x46, 0x26, 0xea, 0xf3, 0x3f, 0x5f, 0x93,
+    0xa9, 0x65, 0x05, 0xc9, 0xd0, 0x1c, 0x7c, 0xb0, 0x59, 0x95, 0xf5, 0x39, 0x20, 0xec, 0x8c, 0x40,
+    0x54, 0x98, 0xf8, 0x34, 0x2d, 0xe1, 0x81, 0x4d, 0xa4, 0x68, 0x08, 0xc4, 0xdd, 0x11, 0x71, 0xbd,
+};
+
+// libfec's fixed-parameter functions are reentrant, but a correct_reed_solomon holds its
+//   encoder's LFSR and its decoder's scratch. so each thread gets its own, created on its
+//   first call and destroyed when it exits
+#ifdef HAVE_PTHREAD
+static pthread_once_t ccsds_once = PTHREAD_ONCE_INIT;
+static pthread_key_t ccsds_key;
+static bool ccsds_has_key;
+
+static void ccsds_reed_solomon_destroy(void *rs) {
+    correct_reed_solomon_destroy((correct_reed_solomon *)rs);
+}
 
-static correct_convolutional_polynomial_t r12k7[] = {V27POLYA, V27POLYB};
+static void ccsds_reed_solomon_init(void) {
+    ccsds_has_key = pthread_key_create(&ccsds_key, ccsds_reed_solomon_destroy) == 0;
+}
 
-static correct_convolutional_polynomial_t r12k9[] = {V29POLYA, V29POLYB};
+static correct_reed_solomon *ccsds_reed_solomon(void) {
+    pthread_once(&ccsds_once, ccsds_reed_solomon_init);
+    if (!ccsds_has_key) {
+        return NULL;
+    }
 
-static correct_convolutional_polynomial_t r13k9[] = {V39POLYA, V39POLYB,
-                                                     V39POLYC};
+    correct_reed_solomon *rs = (correct_reed_solomon *)pthread_getspecific(ccsds_key);
+    if (rs) {
+        return rs;
+    }
 
-static correct_convolutional_polynomial_t r16k15[] = {
-    V615POLYA, V615POLYB, V615POLYC, V615POLYD, V615POLYE, V615POLYF};
+    rs = correct_reed_solomon_create(correct_rs_primitive_polynomial_ccsds, 112, 11, CCSDS_RS_NUM_ROOTS);
+    if (!rs) {
+        return NULL;
+    }
 
-/* Common methods */
-static void delete_viterbi(void *vit) {
-    convolutional_shim *shim = (convolutional_shim *)vit;
+    if (pthread_setspecific(ccsds_key, rs) != 0) {
+        correct_reed_solomon_destroy(rs);
+        return NULL;
+    }
+
+    return rs;
+}
+#else
+// without pthreads, one instance is shared and calls must not overlap
+static correct_reed_solomon *ccsds_rs;
+
+static correct_reed_solomon *ccsds_reed_solomon(void) {
+    if (!ccsds_rs) {
+        ccsds_rs = correct_reed_solomon_create(correct_rs_primitive_polynomial_ccsds, 112, 11, CCSDS_RS_NUM_ROOTS);
+    }
+    return ccsds_rs;
+}
+#endif
+
+static bool ccsds_pad_is_valid(int pad) {
+    return pad >= 0 && pad < CCSDS_RS_MSG_LENGTH;
+}
+
+// erasure positions count from the start of the unshortened block, as in decode_rs_char
+// as in libfec, the whole block is repaired, parity included, and the number of symbols
+//   corrected is returned
+static int ccsds_decode(correct_reed_solomon *rs, unsigned char *data, const int *erasure_locations, int num_erasures, int pad) {
+    uint8_t erasures[CCSDS_RS_NUM_ROOTS];
+    for (int i = 0; i < num_erasures; i++) {
+        if (erasure_locations[i] < pad || erasure_locations[i] >= 255) {
+            return -1;
+        }
+        erasures[i] = (uint8_t)(erasure_locations[i] - pad);
+    }
+
+    size_t block_length = (size_t)(255 - pad);
+    uint8_t corrected[255];
+    if (correct_reed_solomon_decode_with_erasures(rs, data, block_length, erasures, (size_t)num_erasures, corrected) < 0) {
+        return -1;
+    }
+
+    // the decoder only writes the message, so its parity is made again
+    correct_reed_solomon_encode(rs, corrected, (size_t)(CCSDS_RS_MSG_LENGTH - pad), corrected);
+
+    int num_corrected = 0;
+    for (size_t i = 0; i < block_length; i++) {
+        if (data[i] != corrected[i]) {
+            data[i] = corrected[i];
+            num_corrected++;
+        }
+    }
+
+    return num_corrected;
+}
+
+void encode_rs_8(unsigned char *data, unsigned char *parity, int pad) {
+    correct_reed_solomon *rs = ccsds_reed_solomon();
+    if (!rs || !ccsds_pad_is_valid(pad)) {
+        return;
+    }
+
+    correct_reed_solomon_encode_begin(rs);
+    correct_reed_solomon_encode_update(rs, data, (size_t)(CCSDS_RS_MSG_LENGTH - pad));
+    correct_reed_solomon_encode_final(rs, parity);
+}
+
+int decode_rs_8(unsigned char *data, int *erasure_locations, int num_erasures, int pad) {
+    correct_reed_solomon *rs = ccsds_reed_solomon();
+    if (!rs || !ccsds_pad_is_valid(pad) || num_erasures < 0 || num_erasures > CCSDS_RS_NUM_ROOTS) {
+        return -1;
+    }
+
+    return ccsds_decode(rs, data, erasure_locations, num_erasures, pad);
+}
+
+void encode_rs_ccsds(unsigned char *data, unsigned char *parity, int pad) {
+    correct_reed_solomon *rs = ccsds_reed_solomon();
+    if (!rs || !ccsds_pad_is_valid(pad)) {
+        return;
+    }
+
+    // the caller's data is const to us, so it's converted a piece at a time on the stack
+    uint8_t conventional[32];
+    size_t msg_length = (size_t)(CCSDS_RS_MSG_LENGTH - pad);
+    correct_reed_solomon_encode_begin(rs);
+    for (size_t i = 0; i < msg_length; i += sizeof(conventional)) {
+        size_t piece = (msg_length - i < sizeof(conventional)) ? msg_length - i : sizeof(conventional);
+        for (size_t j = 0; j < piece; j++) {
+            conventional[j] = ccsds_from_dual[data[i + j]];
+        }
+        correct_reed_solomon_encode_update(rs, conventional, piece);
+    }
+    correct_reed_solomon_encode_final(rs, parity);
+
+    for (unsigned int i = 0; i < CCSDS_RS_NUM_ROOTS; i++) {
+        parity[i] = ccsds_to_dual[parity[i]];
+    }
+}
+
+int decode_rs_ccsds(unsigned char *data, int *erasure_locations, int num_erasures, int pad) {
+    correct_reed_solomon *rs = ccsds_reed_solomon();
+    if (!rs || !ccsds_pad_is_valid(pad) || num_erasures < 0 || num_erasures > CCSDS_RS_NUM_ROOTS) {
+        return -1;
+    }
+
+    // change basis in place and back again afterwards
+    // a failed decode leaves the block untouched, so the caller gets back what it sent
+    size_t block_length = (size_t)(255 - pad);
+    for (size_t i = 0; i < block_length; i++) {
+        data[i] = ccsds_from_dual[data[i]];
+    }
+
+    int res = ccsds_decode(rs, data, erasure_locations, num_erasures, pad);
+
+    for (size_t i = 0; i < block_length; i++) {
+        data[i] = ccsds_to_dual[data[i]];
+    }
+
+    return res;
+}
+
+typedef struct {
+    correct_reed_solomon_int *rs;
+    unsigned int msg_length;
+    unsigned int block_length;
+    unsigned int num_roots;
+    uint16_t *block;
+    unsigned int pad;
+    uint16_t *erasures;
+} reed_solomon_int_shim;
+
+void free_rs_int(void *rs) {
+    reed_solomon_int_shim *shim = (reed_solomon_int_shim *)rs;
 
     if (!shim) {
         return;
     }
 
-    if (shim->buf) {
-        free(shim->buf);
+    if (shim->rs) {
+        correct_reed_solomon_int_destroy(shim->rs);
+    }
+
+    if (shim->block) {
+        free(shim->block);
     }
 
-    if (shim->conv) {
-        correct_convolutional_destroy(shim->conv);
+    if (shim->erasures) {
+        free(shim->erasures);
     }
 
     free(shim);
 }
 
-static void *create_viterbi(unsigned int num_decoded_bits, unsigned int rate, unsigned int order, correct_convolutional_polynomial_t *poly) {
-    convolutional_shim *shim = (convolutional_shim *)malloc(sizeof(convolutional_shim));
-    if (!shim) {
+void *init_rs_int(int symbol_size, int primitive_polynomial, int first_consecutive_root, int root_gap, int number_roots, int pad) {
+    if (symbol_size < 2 || symbol_size > 16 || number_roots <= 0 || pad < 0) {
         return NULL;
     }
 
-    size_t num_decoded_bytes = (num_decoded_bits % 8) ? (num_decoded_bits / 8 + 1) : num_decoded_bits / 8;
+    unsigned int full_length = (1U << symbol_size) - 1;
+    if ((unsigned int)pad + (unsigned int)number_roots >= full_length) {
+        return NULL;
+    }
 
-    shim->rate = rate;
-    shim->order = order;
-    shim->buf = (uint8_t *)malloc(num_decoded_bytes);
-    if (!shim->buf) {
-        delete_viterbi(shim);
+    reed_solomon_int_shim *shim = (reed_solomon_int_shim *)calloc(1, sizeof(reed_solomon_int_shim));
+    if (!shim) {
+        return NULL;
+    }
+
+    shim->pad = (unsigned int)pad;
+    shim->block_length = full_length - shim->pad;
+    shim->num_roots = (unsigned int)number_roots;
+    shim->msg_length = shim->block_length - shim->num_roots;
+    shim->rs = correct_reed_solomon_int_create((unsigned int)symbol_size, (uint32_t)primitive_polynomial, (uint16_t)first_consecutive_root, (uint16_t)root_gap, (size_t)number_roots);
+    if (!shim->rs) {
+        free_rs_int(shim);
         return NULL;
     }
 
-    shim->buf_len = num_decoded_bytes;
-    shim->conv = correct_convolutional_create(rate, order, poly);
-    if (!shim->conv) {
-        delete_viterbi(shim);
+    shim->block = (uint16_t *)malloc(shim->block_length * sizeof(uint16_t));
+    if (!shim->block) {
+        free_rs_int(shim);
         return NULL;
     }
 
-    shim->read_iter = shim->buf;
-    shim->write_iter = shim->buf;
+    shim->erasures = (uint16_t *)malloc((size_t)number_roots * sizeof(uint16_t));
+    if (!shim->erasures) {
+        free_rs_int(shim);
+        return NULL;
+    }
 
     return shim;
 }
 
-static void init_viterbi(void *vit) {
-    convolutional_shim *shim = (convolutional_shim *)vit;
-    shim->read_iter = shim->buf;
-    shim->write_iter = shim->buf;
-}
+void encode_rs_int(void *rs, const int *msg, int *parity) {
+    reed_solomon_int_shim *shim = (reed_solomon_int_shim *)rs;
 
-static void update_viterbi_blk(void *vit, const unsigned char *encoded_soft, unsigned int num_encoded_groups) {
-    convolutional_shim *shim = (convolutional_shim *)vit;
+    for (unsigned int i = 0; i < shim->msg_length; i++) {
+        shim->block[i] = (uint16_t)msg[i];
+    }
+
+    correct_reed_solomon_int_encode(shim->rs, shim->block, shim->msg_length, shim->block);
 
-    // don't overwrite our buffer
-    size_t rem = (size_t)((shim->buf + shim->buf_len) - shim->write_iter);
-    size_t rem_bits = 8 * rem;
-    // this math isn't very clear
-    // here we sort of do the opposite of what liquid-dsp does
-    size_t n_write_bits = num_encoded_groups - (shim->order - 1);
-    if (n_write_bits > rem_bits) {
-        size_t reduction = n_write_bits - rem_bits;
-        num_encoded_groups -= (unsigned int)reduction;
-        n_write_bits -= reduction;
-    }
-
-    // what if n_write_bits isn't a multiple of 8?
-    // libcorrect can't start and stop at arbitrary indices...
-    correct_convolutional_decode_soft(shim->conv, encoded_soft, num_encoded_groups * shim->rate, shim->write_iter);
-    shim->write_iter += n_write_bits / 8;
+    for (unsigned int i = 0; i < shim->num_roots; i++) {
+        parity[i] = shim->block[shim->msg_length + i];
+    }
 }
 
-static void chainback_viterbi(void *vit, unsigned char *decoded, unsigned int num_decoded_bits) {
-    convolutional_shim *shim = (convolutional_shim *)vit;
+int decode_rs_int(void *rs, int *block, int *erasure_locations, int num_erasures) {
+    reed_solomon_int_shim *shim = (reed_solomon_int_shim *)rs;
 
-    // num_decoded_bits not a multiple of 8?
-    // this is a similar problem to update_viterbi_blk
-    // although here we could actually resolve a non-multiple of 8
-    size_t rem = (size_t)(shim->write_iter - shim->read_iter);
-    size_t rem_bits = 8 * rem;
+    if (num_erasures < 0 || (unsigned int)num_erasures > shim->num_roots) {
+        return -1;
+    }
 
-    if (num_decoded_bits > rem_bits) {
-        num_decoded_bits = (unsigned int)rem_bits;
+    for (int i = 0; i < num_erasures; i++) {
+        shim->erasures[i] = (uint16_t)((unsigned int)erasure_locations[i] - shim->pad);
     }
 
-    size_t num_decoded_bytes = (num_decoded_bits % 8) ? (num_decoded_bits / 8 + 1) : num_decoded_bits / 8;
-    memcpy(decoded, shim->read_iter, num_decoded_bytes);
+    for (unsigned int i = 0; i < shim->block_length; i++) {
+        shim->block[i] = (uint16_t)block[i];
+    }
 
-    shim->read_iter += num_decoded_bytes;
-}
+    ssize_t res = correct_reed_solomon_int_decode_with_erasures(shim->rs, shim->block, shim->block_length, shim->erasures, (size_t)num_erasures, shim->block);
+    if (res < 0) {
+        return -1;
+    }
 
-/* Rate 1/2, k = 7 */
-void *create_viterbi27(int num_decoded_bits) {
-    return create_viterbi((unsigned int)num_decoded_bits, 2, 7, r12k7);
-}
+    for (unsigned int i = 0; i < shim->msg_length; i++) {
+        block[i] = shim->block[i];
+    }
 
-void delete_viterbi27(void *vit) {
-    delete_viterbi(vit);
+    return (int)res;
 }
 
-int init_viterbi27(void *vit, int _) {
-    (void) _;
+// the shim picks the fastest decoder that was built unless the caller asks for _port
+typedef enum {
+    CONV_SHIM_PORTABLE,
+    CONV_SHIM_FASTEST,
+} convolutional_shim_backend;
 
-    init_viterbi(vit);
-    return 0;
-}
+typedef struct {
+    correct_convolutional *conv;
+#ifdef HAVE_SSE
+    correct_convolutional_sse *conv_sse;
+#endif
+    unsigned int rate;
+    unsigned int order;
+    // libfec marks an inverted output with a negative polynomial
+    // we flip those soft symbols on the way in, through soft_buf
+    bool invert[6];
+    bool has_invert;
+    uint8_t *soft_buf;
+} convolutional_shim;
 
-int update_viterbi27_blk(void *vit, unsigned char *encoded_soft, int num_encoded_groups) {
-    update_viterbi_blk(vit, encoded_soft, (unsigned int)num_encoded_groups);
-    return 0;
-}
+// these start as libfec's defaults and may be changed by set_viterbi*_polynomial
+static int r12k7[] = {V27POLYA, V27POLYB};
 
-int chainback_viterbi27(void *vit, unsigned char *decoded, unsigned int num_decoded_bits, unsigned int _) {
-    (void) _;
+static int r12k9[] = {V29POLYA, V29POLYB};
 
-    chainback_viterbi(vit, decoded, num_decoded_bits);
-    return 0;
-}
+static int r13k9[] = {V39POLYA, V39POLYB, V39POLYC};
 
-/* Rate 1/2, k = 9 */
-void *create_viterbi29(int num_decoded_bits) {
-    return create_viterbi((unsigned int)num_decoded_bits, 2, 9, r12k9);
-}
+static int r16k15[] = {
+    V615POLYA, V615POLYB, V615POLYC, V615POLYD, V615POLYE, V615POLYF};
 
-void delete_viterbi29(void *vit) {
-    delete_viterbi(vit);
-}
+/* Common methods */
+static void delete_viterbi(void *vit) {
+    convolutional_shim *shim = (convolutional_shim *)vit;
 
-int init_viterbi29(void *vit, int _) {
-    (void) _;
+    if (!shim) {
+        return;
+    }
 
-    init_viterbi(vit);
-    return 0;
-}
+    if (shim->soft_buf) {
+        free(shim->soft_buf);
+    }
 
-int update_viterbi29_blk(void *vit, unsigned char *encoded_soft, int num_encoded_groups) {
-    update_viterbi_blk(vit, encoded_soft, (unsigned int)num_encoded_groups);
-    return 0;
-}
+    if (shim->conv) {
+        correct_convolutional_destroy(shim->conv);
+    }
 
-int chainback_viterbi29(void *vit, unsigned char *decoded, unsigned int num_decoded_bits, unsigned int _) {
-    (void) _;
+#ifdef HAVE_SSE
+    if (shim->conv_sse) {
+        correct_convolutional_sse_destroy(shim->conv_sse);
+    }
+#endif
 
-    chainback_viterbi(vit, decoded, num_decoded_bits);
-    return 0;
+    free(shim);
 }
 
-/* Rate 1/3, k = 9 */
-void *create_viterbi39(int num_decoded_bits) {
-    return create_viterbi((unsigned int)num_decoded_bits, 3, 9, r13k9);
-}
+// libfec decodes a whole frame at a time: init, then any number of updates which
+//   together carry the message and its tail, then one chainback
+// the decoder holds every decision for the frame, sized here for num_decoded_bits
+static void *create_viterbi(unsigned int num_decoded_bits, unsigned int rate, unsigned int order, const int *polys, convolutional_shim_backend backend) {
+    convolutional_shim *shim = (convolutional_shim *)calloc(1, sizeof(convolutional_shim));
+    if (!shim) {
+        return NULL;
+    }
 
-void delete_viterbi39(void *vit) {
-    delete_viterbi(vit);
-}
+    shim->rate = rate;
+    shim->order = order;
 
-int init_viterbi39(void *vit, int _) {
-    (void) _;
+    size_t max_sets = num_decoded_bits + order - 1;
 
-    init_viterbi(vit);
-    return 0;
-}
+    correct_convolutional_polynomial_t poly[6];
+    for (unsigned int i = 0; i < rate; i++) {
+        shim->invert[i] = polys[i] < 0;
+        shim->has_invert = shim->has_invert || shim->invert[i];
+        poly[i] = (correct_convolutional_polynomial_t)(polys[i] < 0 ? -polys[i] : polys[i]);
+    }
 
-int update_viterbi39_blk(void *vit, unsigned char *encoded_soft, int num_encoded_groups) {
-    update_viterbi_blk(vit, encoded_soft, (unsigned int)num_encoded_groups);
-    return 0;
-}
+    if (shim->has_invert) {
+        shim->soft_buf = (uint8_t *)malloc(max_sets * rate);
+        if (!shim->soft_buf) {
+            delete_viterbi(shim);
+            return NULL;
+        }
+    }
 
-int chainback_viterbi39(void *vit, unsigned char *decoded, unsigned int num_decoded_bits, unsigned int _) {
-    (void) _;
+#ifdef HAVE_SSE
+    if (backend == CONV_SHIM_FASTEST) {
+        shim->conv_sse = correct_convolutional_sse_create(rate, order, poly);
+        if (!shim->conv_sse || !convolutional_sse_decode_frame_init(shim->conv_sse, max_sets)) {
+            delete_viterbi(shim);
+            return NULL;
+        }
+    }
+#else
+    // the portable decoder is the fastest we have
+    backend = CONV_SHIM_PORTABLE;
+#endif
+
+    if (backend == CONV_SHIM_PORTABLE) {
+        shim->conv = correct_convolutional_create(rate, order, poly);
+        if (!shim->conv || !convolutional_decode_frame_init(shim->conv, max_sets)) {
+            delete_viterbi(shim);
+            return NULL;
+        }
+    }
 
-    chainback_viterbi(vit, decoded, num_decoded_bits);
-    return 0;
+    return shim;
 }
 
-/* Rate 1/6, k = 15 */
-void *create_viterbi615(int num_decoded_bits) {
-    return create_viterbi((unsigned int)num_decoded_bits, 6, 15, r16k15);
+static correct_convolutional *viterbi_conv(convolutional_shim *shim) {
+#ifdef HAVE_SSE
+    if (shim->conv_sse) {
+        return &shim->conv_sse->base_conv;
+    }
+#endif
+    return shim->conv;
 }
 
-void delete_viterbi615(void *vit) {
-    delete_viterbi(vit);
+static void init_viterbi(void *vit, unsigned int starting_state) {
+    convolutional_shim *shim = (convolutional_shim *)vit;
+    convolutional_decode_frame_reset(viterbi_conv(shim), starting_state);
 }
 
-int init_viterbi615(void *vit, int _) {
-    (void) _;
+static void update_viterbi_blk(void *vit, const unsigned char *encoded_soft, unsigned int num_encoded_groups) {
+    convolutional_shim *shim = (convolutional_shim *)vit;
+    correct_convolutional *conv = viterbi_conv(shim);
 
-    init_viterbi(vit);
-    return 0;
-}
+    // anything past the end of the frame we were created for is dropped
+    size_t groups = num_encoded_groups;
+    if (groups > conv->frame_cap - conv->frame_len) {
+        groups = conv->frame_cap - conv->frame_len;
+    }
 
-int update_viterbi615_blk(void *vit, unsigned char *encoded_soft, int num_encoded_groups) {
-    update_viterbi_blk(vit, encoded_soft, (unsigned int)num_encoded_groups);
-    return 0;
+    if (shim->has_invert) {
+        size_t num_encoded_bits = groups * shim->rate;
+        for (size_t i = 0; i < num_encoded_bits; i++) {
+            shim->soft_buf[i] = shim->invert[i % shim->rate] ? (uint8_t)(255 - encoded_soft[i]) : encoded_soft[i];
+        }
+        encoded_soft = shim->soft_buf;
+    }
+
+#ifdef HAVE_SSE
+    if (shim->conv_sse) {
+        convolutional_sse_decode_frame_update(shim->conv_sse, encoded_soft, groups);
+        return;
+    }
+#endif
+    convolutional_decode_frame_update(shim->conv, encoded_soft, groups);
 }
 
-int chainback_viterbi615(void *vit, unsigned char *decoded, unsigned int num_decoded_bits, unsigned int _) {
-    (void) _;
+static void chainback_viterbi(void *vit, unsigned char *decoded, unsigned int num_decoded_bits, unsigned int endstate) {
+    convolutional_shim *shim = (convolutional_shim *)vit;
+    convolutional_decode_frame_traceback(viterbi_conv(shim), endstate, num_decoded_bits, decoded);
+}
 
-    chainback_viterbi(vit, decoded, num_decoded_bits);
-    return 0;
+static void set_viterbi_polynomial(int *dest, const int *polys, unsigned int rate) {
+    for (unsigned int i = 0; i < rate; i++) {
+        dest[i] = polys[i];
+    }
 }
+
+// libfec's entry points for one code and one of its vector unit suffixes
+// all of them share the code's polynomials, and a new polynomial applies to
+//   decoders created after it is set
+#define FEC_SHIM_VITERBI(name, suffix, rate, order, polys, backend)                                \
+    void *create_##name##suffix(int num_decoded_bits) {                                         \
+        return create_viterbi((unsigned int)num_decoded_bits, rate, order, polys, backend);    \
+    }                                                                                           \
+                                                                                                \
+    void delete_##name##suffix(void *vit) {                                                     \
+        delete_viterbi(vit);                                                                    \
+    }                                                                                           \
+                                                                                                \
+    int init_##name##suffix(void *vit, int starting_state) {                                    \
+        init_viterbi(vit, (unsigned int)starting_state);                                        \
+        return 0;                                                                               \
+    }                                                                                           \
+                                                                                                \
+    int update_##name##_blk##suffix(void *vit, unsigned char *encoded_soft, int num_encoded_groups) { \
+        update_viterbi_blk(vit, encoded_soft, (unsigned int)num_encoded_groups);               \
+        return 0;                                                                               \
+    }                                                                                           \
+                                                                                                \
+    int chainback_##name##suffix(void *vit, unsigned char *decoded, unsigned int num_decoded_bits, unsigned int endstate) { \
+        chainback_viterbi(vit, decoded, num_decoded_bits, endstate);                            \
+        return 0;                                                                               \
+    }                                                                                           \
+                                                                                                \
+    void set_##name##_polynomial##suffix(int polys_in[rate]) {                                  \
+        set_viterbi_polynomial(polys, polys_in, rate);                                          \
+    }
+
+/* Rate 1/2, k = 7 */
+FEC_SHIM_VITERBI(viterbi27, , 2, 7, r12k7, CONV_SHIM_FASTEST)
+FEC_SHIM_VITERBI(viterbi27, _port, 2, 7, r12k7, CONV_SHIM_PORTABLE)
+FEC_SHIM_VITERBI(viterbi27, _sse2, 2, 7, r12k7, CONV_SHIM_FASTEST)
+
+/* Rate 1/2, k = 9 */
+FEC_SHIM_VITERBI(viterbi29, , 2, 9, r12k9, CONV_SHIM_FASTEST)
+FEC_SHIM_VITERBI(viterbi29, _port, 2, 9, r12k9, CONV_SHIM_PORTABLE)
+FEC_SHIM_VITERBI(viterbi29, _sse2, 2, 9, r12k9, CONV_SHIM_FASTEST)
+
+/* Rate 1/3, k = 9 */
+FEC_SHIM_VITERBI(viterbi39, , 3, 9, r13k9, CONV_SHIM_FASTEST)
+FEC_SHIM_VITERBI(viterbi39, _port, 3, 9, r13k9, CONV_SHIM_PORTABLE)
+FEC_SHIM_VITERBI(viterbi39, _sse2, 3, 9, r13k9, CONV_SHIM_FASTEST)
+
+/* Rate 1/6, k = 15 */
+FEC_SHIM_VITERBI(viterbi615, , 6, 15, r16k15, CONV_SHIM_FASTEST)
+FEC_SHIM_VITERBI(viterbi615, _port, 6, 15, r16k15, CONV_SHIM_PORTABLE)
+FEC_SHIM_VITERBI(viterbi615, _sse2, 6, 15, r16k15, CONV_SHIM_FASTEST)
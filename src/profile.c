@@ -0,0 +1,81 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "correct/profile.h"
+
+#ifdef CORRECT_PROFILE
+static const char *profile_stage_names[PROFILE_NUM_STAGES] = {
+    "conv_distances",
+    "conv_fill",
+    "conv_acs",
+    "conv_renormalize",
+    "conv_traceback",
+    "conv_output",
+    "rs_syndromes",
+    "rs_berlekamp_massey",
+    "rs_chien",
+    "rs_forney",
+};
+
+__thread profile_counters_t *profile_thread_counters = NULL;
+
+// every thread's counters, newest first. they're never freed, so that a thread's time
+//   still counts after it exits
+static profile_counters_t *profile_all_counters = NULL;
+
+profile_counters_t *profile_counters_create(void) {
+    profile_counters_t *counters = (profile_counters_t *)calloc(1, sizeof(profile_counters_t));
+    if (!counters) {
+        return NULL;
+    }
+
+    counters->next = __atomic_load_n(&profile_all_counters, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&profile_all_counters, &counters->next, counters, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+    }
+
+    profile_thread_counters = counters;
+    return counters;
+}
+
+ssize_t correct_profile_dump(correct_profile_stage_t *stages, size_t max_stages) {
+    if (!stages) {
+        return -1;
+    }
+
+    size_t num_stages = (max_stages < PROFILE_NUM_STAGES) ? max_stages : PROFILE_NUM_STAGES;
+    for (size_t i = 0; i < num_stages; i++) {
+        stages[i].name = profile_stage_names[i];
+        stages[i].calls = 0;
+        stages[i].ticks = 0;
+    }
+
+    for (profile_counters_t *counters = __atomic_load_n(&profile_all_counters, __ATOMIC_ACQUIRE); counters; counters = counters->next) {
+        for (size_t i = 0; i < num_stages; i++) {
+            stages[i].calls += counters->calls[i];
+            stages[i].ticks += counters->ticks[i];
+        }
+    }
+
+    return (ssize_t)num_stages;
+}
+
+ssize_t correct_profile_reset(void) {
+    for (profile_counters_t *counters = __atomic_load_n(&profile_all_counters, __ATOMIC_ACQUIRE); counters; counters = counters->next) {
+        memset(counters->ticks, 0, sizeof(counters->ticks));
+        memset(counters->calls, 0, sizeof(counters->calls));
+    }
+
+    return 0;
+}
+#else
+ssize_t correct_profile_dump(correct_profile_stage_t *stages, size_t max_stages) {
+    (void)stages;
+    (void)max_stages;
+    return -1;
+}
+
+ssize_t correct_profile_reset(void) {
+    return -1;
+}
+#endif
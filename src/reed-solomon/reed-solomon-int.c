@@ -0,0 +1,145 @@
+#include "correct/reed-solomon/int.h"
+
+void correct_reed_solomon_int_destroy(correct_reed_solomon_int *rs) {
+    if (rs) {
+        if (rs->field) {
+            field_int_destroy(rs->field);
+        }
+
+        if (rs->generator_log) {
+            free(rs->generator_log);
+        }
+
+        if (rs->generator_root_log) {
+            free(rs->generator_root_log);
+        }
+
+        if (rs->parity) {
+            free(rs->parity);
+        }
+
+        if (rs->syndromes) {
+            free(rs->syndromes);
+        }
+
+        if (rs->error_locator) {
+            free(rs->error_locator);
+        }
+
+        if (rs->last_error_locator) {
+            free(rs->last_error_locator);
+        }
+
+        if (rs->next_error_locator) {
+            free(rs->next_error_locator);
+        }
+
+        if (rs->chien_registers) {
+            free(rs->chien_registers);
+        }
+
+        if (rs->error_locations) {
+            free(rs->error_locations);
+        }
+
+        if (rs->error_vals) {
+            free(rs->error_vals);
+        }
+
+        if (rs->syndrome_tables) {
+            ALIGNED_FREE(rs->syndrome_tables);
+        }
+
+        free(rs);
+    }
+}
+
+// the roots of the generator are spaced by alpha^gap, so gap must be coprime with the
+//   multiplicative group order or error locations within a block would alias
+static bool reed_solomon_int_gap_is_valid(field_int_operation_t size, field_int_operation_t gap) {
+    field_int_operation_t a = size;
+    field_int_operation_t b = gap % size;
+    while (b) {
+        field_int_operation_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a == 1;
+}
+
+correct_reed_solomon_int *correct_reed_solomon_int_create(unsigned int symbol_size, uint32_t primitive_polynomial, uint16_t first_consecutive_root, uint16_t generator_root_gap, size_t num_roots) {
+    field_int_t *field = field_int_create(symbol_size, primitive_polynomial);
+    if (!field) {
+        return NULL;
+    }
+
+    if (num_roots == 0 || num_roots >= field->size || !reed_solomon_int_gap_is_valid(field->size, generator_root_gap)) {
+        field_int_destroy(field);
+        return NULL;
+    }
+
+    correct_reed_solomon_int *rs = (correct_reed_solomon_int *)calloc(1, sizeof(correct_reed_solomon_int));
+    if (!rs) {
+        field_int_destroy(field);
+        return NULL;
+    }
+
+    rs->field = field;
+    rs->block_length = field->size;
+    rs->min_distance = num_roots;
+    rs->message_length = rs->block_length - rs->min_distance;
+
+    rs->first_consecutive_root = first_consecutive_root;
+    rs->generator_root_gap = generator_root_gap;
+
+    rs->generator_root_log = (field_int_logarithm_t *)malloc(num_roots * sizeof(field_int_logarithm_t));
+    if (!rs->generator_root_log) {
+        correct_reed_solomon_int_destroy(rs);
+        return NULL;
+    }
+
+    // generator has order num_roots
+    // of form (x + alpha^(gap*fcr))(x + alpha^(gap*(fcr + 1)))...
+    // we multiply it out one root at a time in element form, then keep only the logs
+    field_int_element_t *generator = (field_int_element_t *)calloc(num_roots + 1, sizeof(field_int_element_t));
+    if (!generator) {
+        correct_reed_solomon_int_destroy(rs);
+        return NULL;
+    }
+
+    generator[0] = 1;
+    for (size_t i = 0; i < num_roots; i++) {
+        field_int_logarithm_t root_log = field_int_log_mod(field, (uint64_t)generator_root_gap * (first_consecutive_root + i));
+        rs->generator_root_log[i] = root_log;
+
+        // multiply by (x + root), moving down so we don't overwrite what we still need
+        generator[i + 1] = generator[i];
+        for (size_t j = i; j > 0; j--) {
+            field_int_element_t term = generator[j] ? field_int_mul_log_element(field, field->log[generator[j]], root_log) : 0;
+            generator[j] = generator[j - 1] ^ term;
+        }
+        generator[0] = field_int_mul_log_element(field, field->log[generator[0]], root_log);
+    }
+
+    rs->generator_log = (field_int_logarithm_t *)malloc((num_roots + 1) * sizeof(field_int_logarithm_t));
+    if (!rs->generator_log) {
+        free(generator);
+        correct_reed_solomon_int_destroy(rs);
+        return NULL;
+    }
+
+    for (size_t i = 0; i <= num_roots; i++) {
+        rs->generator_log[i] = field->log[generator[i]];
+    }
+    free(generator);
+
+    rs->parity = (field_int_element_t *)malloc(num_roots * sizeof(field_int_element_t));
+    if (!rs->parity) {
+        correct_reed_solomon_int_destroy(rs);
+        return NULL;
+    }
+
+    rs->has_init_decode = false;
+
+    return rs;
+}
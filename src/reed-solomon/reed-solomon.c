@@ -11,6 +11,45 @@ static polynomial_t *reed_solomon_build_generator(field_t *field, unsigned int n
     return polynomial_create_from_roots(field, nroots, roots);
 }
 
+// the decoder moves between error locations and locator roots, and scales each error
+//   value by a power of its root. all of these depend only on the code, so tabulate them
+//   once here rather than searching the field for each error
+static bool reed_solomon_build_location_tables(correct_reed_solomon *rs) {
+    field_t *field = rs->field;
+
+    rs->error_root_location = (field_logarithm_t *)calloc(256, sizeof(field_logarithm_t));
+    rs->error_location_root = (field_element_t *)calloc(256, sizeof(field_element_t));
+    rs->error_root_scale_log = (field_logarithm_t *)calloc(256, sizeof(field_logarithm_t));
+    if (!rs->error_root_location || !rs->error_location_root || !rs->error_root_scale_log) {
+        return false;
+    }
+
+    // an error at location l has X = (alpha^l)^gap and locator root X^-1
+    for (field_operation_t l = 0; l < 256; l++) {
+        field_element_t location = field_pow(field, field->exp[l], rs->generator_root_gap);
+        rs->error_location_root[l] = field_div(field, 1, location);
+    }
+
+    // invert, preferring the lowest field element j with j^gap = X as the decoder
+    //   has always done. when gap is coprime with 255 there is only ever one
+    bool found[256] = {false};
+    field_logarithm_t location_of[256] = {0};
+    for (field_operation_t j = 0; j < 256; j++) {
+        field_element_t location = field_pow(field, (field_element_t)j, rs->generator_root_gap);
+        if (!found[location]) {
+            found[location] = true;
+            location_of[location] = field->log[j];
+        }
+    }
+
+    for (field_operation_t root = 1; root < 256; root++) {
+        rs->error_root_location[root] = location_of[field_div(field, 1, (field_element_t)root)];
+        rs->error_root_scale_log[root] = field->log[field_pow(field, (field_element_t)root, rs->first_consecutive_root - 1)];
+    }
+
+    return true;
+}
+
 void correct_reed_solomon_destroy(correct_reed_solomon *rs) {
     if (rs) {
         if (rs->field) {
@@ -33,6 +72,18 @@ void correct_reed_solomon_destroy(correct_reed_solomon *rs) {
             free(rs->generator_root_exp);
         }
 
+        if (rs->error_root_location) {
+            free(rs->error_root_location);
+        }
+
+        if (rs->error_location_root) {
+            free(rs->error_location_root);
+        }
+
+        if (rs->error_root_scale_log) {
+            free(rs->error_root_scale_log);
+        }
+
         if (rs->encoded_polynomial) {
             polynomial_destroy(rs->encoded_polynomial);
         }
@@ -41,6 +92,14 @@ void correct_reed_solomon_destroy(correct_reed_solomon *rs) {
             polynomial_destroy(rs->encoded_remainder);
         }
 
+        if (rs->generator_log) {
+            free(rs->generator_log);
+        }
+
+        if (rs->stream_parity) {
+            free(rs->stream_parity);
+        }
+
         if (rs->syndromes) {
             free(rs->syndromes);
         }
@@ -105,6 +164,18 @@ void correct_reed_solomon_destroy(correct_reed_solomon *rs) {
             polynomial_destroy(rs->init_from_roots_scratch[1]);
         }
 
+        if (rs->erasure_pattern) {
+            free(rs->erasure_pattern);
+        }
+
+        if (rs->erasure_recovery) {
+            free(rs->erasure_recovery);
+        }
+
+        if (rs->check_tables) {
+            ALIGNED_FREE(rs->check_tables);
+        }
+
         free(rs);
     }
 }
@@ -140,6 +211,11 @@ correct_reed_solomon *correct_reed_solomon_create(field_operation_t primitive_po
         return NULL;
     }
 
+    if (!reed_solomon_build_location_tables(rs)) {
+        correct_reed_solomon_destroy(rs);
+        return NULL;
+    }
+
     rs->encoded_polynomial = polynomial_create((unsigned int)(rs->block_length - 1));
     if (!rs->encoded_polynomial) {
         correct_reed_solomon_destroy(rs);
@@ -152,7 +228,26 @@ correct_reed_solomon *correct_reed_solomon_create(field_operation_t primitive_po
         return NULL;
     }
 
+    rs->generator_log = (field_logarithm_t *)malloc((rs->min_distance + 1) * sizeof(field_logarithm_t));
+    if (!rs->generator_log) {
+        correct_reed_solomon_destroy(rs);
+        return NULL;
+    }
+
+    for (unsigned int i = 0; i <= rs->min_distance; i++) {
+        rs->generator_log[i] = rs->field->log[rs->generator->coeff[i]];
+    }
+
+    rs->stream_parity = (field_element_t *)calloc(rs->min_distance, sizeof(field_element_t));
+    if (!rs->stream_parity) {
+        correct_reed_solomon_destroy(rs);
+        return NULL;
+    }
+    rs->stream_length = 0;
+
     rs->has_init_decode = false;
+    rs->has_erasure_pattern = false;
+    rs->has_init_check = false;
 
     return rs;
 }
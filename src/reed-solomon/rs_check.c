@@ -0,0 +1,145 @@
+#include "correct/reed-solomon/check.h"
+
+// verify-only mode
+// a block is clean exactly when the received polynomial is 0 at every root of the
+//   generator. we evaluate straight from the caller's buffer, which is already highest
+//   order first, so horner's method needs no reversal or padding, and we stop at the
+//   first nonzero syndrome
+
+#ifdef HAVE_RS_SPLIT_TABLES
+// the SIMD kernel evaluates 16 interleaved lanes of the block at once, so each lane
+//   steps by root^16. a byte is the xor of its two nibbles, so root^16 * byte is the
+//   xor of two 16-entry shuffles. each syndrome gets 32 bytes, low nibble table first
+static bool correct_reed_solomon_check_create(correct_reed_solomon *rs) {
+    rs->check_tables = (uint8_t *)ALIGNED_MALLOC(rs->min_distance * 32, 16);
+    if (!rs->check_tables) {
+        return false;
+    }
+
+    const field_t *field = rs->field;
+    for (size_t i = 0; i < rs->min_distance; i++) {
+        field_logarithm_t root_log = field->log[rs->generator_roots[i]];
+        field_logarithm_t step_log = (field_logarithm_t)((16 * (unsigned int)root_log) % 255);
+        uint8_t *tables = rs->check_tables + i * 32;
+        for (field_operation_t v = 0; v < 16; v++) {
+            tables[v] = v ? field_mul_log_element(field, field->log[v], step_log) : 0;
+            tables[16 + v] = v ? field_mul_log_element(field, field->log[v << 4], step_log) : 0;
+        }
+    }
+
+    rs->has_init_check = true;
+    return true;
+}
+
+// returns true if this syndrome is zero
+static bool reed_solomon_check_syndrome(const correct_reed_solomon *rs, const uint8_t *first, const uint8_t *rest, size_t num_chunks, size_t i) {
+    const field_t *field = rs->field;
+    const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+    const __m128i low_table = _mm_load_si128((const __m128i *)(rs->check_tables + i * 32));
+    const __m128i high_table = _mm_load_si128((const __m128i *)(rs->check_tables + i * 32 + 16));
+
+    __m128i lanes = _mm_loadu_si128((const __m128i *)first);
+    for (size_t c = 0; c < num_chunks; c++) {
+        __m128i low = _mm_and_si128(lanes, nibble_mask);
+        __m128i high = _mm_and_si128(_mm_srli_epi16(lanes, 4), nibble_mask);
+        lanes = _mm_xor_si128(_mm_shuffle_epi8(low_table, low), _mm_shuffle_epi8(high_table, high));
+        lanes = _mm_xor_si128(lanes, _mm_loadu_si128((const __m128i *)(rest + 16 * c)));
+    }
+
+    // combine the lanes with the remaining powers root^15...root^0
+    uint8_t acc[16];
+    _mm_storeu_si128((__m128i *)acc, lanes);
+
+    field_logarithm_t root_log = field->log[rs->generator_roots[i]];
+    field_element_t eval = 0;
+    for (unsigned int l = 0; l < 16; l++) {
+        if (eval) {
+            eval = field_mul_log_element(field, field->log[eval], root_log);
+        }
+        eval ^= acc[l];
+    }
+
+    return eval == 0;
+}
+
+static bool reed_solomon_check_block(const correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length) {
+    // treat the block as if it had enough leading 0s to make its length a multiple of 16
+    //   which doesn't change the polynomial
+    size_t lead = (16 - encoded_length % 16) % 16;
+    uint8_t first[16] = {0};
+    memcpy(first + lead, encoded, 16 - lead);
+    const uint8_t *rest = encoded + (16 - lead);
+    size_t num_chunks = (encoded_length + lead) / 16 - 1;
+
+    for (size_t i = 0; i < rs->min_distance; i++) {
+        if (!reed_solomon_check_syndrome(rs, first, rest, num_chunks, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+#else
+static bool correct_reed_solomon_check_create(correct_reed_solomon *rs) {
+    // the scalar kernel only needs the generator roots we already have
+    rs->has_init_check = true;
+    return true;
+}
+
+static bool reed_solomon_check_block(const correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length) {
+    const field_t *field = rs->field;
+    for (size_t i = 0; i < rs->min_distance; i++) {
+        field_logarithm_t root_log = field->log[rs->generator_roots[i]];
+        field_element_t eval = 0;
+        for (size_t j = 0; j < encoded_length; j++) {
+            if (eval) {
+                eval = field_mul_log_element(field, field->log[eval], root_log);
+            }
+            eval ^= encoded[j];
+        }
+
+        if (eval) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+ssize_t correct_reed_solomon_check(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length) {
+    if (!rs || !encoded || encoded_length > rs->block_length || encoded_length <= rs->min_distance) {
+        return -1;
+    }
+
+    if (!rs->has_init_check && !correct_reed_solomon_check_create(rs)) {
+        return -1;
+    }
+
+    return reed_solomon_check_block(rs, encoded, encoded_length) ? 1 : 0;
+}
+
+ssize_t correct_reed_solomon_check_blocks(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length, size_t num_blocks, uint8_t *clean) {
+    if (!rs || !encoded || encoded_length > rs->block_length || encoded_length <= rs->min_distance) {
+        return -1;
+    }
+
+    if (!rs->has_init_check && !correct_reed_solomon_check_create(rs)) {
+        return -1;
+    }
+
+    ssize_t num_dirty = 0;
+    for (size_t b = 0; b < num_blocks; b++) {
+        bool block_clean = reed_solomon_check_block(rs, encoded + b * encoded_length, encoded_length);
+        if (!block_clean) {
+            num_dirty++;
+        }
+
+        if (clean) {
+            clean[b] = block_clean ? 1 : 0;
+        } else if (!block_clean) {
+            // the caller only wants to know if the whole batch is clean
+            break;
+        }
+    }
+
+    return num_dirty;
+}
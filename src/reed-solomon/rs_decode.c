@@ -185,57 +185,49 @@ void reed_solomon_find_error_values(correct_reed_solomon *rs) {
     polynomial_formal_derivative(rs->error_locator, rs->error_locator_derivative);
 
     // calculate each e(j)
+    // everything that depends only on the root, X(j)^(1-c) = (X(j)^-1)^(c-1), was tabulated
+    //   at create, so we stay in the log domain and finish with a single exp lookup
+    field_t *field = rs->field;
     for (unsigned int i = 0; i < rs->error_locator->order; i++) {
-        if (rs->error_roots[i] == 0) {
+        field_element_t root = rs->error_roots[i];
+        if (root == 0) {
             continue;
         }
 
-        rs->error_vals[i] = field_mul(
-            rs->field, field_pow(rs->field, rs->error_roots[i], rs->first_consecutive_root - 1),
-            field_div(
-                rs->field,
-                polynomial_eval_lut(rs->field, rs->error_evaluator, rs->element_exp[rs->error_roots[i]]),
-                polynomial_eval_lut(rs->field, rs->error_locator_derivative, rs->element_exp[rs->error_roots[i]]))
-            );
+        const field_logarithm_t *root_exp = rs->element_exp[root];
+        field_element_t numerator = polynomial_eval_lut(field, rs->error_evaluator, root_exp);
+        field_element_t denominator = polynomial_eval_lut(field, rs->error_locator_derivative, root_exp);
+        if (!numerator || !denominator) {
+            rs->error_vals[i] = 0;
+            continue;
+        }
+
+        field_logarithm_t quotient_log = field_div_log(field->log[numerator], field->log[denominator]);
+        rs->error_vals[i] = field_mul_log_element(field, rs->error_root_scale_log[root], quotient_log);
     }
 }
 
 /* Finds error locations from error roots
  * num_skip: Number of roots to skip (used for erasure decoding)
  */
-void reed_solomon_find_error_locations(field_t *field, field_logarithm_t generator_root_gap, field_element_t *error_roots, field_logarithm_t *error_locations, unsigned int num_errors, unsigned int num_skip) {
+void reed_solomon_find_error_locations(const field_logarithm_t *error_root_location, field_element_t *error_roots, field_logarithm_t *error_locations, unsigned int num_errors, unsigned int num_skip) {
     // Skip the first num_skip roots (used for erasure decoding)
     for (unsigned int i = num_skip; i < num_errors; i++) {
-        // the error roots are the reciprocals of the error locations, so div 1 by them
-
-        // we do mod 255 here because the log table aliases at index 1
-        // the log of 1 is both 0 and 255 (alpha^255 = alpha^0 = 1)
-        // for most uses it makes sense to have log(1) = 255, but in this case
-        // we're interested in a byte index, and the 255th index is not even valid
-        // just wrap it back to 0
-
+        // the error roots are the reciprocals of the error locations
+        // the mapping from root to location was tabulated at create
         if (error_roots[i] == 0) {
             continue;
         }
 
-        field_operation_t loc = field_div(field, 1, error_roots[i]);
-        for (field_operation_t j = 0; j < 256; j++) {
-            if (field_pow(field, (field_element_t)j, generator_root_gap) == loc) {
-                error_locations[i] = field->log[j];
-                break;
-            }
-        }
+        error_locations[i] = error_root_location[error_roots[i]];
     }
 }
 
 // erasure method -- take given locations and convert to roots
 // this is the inverse of reed_solomon_find_error_locations
-static void reed_solomon_find_error_roots_from_locations(field_t *field, field_logarithm_t generator_root_gap, const field_logarithm_t *error_locations, field_element_t *error_roots, unsigned int num_errors) {
+static void reed_solomon_find_error_roots_from_locations(const field_element_t *error_location_root, const field_logarithm_t *error_locations, field_element_t *error_roots, unsigned int num_errors) {
     for (unsigned int i = 0; i < num_errors; i++) {
-        field_element_t loc = field_pow(field, field->exp[error_locations[i]], generator_root_gap);
-        // field_element_t loc = field.exp[error_locations[i]];
-        error_roots[i] = field_div(field, 1, loc);
-        // error_roots[i] = loc;
+        error_roots[i] = error_location_root[error_locations[i]];
     }
 }
 
@@ -388,6 +380,20 @@ static inline void correct_reed_solomon_decoder_create(correct_reed_solomon *rs)
         return;
     }
 
+    rs->erasure_pattern = (uint8_t *)malloc(rs->min_distance * sizeof(uint8_t));
+    if (!rs->erasure_pattern) {
+        correct_reed_solomon_destroy(rs);
+        return;
+    }
+
+    // one row per erasure, one column per syndrome
+    // at most min_distance * min_distance bytes, e.g. 32 * 32 = 1k
+    rs->erasure_recovery = (field_logarithm_t *)malloc(rs->min_distance * rs->min_distance * sizeof(field_logarithm_t));
+    if (!rs->erasure_recovery) {
+        correct_reed_solomon_destroy(rs);
+        return;
+    }
+
     rs->has_init_decode = true;
 
     return;
@@ -399,7 +405,7 @@ static inline void correct_reed_solomon_decoder_create(correct_reed_solomon *rs)
  *  -1: Decoding failure
  *  -2: Invalid input length
  */
-ssize_t correct_reed_solomon_decode(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length, uint8_t *msg) {
+static ssize_t reed_solomon_decode(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length, uint8_t *msg) {
     if (!rs || !encoded || !msg || encoded_length > rs->block_length || !is_valid_alloc_size(encoded_length * sizeof(uint8_t))) {
         return -2;
     }
@@ -437,7 +443,9 @@ ssize_t correct_reed_solomon_decode(correct_reed_solomon *rs, const uint8_t *enc
         rs->received_polynomial->coeff[i + encoded_length] = 0;
     }
 
+    uint64_t start = profile_now();
     bool all_zero = reed_solomon_find_syndromes(rs->field, rs->received_polynomial, rs->generator_root_exp, rs->syndromes, rs->min_distance);
+    profile_add(PROFILE_RS_SYNDROMES, start);
 
     if (all_zero) {
         // syndromes were all zero, so there was no error in the message
@@ -449,7 +457,9 @@ ssize_t correct_reed_solomon_decode(correct_reed_solomon *rs, const uint8_t *enc
         return 0;  // No errors were found
     }
 
+    start = profile_now();
     unsigned int order = reed_solomon_find_error_locator(rs, 0);
+    profile_add(PROFILE_RS_BERLEKAMP_MASSEY, start);
     rs->error_locator->order = order;
 
     for (unsigned int i = 0; i <= rs->error_locator->order; i++) {
@@ -457,14 +467,19 @@ ssize_t correct_reed_solomon_decode(correct_reed_solomon *rs, const uint8_t *enc
     }
     rs->error_locator_log->order = rs->error_locator->order;
 
+    start = profile_now();
     if (!reed_solomon_factorize_error_locator(rs->field, 0, rs->error_locator_log, rs->error_roots, rs->element_exp)) {
         // roots couldn't be found or validate failed, so there were too many errors to deal with
+        profile_add(PROFILE_RS_CHIEN, start);
         return -1;
     }
 
-    reed_solomon_find_error_locations(rs->field, rs->generator_root_gap, rs->error_roots, rs->error_locations, rs->error_locator->order, 0);
+    reed_solomon_find_error_locations(rs->error_root_location, rs->error_roots, rs->error_locations, rs->error_locator->order, 0);
+    profile_add(PROFILE_RS_CHIEN, start);
 
+    start = profile_now();
     reed_solomon_find_error_values(rs);
+    profile_add(PROFILE_RS_FORNEY, start);
 
     // Number of errors is equal to the order of the error locator polynomial
     size_t num_errors = rs->error_locator->order;
@@ -482,9 +497,20 @@ ssize_t correct_reed_solomon_decode(correct_reed_solomon *rs, const uint8_t *enc
     return (ssize_t)num_errors;  // Return the number of errors that were corrected
 }
 
-ssize_t correct_reed_solomon_decode_with_erasures(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length, const uint8_t *erasure_locations, size_t erasure_length, uint8_t *msg) {
+ssize_t correct_reed_solomon_decode(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length, uint8_t *msg) {
+    CORRECT_PROBE2(rs_decode_begin, rs, encoded_length);
+    ssize_t result = reed_solomon_decode(rs, encoded, encoded_length, msg);
+    CORRECT_PROBE3(rs_decode_end, rs, encoded_length, result);
+    return result;
+}
+
+// num_corrected is set to the number of symbols corrected, errors and erasures together,
+//   when the decode succeeds
+static ssize_t reed_solomon_decode_with_erasures(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length, const uint8_t *erasure_locations, size_t erasure_length, uint8_t *msg, size_t *num_corrected) {
     if (!erasure_length) {
-        return correct_reed_solomon_decode(rs, encoded, encoded_length, msg);
+        ssize_t num_errors = reed_solomon_decode(rs, encoded, encoded_length, msg);
+        *num_corrected = (num_errors < 0) ? 0 : (size_t)num_errors;
+        return num_errors;
     }
 
     if (encoded_length > rs->block_length) {
@@ -526,11 +552,13 @@ ssize_t correct_reed_solomon_decode_with_erasures(correct_reed_solomon *rs, cons
         rs->error_locations[i] = (field_logarithm_t)(rs->block_length - (erasure_locations[i] + pad_length + 1));
     }
 
-    reed_solomon_find_error_roots_from_locations(rs->field, rs->generator_root_gap, rs->error_locations, rs->error_roots, (unsigned int)erasure_length);
+    reed_solomon_find_error_roots_from_locations(rs->error_location_root, rs->error_locations, rs->error_roots, (unsigned int)erasure_length);
 
     rs->erasure_locator = reed_solomon_find_error_locator_from_roots(rs->field, (unsigned int)erasure_length, rs->error_roots, rs->erasure_locator, rs->init_from_roots_scratch);
 
+    uint64_t start = profile_now();
     bool all_zero = reed_solomon_find_syndromes(rs->field, rs->received_polynomial, rs->generator_root_exp, rs->syndromes, rs->min_distance);
+    profile_add(PROFILE_RS_SYNDROMES, start);
 
     if (all_zero) {
         // syndromes were all zero, so there was no error in the message
@@ -539,6 +567,7 @@ ssize_t correct_reed_solomon_decode_with_erasures(correct_reed_solomon *rs, cons
             msg[i] = rs->received_polynomial->coeff[encoded_length - (i + 1)];
         }
 
+        *num_corrected = 0;
         return msg_length;
     }
 
@@ -555,7 +584,9 @@ ssize_t correct_reed_solomon_decode_with_erasures(correct_reed_solomon *rs, cons
         rs->syndromes[i - erasure_length] = rs->modified_syndromes[i];
     }
 
+    start = profile_now();
     unsigned int order = reed_solomon_find_error_locator(rs, erasure_length);
+    profile_add(PROFILE_RS_BERLEKAMP_MASSEY, start);
     // XXX fix this vvvv
     rs->error_locator->order = order;
 
@@ -575,15 +606,20 @@ ssize_t correct_reed_solomon_decode_with_erasures(correct_reed_solomon *rs, cons
     }
     */
 
+    // the search and the error locations are one stage, as in reed_solomon_decode, so
+    //   the multiplication by the erasure locator between them is timed along with them
+    start = profile_now();
     if (!reed_solomon_factorize_error_locator(rs->field, (unsigned int)erasure_length, rs->error_locator_log, rs->error_roots, rs->element_exp)) {
         // roots couldn't be found, so there were too many errors to deal with
         // RS has failed for this message
+        profile_add(PROFILE_RS_CHIEN, start);
         free(syndrome_copy);
         return -1;
     }
 
     polynomial_t *temp_poly = polynomial_create(rs->error_locator->order + (unsigned int)erasure_length);
     if (!temp_poly) {
+        profile_add(PROFILE_RS_CHIEN, start);
         free(syndrome_copy);
         return -1;
     }
@@ -592,15 +628,19 @@ ssize_t correct_reed_solomon_decode_with_erasures(correct_reed_solomon *rs, cons
     polynomial_t *placeholder_poly = rs->error_locator;
     rs->error_locator = temp_poly;
 
-    reed_solomon_find_error_locations(rs->field, rs->generator_root_gap, rs->error_roots, rs->error_locations, rs->error_locator->order, (unsigned int)erasure_length);
+    reed_solomon_find_error_locations(rs->error_root_location, rs->error_roots, rs->error_locations, rs->error_locator->order, (unsigned int)erasure_length);
+    profile_add(PROFILE_RS_CHIEN, start);
 
     memcpy(rs->syndromes, syndrome_copy, rs->min_distance * sizeof(field_element_t));
 
+    start = profile_now();
     reed_solomon_find_error_values(rs);
+    profile_add(PROFILE_RS_FORNEY, start);
 
     for (unsigned int i = 0; i < rs->error_locator->order; i++) {
         rs->received_polynomial->coeff[rs->error_locations[i]] = field_sub(rs->received_polynomial->coeff[rs->error_locations[i]], rs->error_vals[i]);
     }
+    *num_corrected = rs->error_locator->order;
 
     rs->error_locator = placeholder_poly;
 
@@ -613,3 +653,155 @@ ssize_t correct_reed_solomon_decode_with_erasures(correct_reed_solomon *rs, cons
 
     return msg_length;
 }
+
+ssize_t correct_reed_solomon_decode_with_erasures(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length, const uint8_t *erasure_locations, size_t erasure_length, uint8_t *msg) {
+    CORRECT_PROBE3(rs_decode_erasures_begin, rs, encoded_length, erasure_length);
+    // the probe reports the symbols corrected, like rs_decode_end, rather than the length
+    size_t num_corrected = 0;
+    ssize_t result = reed_solomon_decode_with_erasures(rs, encoded, encoded_length, erasure_locations, erasure_length, msg, &num_corrected);
+    CORRECT_PROBE3(rs_decode_erasures_end, rs, encoded_length, (result < 0) ? result : (ssize_t)num_corrected);
+    return result;
+}
+
+// erasure-only method -- calculate the syndromes straight from the caller's buffer
+// the buffer runs from highest order to lowest order, and any padding is 0, so
+//   we can skip both the reversal into received_polynomial and the padding
+static void reed_solomon_find_syndromes_direct(field_t *field, const uint8_t *encoded, size_t encoded_length, field_logarithm_t **generator_root_exp, field_element_t *syndromes, size_t num_syndromes) {
+    for (unsigned int i = 0; i < num_syndromes; i++) {
+        const field_logarithm_t *root_exp = generator_root_exp[i];
+        field_element_t eval = 0;
+        for (size_t j = 0; j < encoded_length; j++) {
+            field_element_t coeff = encoded[j];
+            if (coeff) {
+                eval = field_add(eval, field_mul_log_element(field, field->log[coeff], root_exp[encoded_length - (j + 1)]));
+            }
+        }
+        syndromes[i] = eval;
+    }
+}
+
+// erasure-only method -- build the matrix which maps syndromes to erasure values
+// with n erasures and no unknown errors, the erasure locator Gamma(x) is known up front
+//   and the error evaluator is omega(x) = S(x)*Gamma(x) mod x^n. expanding forney
+//   for erasure j gives
+//   e(j) = X(j)^(1-c)/Gamma'(X(j)^-1) * sum(k=0, n-1, S(k) * sum(i=k, n-1, Gamma(i-k) * X(j)^-i))
+//   which is linear in the first n syndromes. everything but S(k) depends only on the
+//   erasure pattern, so we store those coefficients (as logs) in erasure_recovery
+// returns false if the pattern can't be recovered e.g. repeated locations
+static bool reed_solomon_build_erasure_recovery(correct_reed_solomon *rs, size_t encoded_length, const uint8_t *erasure_locations, size_t erasure_length) {
+    field_t *field = rs->field;
+    unsigned int num_erasures = (unsigned int)erasure_length;
+
+    for (unsigned int i = 0; i < num_erasures; i++) {
+        if (erasure_locations[i] >= encoded_length) {
+            return false;
+        }
+        // remap the coordinates of the erasures
+        rs->error_locations[i] = (field_logarithm_t)(encoded_length - (erasure_locations[i] + 1));
+    }
+
+    reed_solomon_find_error_roots_from_locations(rs->error_location_root, rs->error_locations, rs->error_roots, num_erasures);
+
+    polynomial_t *erasure_locator = reed_solomon_find_error_locator_from_roots(field, num_erasures, rs->error_roots, rs->erasure_locator, rs->init_from_roots_scratch);
+
+    polynomial_t *derivative = rs->error_locator_derivative;
+    derivative->order = num_erasures - 1;
+    polynomial_formal_derivative(erasure_locator, derivative);
+
+    for (unsigned int j = 0; j < num_erasures; j++) {
+        const field_logarithm_t *root_exp = rs->element_exp[rs->error_roots[j]];
+
+        field_element_t denominator = polynomial_eval_lut(field, derivative, root_exp);
+        if (!denominator) {
+            // Gamma has a repeated root, so this pattern lists a location twice
+            return false;
+        }
+
+        field_element_t scale = field->exp[field_div_log(rs->error_root_scale_log[rs->error_roots[j]], field->log[denominator])];
+
+        field_logarithm_t *row = rs->erasure_recovery + j * num_erasures;
+        for (unsigned int k = 0; k < num_erasures; k++) {
+            field_element_t coeff = 0;
+            for (unsigned int i = k; i < num_erasures; i++) {
+                if (erasure_locator->coeff[i - k]) {
+                    coeff = field_add(coeff, field_mul_log_element(field, field->log[erasure_locator->coeff[i - k]], root_exp[i]));
+                }
+            }
+            // using 0 as a sentinel value in log -- log(0) is really -inf
+            row[k] = field->log[field_mul(field, coeff, scale)];
+        }
+    }
+
+    return true;
+}
+
+ssize_t correct_reed_solomon_decode_erasures_only(correct_reed_solomon *rs, const uint8_t *encoded, size_t encoded_length, const uint8_t *erasure_locations, size_t erasure_length, uint8_t *msg) {
+    if (!rs || !encoded || !msg || encoded_length > rs->block_length || encoded_length <= rs->min_distance) {
+        return -1;
+    }
+
+    if (erasure_length > rs->min_distance || (erasure_length && !erasure_locations)) {
+        return -1;
+    }
+
+    // the message is the non-remainder part
+    size_t msg_length = encoded_length - rs->min_distance;
+
+    if (!rs->has_init_decode) {
+        // initialize rs for decoding
+        correct_reed_solomon_decoder_create(rs);
+    }
+
+    if (!erasure_length) {
+        // nothing was lost, and we've been told not to look for errors
+        memcpy(msg, encoded, msg_length);
+        return msg_length;
+    }
+
+    // rebuild the recovery matrix only when the erasure pattern changes
+    // consecutive blocks from e.g. a lost disk or a lost packet column share a pattern
+    if (!rs->has_erasure_pattern ||
+        rs->erasure_pattern_encoded_length != encoded_length ||
+        rs->erasure_pattern_length != erasure_length ||
+        memcmp(rs->erasure_pattern, erasure_locations, erasure_length) != 0) {
+        rs->has_erasure_pattern = false;
+
+        if (!reed_solomon_build_erasure_recovery(rs, encoded_length, erasure_locations, erasure_length)) {
+            return -1;
+        }
+
+        memcpy(rs->erasure_pattern, erasure_locations, erasure_length);
+        rs->erasure_pattern_length = erasure_length;
+        rs->erasure_pattern_encoded_length = encoded_length;
+        rs->has_erasure_pattern = true;
+    }
+
+    // n erasures only need the first n syndromes
+    reed_solomon_find_syndromes_direct(rs->field, encoded, encoded_length, rs->generator_root_exp, rs->syndromes, erasure_length);
+
+    // take the log of each syndrome once rather than once per erasure
+    field_logarithm_t syndrome_log[256];
+    for (unsigned int k = 0; k < erasure_length; k++) {
+        syndrome_log[k] = rs->field->log[rs->syndromes[k]];
+    }
+
+    memcpy(msg, encoded, msg_length);
+
+    for (unsigned int j = 0; j < erasure_length; j++) {
+        if (erasure_locations[j] >= msg_length) {
+            // parity erasure, the caller doesn't get these bytes back
+            continue;
+        }
+
+        const field_logarithm_t *row = rs->erasure_recovery + j * erasure_length;
+        field_element_t value = 0;
+        for (unsigned int k = 0; k < erasure_length; k++) {
+            if (row[k] && rs->syndromes[k]) {
+                value = field_add(value, field_mul_log_element(rs->field, row[k], syndrome_log[k]));
+            }
+        }
+        msg[erasure_locations[j]] = field_sub(msg[erasure_locations[j]], value);
+    }
+
+    return msg_length;
+}
@@ -32,3 +32,89 @@ ssize_t correct_reed_solomon_encode(correct_reed_solomon *rs, const uint8_t *msg
 
     return rs->block_length;
 }
+
+// incremental encoding
+// rather than reducing a whole message polynomial, we run the remainder as an LFSR and
+//   shift in one message byte at a time, highest order first. virtual padding at the front
+//   of a short block is all 0s and leaves the LFSR untouched, so the final parity is the
+//   same as correct_reed_solomon_encode would produce for the concatenated fragments
+static void reed_solomon_encode_shift(correct_reed_solomon *rs, const uint8_t *fragment, size_t fragment_length) {
+    const field_t *field = rs->field;
+    const field_logarithm_t *generator_log = rs->generator_log;
+    field_element_t *parity = rs->stream_parity;
+    size_t num_roots = rs->min_distance;
+
+    for (size_t i = 0; i < fragment_length; i++) {
+        field_element_t feedback = fragment[i] ^ parity[num_roots - 1];
+        if (!feedback) {
+            memmove(parity + 1, parity, num_roots - 1);
+            parity[0] = 0;
+            continue;
+        }
+
+        field_logarithm_t feedback_log = field->log[feedback];
+        for (size_t j = num_roots - 1; j > 0; j--) {
+            field_element_t term = generator_log[j] ? field_mul_log_element(field, generator_log[j], feedback_log) : 0;
+            parity[j] = parity[j - 1] ^ term;
+        }
+        parity[0] = field_mul_log_element(field, generator_log[0], feedback_log);
+    }
+}
+
+ssize_t correct_reed_solomon_encode_begin(correct_reed_solomon *rs) {
+    if (!rs) {
+        return -1;
+    }
+
+    memset(rs->stream_parity, 0, rs->min_distance);
+    rs->stream_length = 0;
+
+    return 0;
+}
+
+ssize_t correct_reed_solomon_encode_update(correct_reed_solomon *rs, const uint8_t *fragment, size_t fragment_length) {
+    correct_reed_solomon_fragment_t iov = {fragment, fragment_length};
+    return correct_reed_solomon_encode_updatev(rs, &iov, 1);
+}
+
+ssize_t correct_reed_solomon_encode_updatev(correct_reed_solomon *rs, const correct_reed_solomon_fragment_t *fragments, size_t num_fragments) {
+    if (!rs || (num_fragments && !fragments)) {
+        return -1;
+    }
+
+    // validate the whole vector first so that a rejected call leaves the state untouched
+    size_t total_length = rs->stream_length;
+    for (size_t i = 0; i < num_fragments; i++) {
+        if (fragments[i].length && !fragments[i].data) {
+            return -1;
+        }
+
+        if (fragments[i].length > rs->message_length - total_length) {
+            return -1;
+        }
+        total_length += fragments[i].length;
+    }
+
+    for (size_t i = 0; i < num_fragments; i++) {
+        reed_solomon_encode_shift(rs, fragments[i].data, fragments[i].length);
+    }
+    rs->stream_length = total_length;
+
+    return (ssize_t)rs->stream_length;
+}
+
+ssize_t correct_reed_solomon_encode_final(correct_reed_solomon *rs, uint8_t *parity) {
+    if (!rs || !parity) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < rs->min_distance; i++) {
+        parity[i] = rs->stream_parity[rs->min_distance - (i + 1)];
+    }
+
+    // leave the encoder ready for the next block
+    memset(rs->stream_parity, 0, rs->min_distance);
+    rs->stream_length = 0;
+
+    return (ssize_t)rs->min_distance;
+}
@@ -0,0 +1,420 @@
+#include "correct/reed-solomon/int.h"
+
+// below this many symbols, loading the split tables costs more than it saves
+static const size_t split_table_min_length = 32;
+
+static bool correct_reed_solomon_int_decoder_create(correct_reed_solomon_int *rs) {
+    size_t num_roots = rs->min_distance;
+
+    rs->syndromes = (field_int_element_t *)malloc(num_roots * sizeof(field_int_element_t));
+    if (!rs->syndromes) {
+        return false;
+    }
+
+    rs->error_locator = (field_int_element_t *)malloc((num_roots + 1) * sizeof(field_int_element_t));
+    if (!rs->error_locator) {
+        return false;
+    }
+
+    rs->last_error_locator = (field_int_element_t *)malloc((num_roots + 1) * sizeof(field_int_element_t));
+    if (!rs->last_error_locator) {
+        return false;
+    }
+
+    rs->next_error_locator = (field_int_element_t *)malloc((num_roots + 1) * sizeof(field_int_element_t));
+    if (!rs->next_error_locator) {
+        return false;
+    }
+
+    rs->chien_registers = (field_int_logarithm_t *)malloc((num_roots + 1) * sizeof(field_int_logarithm_t));
+    if (!rs->chien_registers) {
+        return false;
+    }
+
+    rs->error_locations = (size_t *)malloc(num_roots * sizeof(size_t));
+    if (!rs->error_locations) {
+        return false;
+    }
+
+    rs->error_vals = (field_int_element_t *)malloc(num_roots * sizeof(field_int_element_t));
+    if (!rs->error_vals) {
+        return false;
+    }
+
+#ifdef HAVE_RS_INT_SPLIT_TABLES
+    // the SIMD kernel evaluates 16 interleaved lanes of the received polynomial at once,
+    //   so each lane steps by root^16. any symbol is the xor of its 4 nibbles, so
+    //   root^16 * symbol is the xor of 4 products, each found by a 16-entry shuffle
+    rs->syndrome_tables = (uint8_t *)ALIGNED_MALLOC(num_roots * 128, 16);
+    if (!rs->syndrome_tables) {
+        return false;
+    }
+
+    const field_int_t *field = rs->field;
+    for (size_t i = 0; i < num_roots; i++) {
+        field_int_logarithm_t step_log = field_int_log_mod(field, 16 * (uint64_t)rs->generator_root_log[i]);
+        uint8_t *tables = rs->syndrome_tables + i * 128;
+        for (unsigned int nibble = 0; nibble < 4; nibble++) {
+            for (field_int_operation_t v = 0; v < 16; v++) {
+                field_int_operation_t x = v << (4 * nibble);
+                field_int_element_t product = (x && x <= field->size) ? field_int_mul_log_element(field, field->log[x], step_log) : 0;
+                tables[nibble * 32 + v] = (uint8_t)(product & 0xff);
+                tables[nibble * 32 + 16 + v] = (uint8_t)(product >> 8);
+            }
+        }
+    }
+#endif
+
+    rs->has_init_decode = true;
+    return true;
+}
+
+// calculate the syndromes of the received block, one at a time, with horner's method
+// the block runs from the highest order coefficient to the lowest, so no reversal is needed
+static void reed_solomon_int_find_syndromes_scalar(const correct_reed_solomon_int *rs, const uint16_t *encoded, size_t encoded_length, field_int_element_t *syndromes) {
+    const field_int_t *field = rs->field;
+    for (size_t i = 0; i < rs->min_distance; i++) {
+        field_int_logarithm_t root_log = rs->generator_root_log[i];
+        field_int_element_t eval = 0;
+        for (size_t j = 0; j < encoded_length; j++) {
+            if (eval) {
+                eval = field_int_mul_log_element(field, field->log[eval], root_log);
+            }
+            eval ^= (field_int_element_t)(encoded[j] & field->size);
+        }
+        syndromes[i] = eval;
+    }
+}
+
+#ifdef HAVE_RS_INT_SPLIT_TABLES
+// multiply 16 symbols, held as two registers of 8, by the constant behind tables
+static inline void reed_solomon_int_split_mul(const __m128i *tables, __m128i *lanes_low, __m128i *lanes_high) {
+    const __m128i byte_mask = _mm_set1_epi16(0x00ff);
+    const __m128i nibble_mask = _mm_set1_epi8(0x0f);
+
+    // gather the low and high bytes of all 16 symbols
+    __m128i low = _mm_packus_epi16(_mm_and_si128(*lanes_low, byte_mask), _mm_and_si128(*lanes_high, byte_mask));
+    __m128i high = _mm_packus_epi16(_mm_srli_epi16(*lanes_low, 8), _mm_srli_epi16(*lanes_high, 8));
+
+    __m128i n0 = _mm_and_si128(low, nibble_mask);
+    __m128i n1 = _mm_and_si128(_mm_srli_epi16(low, 4), nibble_mask);
+    __m128i n2 = _mm_and_si128(high, nibble_mask);
+    __m128i n3 = _mm_and_si128(_mm_srli_epi16(high, 4), nibble_mask);
+
+    __m128i product_low = _mm_xor_si128(
+        _mm_xor_si128(_mm_shuffle_epi8(tables[0], n0), _mm_shuffle_epi8(tables[2], n1)),
+        _mm_xor_si128(_mm_shuffle_epi8(tables[4], n2), _mm_shuffle_epi8(tables[6], n3)));
+    __m128i product_high = _mm_xor_si128(
+        _mm_xor_si128(_mm_shuffle_epi8(tables[1], n0), _mm_shuffle_epi8(tables[3], n1)),
+        _mm_xor_si128(_mm_shuffle_epi8(tables[5], n2), _mm_shuffle_epi8(tables[7], n3)));
+
+    // and interleave the bytes back into 16-bit symbols
+    *lanes_low = _mm_unpacklo_epi8(product_low, product_high);
+    *lanes_high = _mm_unpackhi_epi8(product_low, product_high);
+}
+
+// SIMD syndromes
+// lane l accumulates the symbols at l, l + 16, l + 32... with horner's method in root^16
+//   and the lanes are then combined with the remaining powers root^15...root^0
+// the block is treated as if it had enough leading 0s to make its length a multiple
+//   of 16, which doesn't change the polynomial
+static void reed_solomon_int_find_syndromes_split(const correct_reed_solomon_int *rs, const uint16_t *encoded, size_t encoded_length, field_int_element_t *syndromes) {
+    const field_int_t *field = rs->field;
+    const __m128i symbol_mask = _mm_set1_epi16((short)field->size);
+
+    size_t lead = (16 - encoded_length % 16) % 16;
+    uint16_t first[16] = {0};
+    memcpy(first + lead, encoded, (16 - lead) * sizeof(uint16_t));
+    const uint16_t *rest = encoded + (16 - lead);
+    size_t num_chunks = (encoded_length + lead) / 16 - 1;
+
+    for (size_t i = 0; i < rs->min_distance; i++) {
+        __m128i tables[8];
+        for (unsigned int t = 0; t < 8; t++) {
+            tables[t] = _mm_load_si128((const __m128i *)(rs->syndrome_tables + i * 128 + t * 16));
+        }
+
+        __m128i lanes_low = _mm_and_si128(_mm_loadu_si128((const __m128i *)first), symbol_mask);
+        __m128i lanes_high = _mm_and_si128(_mm_loadu_si128((const __m128i *)(first + 8)), symbol_mask);
+
+        for (size_t c = 0; c < num_chunks; c++) {
+            reed_solomon_int_split_mul(tables, &lanes_low, &lanes_high);
+            lanes_low = _mm_xor_si128(lanes_low, _mm_and_si128(_mm_loadu_si128((const __m128i *)(rest + 16 * c)), symbol_mask));
+            lanes_high = _mm_xor_si128(lanes_high, _mm_and_si128(_mm_loadu_si128((const __m128i *)(rest + 16 * c + 8)), symbol_mask));
+        }
+
+        uint16_t lanes[16];
+        _mm_storeu_si128((__m128i *)lanes, lanes_low);
+        _mm_storeu_si128((__m128i *)(lanes + 8), lanes_high);
+
+        field_int_logarithm_t root_log = rs->generator_root_log[i];
+        field_int_element_t eval = 0;
+        for (unsigned int l = 0; l < 16; l++) {
+            if (eval) {
+                eval = field_int_mul_log_element(field, field->log[eval], root_log);
+            }
+            eval ^= lanes[l];
+        }
+        syndromes[i] = eval;
+    }
+}
+#endif
+
+// returns true if syndromes are all zero
+static bool reed_solomon_int_find_syndromes(const correct_reed_solomon_int *rs, const uint16_t *encoded, size_t encoded_length, field_int_element_t *syndromes) {
+#ifdef HAVE_RS_INT_SPLIT_TABLES
+    if (encoded_length >= split_table_min_length) {
+        reed_solomon_int_find_syndromes_split(rs, encoded, encoded_length, syndromes);
+    } else {
+        reed_solomon_int_find_syndromes_scalar(rs, encoded, encoded_length, syndromes);
+    }
+#else
+    (void)split_table_min_length;
+    reed_solomon_int_find_syndromes_scalar(rs, encoded, encoded_length, syndromes);
+#endif
+
+    for (size_t i = 0; i < rs->min_distance; i++) {
+        if (syndromes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Berlekamp-Massey, seeded with the erasure locator
+// on entry error_locator holds the erasure locator, with num_erasures roots
+// returns the order of the combined errors-and-erasures locator written to error_locator
+static unsigned int reed_solomon_int_find_error_locator(correct_reed_solomon_int *rs, size_t num_erasures) {
+    const field_int_t *field = rs->field;
+    size_t num_roots = rs->min_distance;
+    field_int_element_t *locator = rs->error_locator;
+    field_int_element_t *last_locator = rs->last_error_locator;
+    field_int_element_t *next_locator = rs->next_error_locator;
+    const field_int_element_t *syndromes = rs->syndromes;
+
+    memcpy(last_locator, locator, (num_roots + 1) * sizeof(field_int_element_t));
+    size_t length = num_erasures;
+
+    for (size_t r = num_erasures + 1; r <= num_roots; r++) {
+        field_int_element_t discrepancy = 0;
+        for (size_t j = 0; j < r; j++) {
+            discrepancy ^= field_int_mul(field, locator[j], syndromes[r - (j + 1)]);
+        }
+
+        if (!discrepancy) {
+            // our existing LFSR describes the new syndrome as well
+            // shift the last locator up by one
+            memmove(last_locator + 1, last_locator, num_roots * sizeof(field_int_element_t));
+            last_locator[0] = 0;
+            continue;
+        }
+
+        // next = locator - discrepancy * x * last_locator
+        field_int_logarithm_t discrepancy_log = field->log[discrepancy];
+        next_locator[0] = locator[0];
+        for (size_t j = 0; j < num_roots; j++) {
+            field_int_element_t term = last_locator[j] ? field_int_mul_log_element(field, field->log[last_locator[j]], discrepancy_log) : 0;
+            next_locator[j + 1] = locator[j + 1] ^ term;
+        }
+
+        if (2 * length <= r + num_erasures - 1) {
+            // lengthen the LFSR, and remember locator / discrepancy
+            length = r + num_erasures - length;
+            for (size_t j = 0; j <= num_roots; j++) {
+                last_locator[j] = locator[j] ? field->exp[field_int_div_log(field, field->log[locator[j]], discrepancy_log)] : 0;
+            }
+        } else {
+            memmove(last_locator + 1, last_locator, num_roots * sizeof(field_int_element_t));
+            last_locator[0] = 0;
+        }
+
+        memcpy(locator, next_locator, (num_roots + 1) * sizeof(field_int_element_t));
+    }
+
+    unsigned int order = 0;
+    for (size_t j = 0; j <= num_roots; j++) {
+        if (locator[j]) {
+            order = (unsigned int)j;
+        }
+    }
+    return order;
+}
+
+// Chien search, restricted to the degrees that exist in this (possibly shortened) block
+// the locator has roots at X^-1 = alpha^(-gap * degree). rather than evaluating from scratch,
+//   register j holds log(locator[j] * X^-j) and steps down by gap * j for each degree
+// returns the number of roots found, writing their degrees to error_locations
+static size_t reed_solomon_int_find_error_locations(correct_reed_solomon_int *rs, unsigned int order, size_t encoded_length) {
+    const field_int_t *field = rs->field;
+    field_int_logarithm_t *registers = rs->chien_registers;
+    size_t num_found = 0;
+
+    for (unsigned int j = 0; j <= order; j++) {
+        registers[j] = field->log[rs->error_locator[j]];
+    }
+
+    for (size_t degree = 0; degree < encoded_length; degree++) {
+        field_int_element_t eval = 0;
+        for (unsigned int j = 0; j <= order; j++) {
+            if (registers[j]) {
+                eval ^= field->exp[registers[j]];
+                registers[j] = field_int_div_log(field, registers[j], field_int_log_mod(field, (uint64_t)rs->generator_root_gap * j));
+            }
+        }
+
+        if (!eval) {
+            if (num_found == order) {
+                // more roots than the order allows, can't be a valid locator
+                return order + 1;
+            }
+            rs->error_locations[num_found] = degree;
+            num_found++;
+        }
+    }
+
+    return num_found;
+}
+
+// forney algorithm
+// error value e(j) = X(j)^(1-c) * omega(X(j)^-1) / lambda'(X(j)^-1)
+// where omega(x) = S(x) * lambda(x) mod x^(num_roots)
+// returns false if an error value can't be calculated
+static bool reed_solomon_int_find_error_values(correct_reed_solomon_int *rs, unsigned int order, size_t num_errors) {
+    const field_int_t *field = rs->field;
+
+    // reuse next_error_locator to hold omega, which has order < order of lambda
+    field_int_element_t *evaluator = rs->next_error_locator;
+    for (unsigned int i = 0; i < order; i++) {
+        field_int_element_t coeff = 0;
+        for (unsigned int j = 0; j <= i; j++) {
+            coeff ^= field_int_mul(field, rs->error_locator[j], rs->syndromes[i - j]);
+        }
+        evaluator[i] = coeff;
+    }
+
+    for (size_t k = 0; k < num_errors; k++) {
+        // X^-1 as a log
+        field_int_logarithm_t root_log = field_int_div_log(field, field->size, field_int_log_mod(field, (uint64_t)rs->generator_root_gap * rs->error_locations[k]));
+
+        field_int_element_t numerator = 0;
+        field_int_logarithm_t power = field->size;  // X^-0
+        for (unsigned int i = 0; i < order; i++) {
+            if (evaluator[i]) {
+                numerator ^= field_int_mul_log_element(field, field->log[evaluator[i]], power);
+            }
+            power = field_int_mul_log(field, power, root_log);
+        }
+
+        // in GF(2^m), the formal derivative only keeps the odd powers
+        field_int_element_t denominator = 0;
+        power = field->size;
+        field_int_logarithm_t root_log_squared = field_int_mul_log(field, root_log, root_log);
+        for (unsigned int i = 1; i <= order; i += 2) {
+            if (rs->error_locator[i]) {
+                denominator ^= field_int_mul_log_element(field, field->log[rs->error_locator[i]], power);
+            }
+            power = field_int_mul_log(field, power, root_log_squared);
+        }
+
+        if (!denominator) {
+            return false;
+        }
+
+        // X^(1-c) = (X^-1)^(c-1)
+        field_int_logarithm_t scale = field_int_log_mod(field, (uint64_t)root_log * (uint64_t)(rs->first_consecutive_root + field->size - 1));
+        if (!numerator) {
+            rs->error_vals[k] = 0;
+            continue;
+        }
+        rs->error_vals[k] = field_int_mul_log_element(field, field_int_div_log(field, field->log[numerator], field->log[denominator]), scale);
+    }
+
+    return true;
+}
+
+ssize_t correct_reed_solomon_int_decode_with_erasures(correct_reed_solomon_int *rs, const uint16_t *encoded, size_t encoded_length, const uint16_t *erasure_locations, size_t erasure_length, uint16_t *msg) {
+    if (!rs || !encoded || !msg || encoded_length > rs->block_length || encoded_length <= rs->min_distance) {
+        return -1;
+    }
+
+    if (erasure_length > rs->min_distance || (erasure_length && !erasure_locations)) {
+        return -1;
+    }
+
+    if (!rs->has_init_decode && !correct_reed_solomon_int_decoder_create(rs)) {
+        return -1;
+    }
+
+    const field_int_t *field = rs->field;
+    size_t num_roots = rs->min_distance;
+
+    // the message is the non-remainder part
+    size_t msg_length = encoded_length - num_roots;
+
+    uint64_t start = profile_now();
+    bool all_zero = reed_solomon_int_find_syndromes(rs, encoded, encoded_length, rs->syndromes);
+    profile_add(PROFILE_RS_SYNDROMES, start);
+    if (all_zero) {
+        // syndromes were all zero, so there was no error in the message
+        if (msg != encoded) {
+            memmove(msg, encoded, msg_length * sizeof(uint16_t));
+        }
+        return (ssize_t)msg_length;
+    }
+
+    // build the erasure locator, the product of (1 + X*x) for each erasure
+    field_int_element_t *locator = rs->error_locator;
+    memset(locator, 0, (num_roots + 1) * sizeof(field_int_element_t));
+    locator[0] = 1;
+    for (size_t k = 0; k < erasure_length; k++) {
+        if (erasure_locations[k] >= encoded_length) {
+            return -1;
+        }
+        size_t degree = encoded_length - (erasure_locations[k] + 1);
+        field_int_logarithm_t location_log = field_int_log_mod(field, (uint64_t)rs->generator_root_gap * degree);
+        for (size_t j = k + 1; j > 0; j--) {
+            if (locator[j - 1]) {
+                locator[j] ^= field_int_mul_log_element(field, field->log[locator[j - 1]], location_log);
+            }
+        }
+    }
+
+    start = profile_now();
+    unsigned int order = reed_solomon_int_find_error_locator(rs, erasure_length);
+    profile_add(PROFILE_RS_BERLEKAMP_MASSEY, start);
+    if (order == 0 || order > num_roots) {
+        return -1;
+    }
+
+    start = profile_now();
+    size_t num_errors = reed_solomon_int_find_error_locations(rs, order, encoded_length);
+    profile_add(PROFILE_RS_CHIEN, start);
+    if (num_errors != order) {
+        // roots couldn't be found, so there were too many errors to deal with
+        return -1;
+    }
+
+    start = profile_now();
+    bool found_values = reed_solomon_int_find_error_values(rs, order, num_errors);
+    profile_add(PROFILE_RS_FORNEY, start);
+    if (!found_values) {
+        return -1;
+    }
+
+    if (msg != encoded) {
+        memmove(msg, encoded, msg_length * sizeof(uint16_t));
+    }
+
+    for (size_t k = 0; k < num_errors; k++) {
+        size_t index = encoded_length - (rs->error_locations[k] + 1);
+        if (index < msg_length) {
+            msg[index] = (uint16_t)((msg[index] & field->size) ^ rs->error_vals[k]);
+        }
+    }
+
+    return (ssize_t)msg_length;
+}
+
+ssize_t correct_reed_solomon_int_decode(correct_reed_solomon_int *rs, const uint16_t *encoded, size_t encoded_length, uint16_t *msg) {
+    return correct_reed_solomon_int_decode_with_erasures(rs, encoded, encoded_length, NULL, 0, msg);
+}
@@ -0,0 +1,44 @@
+#include "correct/reed-solomon/int.h"
+
+ssize_t correct_reed_solomon_int_encode(correct_reed_solomon_int *rs, const uint16_t *msg, size_t msg_length, uint16_t *encoded) {
+    if (!rs || !msg || !encoded || msg_length > rs->message_length) {
+        return -1;
+    }
+
+    const field_int_t *field = rs->field;
+    const field_int_logarithm_t *generator_log = rs->generator_log;
+    field_int_element_t *parity = rs->parity;
+    size_t num_roots = rs->min_distance;
+
+    // parity holds the remainder of msg(x) * x^num_roots mod generator(x), lowest order first
+    // we run it as an LFSR, shifting in one message symbol at a time from the highest order
+    // virtual padding at the front of a short block is all 0s and leaves the LFSR untouched
+    memset(parity, 0, num_roots * sizeof(field_int_element_t));
+    for (size_t i = 0; i < msg_length; i++) {
+        field_int_element_t feedback = (field_int_element_t)((msg[i] & field->size) ^ parity[num_roots - 1]);
+        if (!feedback) {
+            memmove(parity + 1, parity, (num_roots - 1) * sizeof(field_int_element_t));
+            parity[0] = 0;
+            continue;
+        }
+
+        field_int_logarithm_t feedback_log = field->log[feedback];
+        for (size_t j = num_roots - 1; j > 0; j--) {
+            field_int_element_t term = generator_log[j] ? field_int_mul_log_element(field, generator_log[j], feedback_log) : 0;
+            parity[j] = parity[j - 1] ^ term;
+        }
+        parity[0] = field_int_mul_log_element(field, generator_log[0], feedback_log);
+    }
+
+    // it is allowable for msg and encoded to be the same pointer
+    // the message goes out masked, so that the high bits the parity ignored aren't sent either
+    for (size_t i = 0; i < msg_length; i++) {
+        encoded[i] = (uint16_t)(msg[i] & field->size);
+    }
+
+    for (size_t i = 0; i < num_roots; i++) {
+        encoded[msg_length + i] = parity[num_roots - (i + 1)];
+    }
+
+    return (ssize_t)(msg_length + num_roots);
+}
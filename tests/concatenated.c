@@ -0,0 +1,232 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "correct.h"
+
+void fail_test(void) {
+    printf("FAILED\n");
+
+    exit(1);
+}
+
+void pass_test(void) {
+    printf("PASSED\n");
+}
+
+// map encoded bits onto soft symbols, then invert roughly 1 in flip_rarity of them
+//   and a burst of burst_length starting at a random symbol
+static void corrupt_to_soft(const uint8_t *encoded, size_t num_encoded_bits, correct_convolutional_soft_t *soft, unsigned int flip_rarity, size_t burst_length) {
+    for (size_t i = 0; i < num_encoded_bits; i++) {
+        uint8_t bit = (encoded[i / 8] >> (7 - (i % 8))) & 1;
+        soft[i] = bit ? 255 : 0;
+        if (flip_rarity && rand() % flip_rarity == 0) {
+            soft[i] = 255 - soft[i];
+        }
+    }
+
+    if (burst_length) {
+        size_t start = (size_t)rand() % (num_encoded_bits - burst_length);
+        for (size_t i = start; i < start + burst_length; i++) {
+            soft[i] = 255 - soft[i];
+        }
+    }
+}
+
+void run_tests(size_t interleave_depth, size_t ring_length, int threaded, unsigned int flip_rarity, size_t burst_length, size_t num_frames) {
+    correct_concatenated *cc = correct_concatenated_create(interleave_depth, ring_length, threaded);
+    if (!cc) {
+        fail_test();
+    }
+
+    printf("testing concatenated depth=%zu, ring=%zu, threaded=%d, flip 1 in %u, burst=%zu...",
+           interleave_depth, ring_length, threaded, flip_rarity, burst_length);
+
+    size_t frame_length = correct_concatenated_frame_len(cc);
+    size_t num_encoded_bits = correct_concatenated_encode_len(cc);
+    uint8_t *frames = (uint8_t *)malloc(ring_length * frame_length);
+    uint8_t *decoded = (uint8_t *)malloc(frame_length);
+    uint8_t *encoded = (uint8_t *)malloc(num_encoded_bits / 8 + 1);
+    correct_convolutional_soft_t *soft = (correct_convolutional_soft_t *)malloc(num_encoded_bits);
+
+    size_t num_pushed = 0;
+    size_t num_popped = 0;
+    size_t corrected = 0;
+    while (num_popped < num_frames) {
+        // keep the ring full, then drain it at the end
+        if (num_pushed < num_frames && num_pushed - num_popped < ring_length) {
+            uint8_t *frame = frames + (num_pushed % ring_length) * frame_length;
+            for (size_t i = 0; i < frame_length; i++) {
+                frame[i] = (uint8_t)(rand() % 256);
+            }
+
+            if (correct_concatenated_encode(cc, frame, encoded) != num_encoded_bits) {
+                fail_test();
+            }
+            corrupt_to_soft(encoded, num_encoded_bits, soft, flip_rarity, burst_length);
+
+            if (correct_concatenated_push_soft(cc, soft) != 0) {
+                fail_test();
+            }
+            num_pushed++;
+            continue;
+        }
+
+        correct_concatenated_stats_t stats;
+        if (correct_concatenated_pop(cc, decoded, &stats) != (ssize_t)frame_length) {
+            fail_test();
+        }
+
+        if (stats.frame_index != num_popped || stats.failed_codewords != 0) {
+            fail_test();
+        }
+
+        if (memcmp(decoded, frames + (num_popped % ring_length) * frame_length, frame_length) != 0) {
+            fail_test();
+        }
+        corrected += stats.corrected_bytes;
+        num_popped++;
+    }
+
+    // nothing is left in flight
+    if (correct_concatenated_pop(cc, decoded, NULL) != -1) {
+        fail_test();
+    }
+
+    // the burst is too long for the inner code, so the outer code must have done some work
+    if (burst_length && !corrected) {
+        fail_test();
+    }
+
+    free(frames);
+    free(decoded);
+    free(encoded);
+    free(soft);
+    correct_concatenated_destroy(cc);
+
+    pass_test();
+}
+
+// a frame buried in noise must be reported, not silently passed along
+void run_failure_tests(int threaded) {
+    correct_concatenated *cc = correct_concatenated_create(2, 2, threaded);
+    size_t frame_length = correct_concatenated_frame_len(cc);
+    size_t num_encoded_bits = correct_concatenated_encode_len(cc);
+    uint8_t *frame = (uint8_t *)malloc(frame_length);
+    uint8_t *encoded = (uint8_t *)malloc(num_encoded_bits / 8 + 1);
+    correct_convolutional_soft_t *soft = (correct_convolutional_soft_t *)malloc(num_encoded_bits);
+
+    printf("testing concatenated failure reporting, threaded=%d...", threaded);
+
+    for (size_t i = 0; i < frame_length; i++) {
+        frame[i] = (uint8_t)(rand() % 256);
+    }
+    correct_concatenated_encode(cc, frame, encoded);
+    corrupt_to_soft(encoded, num_encoded_bits, soft, 2, 0);
+
+    correct_concatenated_stats_t stats;
+    if (correct_concatenated_push_soft(cc, soft) != 0 ||
+        correct_concatenated_pop(cc, frame, &stats) != (ssize_t)frame_length ||
+        stats.failed_codewords == 0) {
+        fail_test();
+    }
+
+    free(frame);
+    free(encoded);
+    free(soft);
+    correct_concatenated_destroy(cc);
+
+    pass_test();
+}
+
+// frames written straight into the pipeline's buffers and read straight out of them,
+//   with a full ring refused rather than waited on in either mode
+void run_zero_copy_tests(size_t ring_length, int threaded, size_t num_frames) {
+    correct_concatenated *cc = correct_concatenated_create(2, ring_length, threaded);
+    size_t frame_length = correct_concatenated_frame_len(cc);
+    size_t num_encoded_bits = correct_concatenated_encode_len(cc);
+    uint8_t *frames = (uint8_t *)malloc(ring_length * frame_length);
+    uint8_t *encoded = (uint8_t *)malloc(num_encoded_bits / 8 + 1);
+    correct_convolutional_soft_t *soft = (correct_convolutional_soft_t *)malloc(num_encoded_bits);
+
+    printf("testing concatenated zero copy, ring=%zu, threaded=%d...", ring_length, threaded);
+
+    if (correct_concatenated_commit_soft(cc) != -1 || correct_concatenated_release(cc) != -1 ||
+        correct_concatenated_peek(cc, NULL) != NULL) {
+        fail_test();
+    }
+
+    for (size_t done = 0; done < num_frames; done += ring_length) {
+        for (size_t n = 0; n < ring_length; n++) {
+            uint8_t *frame = frames + n * frame_length;
+            for (size_t i = 0; i < frame_length; i++) {
+                frame[i] = (uint8_t)(rand() % 256);
+            }
+            correct_concatenated_encode(cc, frame, encoded);
+
+            correct_convolutional_soft_t *slot_soft = correct_concatenated_acquire_soft(cc);
+            if (!slot_soft) {
+                fail_test();
+            }
+            corrupt_to_soft(encoded, num_encoded_bits, slot_soft, 50, 0);
+            if (correct_concatenated_commit_soft(cc) != 0) {
+                fail_test();
+            }
+        }
+
+        memset(soft, 0, num_encoded_bits);
+        if (correct_concatenated_acquire_soft(cc) != NULL || correct_concatenated_push_soft(cc, soft) != -1) {
+            fail_test();
+        }
+
+        for (size_t n = 0; n < ring_length; n++) {
+            correct_concatenated_stats_t stats;
+            const uint8_t *decoded = correct_concatenated_peek(cc, &stats);
+            if (!decoded || stats.frame_index != done + n ||
+                memcmp(decoded, frames + n * frame_length, frame_length) != 0) {
+                fail_test();
+            }
+
+            if (correct_concatenated_release(cc) != 0) {
+                fail_test();
+            }
+        }
+    }
+
+    if (correct_concatenated_peek(cc, NULL) != NULL) {
+        fail_test();
+    }
+
+    free(frames);
+    free(encoded);
+    free(soft);
+    correct_concatenated_destroy(cc);
+
+    pass_test();
+}
+
+int main(void) {
+    srand((unsigned int)time(NULL));
+
+    run_tests(1, 1, 0, 0, 0, 20);
+    run_tests(4, 4, 0, 50, 0, 50);
+    run_tests(4, 4, 0, 0, 200, 50);
+    run_tests(1, 1, 1, 0, 0, 20);
+    run_tests(4, 4, 1, 50, 0, 50);
+    run_tests(5, 8, 1, 0, 200, 100);
+    run_tests(8, 3, 1, 60, 120, 100);
+
+    run_failure_tests(0);
+    run_failure_tests(1);
+
+    run_zero_copy_tests(1, 0, 10);
+    run_zero_copy_tests(3, 0, 30);
+    run_zero_copy_tests(1, 1, 10);
+    run_zero_copy_tests(3, 1, 30);
+
+    printf("test passed\n");
+
+    return 0;
+}
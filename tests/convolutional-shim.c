@@ -65,9 +65,102 @@ void assert_test_result(correct_convolutional *conv, void *fec, ssize_t (*decode
     exit(1);
 }
 
+// decode the same block through the fastest, portable and _sse2 entry points, whole
+//   and in pieces, then again with the first output inverted as libfec's negative
+//   polynomials allow
+void assert_shim_variants(void) {
+    const size_t msg_len = 512;
+    uint8_t *msg = (uint8_t *)malloc(msg_len);
+    for (size_t i = 0; i < msg_len; i++) {
+        msg[i] = rand() % 256;
+    }
+
+    uint16_t poly[] = {V27POLYA, V27POLYB};
+    correct_convolutional *conv = correct_convolutional_create(2, 7, poly);
+    size_t enclen_bits = correct_convolutional_encode_len(conv, msg_len);
+    uint8_t *encoded = (uint8_t *)malloc((enclen_bits + 7) / 8);
+    correct_convolutional_encode(conv, msg, msg_len, encoded);
+
+    uint8_t *soft = (uint8_t *)malloc(enclen_bits);
+    for (size_t i = 0; i < enclen_bits; i++) {
+        soft[i] = ((encoded[i / 8] >> (7 - i % 8)) & 1) ? 255 : 0;
+    }
+    // a few errors that every variant should correct identically
+    for (size_t i = 50; i < enclen_bits; i += 97) {
+        soft[i] = 255 - soft[i];
+    }
+
+    size_t n_decoded_bits = 8 * msg_len;
+    int n_groups = (int)(n_decoded_bits + 6);
+    uint8_t *decoded = (uint8_t *)malloc(msg_len);
+
+    void *(*create[])(int) = {create_viterbi27, create_viterbi27_port, create_viterbi27_sse2};
+    int (*init[])(void *, int) = {init_viterbi27, init_viterbi27_port, init_viterbi27_sse2};
+    int (*update[])(void *, unsigned char *, int) = {update_viterbi27_blk, update_viterbi27_blk_port, update_viterbi27_blk_sse2};
+    int (*chainback[])(void *, unsigned char *, unsigned int, unsigned int) = {chainback_viterbi27, chainback_viterbi27_port, chainback_viterbi27_sse2};
+    void (*destroy[])(void *) = {delete_viterbi27, delete_viterbi27_port, delete_viterbi27_sse2};
+
+    for (size_t v = 0; v < 3; v++) {
+        void *fec = create[v]((int)n_decoded_bits);
+        init[v](fec, 0);
+        update[v](fec, soft, n_groups);
+        memset(decoded, 0, msg_len);
+        chainback[v](fec, decoded, (unsigned int)n_decoded_bits, 0);
+        destroy[v](fec);
+        if (memcmp(msg, decoded, msg_len)) {
+            printf("test failed, shim variant %zu did not decode\n", v);
+            exit(1);
+        }
+    }
+
+    // the same frame handed over in uneven pieces must decode the same way
+    for (size_t v = 0; v < 3; v++) {
+        void *fec = create[v]((int)n_decoded_bits);
+        init[v](fec, 0);
+        for (int done = 0, piece = 1; done < n_groups; done += piece, piece = piece * 3 % 61 + 1) {
+            int len = (piece < n_groups - done) ? piece : n_groups - done;
+            update[v](fec, soft + 2 * done, len);
+        }
+        memset(decoded, 0, msg_len);
+        chainback[v](fec, decoded, (unsigned int)n_decoded_bits, 0);
+        destroy[v](fec);
+        if (memcmp(msg, decoded, msg_len)) {
+            printf("test failed, shim variant %zu did not decode in pieces\n", v);
+            exit(1);
+        }
+    }
+
+    for (size_t i = 0; i < enclen_bits; i += 2) {
+        soft[i] = 255 - soft[i];
+    }
+    set_viterbi27_polynomial((int[]){-V27POLYA, V27POLYB});
+    void *fec = create_viterbi27((int)n_decoded_bits);
+    set_viterbi27_polynomial((int[]){V27POLYA, V27POLYB});
+    init_viterbi27(fec, 0);
+    update_viterbi27_blk(fec, soft, n_groups);
+    memset(decoded, 0, msg_len);
+    chainback_viterbi27(fec, decoded, (unsigned int)n_decoded_bits, 0);
+    delete_viterbi27(fec);
+    if (memcmp(msg, decoded, msg_len)) {
+        printf("test failed, inverted polynomial did not decode\n");
+        exit(1);
+    }
+
+    printf("test passed, shim variants and polynomial inversion\n");
+
+    free(decoded);
+    free(soft);
+    free(encoded);
+    free(msg);
+    correct_convolutional_destroy(conv);
+}
+
 int main(void) {
     srand((unsigned int)time(NULL));
 
+    assert_shim_variants();
+    printf("\n");
+
     conv_testbench *testbench = NULL;
 
     correct_convolutional *conv;
@@ -1,3 +1,4 @@
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -9,6 +10,188 @@ uint32_t retry_count = 5;
 
 size_t max_block_len = 4096;
 
+// when set, test_conv hands each block over in another soft format, and checks that it
+//   decodes exactly as the same symbols do as uint8_t. the packed formats have fewer
+//   levels, so for those the uint8_t symbols are first rounded to the nearest level
+typedef enum {
+    SOFT_INPUT_U8,
+    SOFT_INPUT_S8,
+    SOFT_INPUT_F32,
+    SOFT_INPUT_U4,
+    SOFT_INPUT_U3,
+} soft_input_format_t;
+
+static const char *soft_input_format_names[] = {"uint8_t", "int8_t", "float", "4-bit", "3-bit"};
+
+soft_input_format_t soft_input_format = SOFT_INPUT_U8;
+
+ssize_t conv_decode_soft_input(void *conv_v, uint8_t *soft, size_t soft_len, uint8_t *msg) {
+    correct_convolutional_sse *conv = (correct_convolutional_sse *)conv_v;
+
+    unsigned int packed_bits = (soft_input_format == SOFT_INPUT_U4) ? 4 : (soft_input_format == SOFT_INPUT_U3) ? 3 : 0;
+    uint8_t *packed = NULL;
+    if (packed_bits) {
+        unsigned int top = (1u << packed_bits) - 1;
+        packed = (uint8_t *)calloc((packed_bits * soft_len + 7) / 8, 1);
+        for (size_t i = 0; i < soft_len; i++) {
+            unsigned int level = (soft[i] * top + 127) / 255;
+            soft[i] = (uint8_t)((level * 255 + top / 2) / top);
+            for (unsigned int j = 0; j < packed_bits; j++) {
+                size_t bit = packed_bits * i + j;
+                if ((level >> (packed_bits - 1 - j)) & 1) {
+                    packed[bit / 8] |= (uint8_t)(0x80 >> (bit % 8));
+                }
+            }
+        }
+    }
+
+    ssize_t expected_len = correct_convolutional_sse_decode_soft(conv, soft, soft_len, msg);
+    if (expected_len < 0) {
+        free(packed);
+        return -1;
+    }
+    uint8_t *expected = (uint8_t *)malloc((size_t)expected_len + 1);
+    memcpy(expected, msg, (size_t)expected_len);
+
+    ssize_t decoded_len;
+    if (soft_input_format == SOFT_INPUT_S8) {
+        int8_t *s8 = (int8_t *)malloc(soft_len);
+        for (size_t i = 0; i < soft_len; i++) {
+            s8[i] = (int8_t)(soft[i] - 128);
+        }
+        decoded_len = correct_convolutional_sse_decode_soft_s8(conv, s8, soft_len, msg);
+        free(s8);
+    } else if (soft_input_format == SOFT_INPUT_F32) {
+        // a power of two scale, so that the ratios convert back to exactly the same symbols
+        float *llr = (float *)malloc(soft_len * sizeof(float));
+        for (size_t i = 0; i < soft_len; i++) {
+            llr[i] = (soft[i] - 128) / 32.0f;
+        }
+        decoded_len = correct_convolutional_sse_decode_soft_llr_f32(conv, llr, soft_len, 32.0f, msg);
+        free(llr);
+    } else if (soft_input_format == SOFT_INPUT_U4) {
+        decoded_len = correct_convolutional_sse_decode_soft_u4(conv, packed, soft_len, msg);
+    } else {
+        decoded_len = correct_convolutional_sse_decode_soft_u3(conv, packed, soft_len, msg);
+    }
+    free(packed);
+
+    if (decoded_len != expected_len || memcmp(expected, msg, (size_t)expected_len)) {
+        printf("test failed, %s input decoded differently from uint8_t\n", soft_input_format_names[soft_input_format]);
+        exit(1);
+    }
+    free(expected);
+
+    return decoded_len;
+}
+
+// decode blocks that end in a crc, clean and then with a burst of flipped symbols,
+//   and check that the crc passes exactly when the message comes out right
+void assert_decode_crc(correct_convolutional_sse *conv, correct_crc *crc, size_t crc_len) {
+    uint8_t *msg = (uint8_t *)malloc(max_block_len + crc_len);
+    uint8_t *decoded = (uint8_t *)malloc(2 * (max_block_len + crc_len) + 16);
+    uint8_t *encoded = (uint8_t *)malloc(correct_convolutional_sse_encode_len(conv, max_block_len + crc_len) / 8 + 1);
+    uint8_t *soft = (uint8_t *)malloc(correct_convolutional_sse_encode_len(conv, max_block_len + crc_len));
+
+    for (size_t trial = 0; trial < 40; trial++) {
+        size_t msg_len = 1 + (size_t)rand() % max_block_len;
+        for (size_t i = 0; i < msg_len; i++) {
+            msg[i] = (uint8_t)(rand() % 256);
+        }
+        size_t block_len = correct_crc_append(crc, msg, msg_len);
+
+        size_t num_encoded_bits = correct_convolutional_sse_encode(conv, msg, block_len, encoded);
+        for (size_t i = 0; i < num_encoded_bits; i++) {
+            soft[i] = ((encoded[i / 8] >> (7 - i % 8)) & 1) ? 255 : 0;
+        }
+
+        bool corrupt = trial % 2;
+        if (corrupt) {
+            size_t burst = (num_encoded_bits < 48) ? num_encoded_bits : 48;
+            size_t start = (size_t)rand() % (num_encoded_bits - burst + 1);
+            for (size_t i = start; i < start + burst; i++) {
+                soft[i] = (uint8_t)(255 - soft[i]);
+                encoded[i / 8] ^= (uint8_t)(0x80 >> (i % 8));
+            }
+        }
+
+        for (size_t hard = 0; hard < 2; hard++) {
+            ssize_t res = hard ? correct_convolutional_sse_decode_crc(conv, encoded, num_encoded_bits, crc, decoded)
+                               : correct_convolutional_sse_decode_soft_crc(conv, soft, num_encoded_bits, crc, decoded);
+            bool intact = !memcmp(decoded, msg, block_len);
+            if (res < 0 || (res == 1) != intact || (!corrupt && !intact)) {
+                printf("test failed, crc check returned %d on a %s %s block\n", (int)res, corrupt ? "corrupted" : "clean", hard ? "hard" : "soft");
+                exit(1);
+            }
+        }
+    }
+
+    free(soft);
+    free(encoded);
+    free(decoded);
+    free(msg);
+}
+
+// a team of threads must decode exactly what one thread does, noise and all
+void assert_threads_exact(size_t rate, size_t order, const correct_convolutional_polynomial_t *poly, size_t num_threads) {
+    correct_convolutional_sse *single = correct_convolutional_sse_create(rate, order, poly);
+    correct_convolutional_sse *team = correct_convolutional_sse_create(rate, order, poly);
+    if (correct_convolutional_sse_set_threads(team, num_threads)) {
+        printf("test failed, couldn't start %zu threads\n", num_threads);
+        exit(1);
+    }
+
+    size_t msg_len = 1024;
+    uint8_t *msg = (uint8_t *)malloc(msg_len);
+    for (size_t i = 0; i < msg_len; i++) {
+        msg[i] = rand() % 256;
+    }
+
+    double bpsk_voltage = 1.0/sqrt(2.0);
+    size_t enclen = correct_convolutional_sse_encode_len(single, msg_len);
+    uint8_t *encoded = (uint8_t *)malloc(enclen / 8 + 1);
+    double *v = (double *)malloc(enclen * sizeof(double));
+    double *noise = (double *)malloc(enclen * sizeof(double));
+    uint8_t *soft = (uint8_t *)malloc(enclen);
+    uint8_t *single_out = (uint8_t *)malloc(msg_len);
+    uint8_t *team_out = (uint8_t *)malloc(msg_len);
+    correct_convolutional_sse_encode(single, msg, msg_len, encoded);
+    encode_bpsk(encoded, v, enclen, bpsk_voltage);
+    build_white_noise(noise, enclen, 3.0, 2 * pow(bpsk_voltage, 2.0) * rate);
+    add_white_noise(v, noise, enclen);
+    decode_bpsk_soft(v, soft, enclen, bpsk_voltage);
+
+    // twice, so that the team sleeps and wakes between blocks
+    for (unsigned int pass = 0; pass < 2; pass++) {
+        ssize_t single_len = correct_convolutional_sse_decode_soft(single, soft, enclen, single_out);
+        ssize_t team_len = correct_convolutional_sse_decode_soft(team, soft, enclen, team_out);
+        if (single_len != (ssize_t)msg_len || team_len != single_len || memcmp(single_out, team_out, msg_len)) {
+            printf("test failed, %zu threads decoded differently from one for order %zu\n", num_threads, order);
+            exit(1);
+        }
+    }
+#ifdef CORRECT_CONV_STATS
+    correct_convolutional_stats_t single_stats, team_stats;
+    correct_convolutional_sse_get_stats(single, &single_stats);
+    correct_convolutional_sse_get_stats(team, &team_stats);
+    if (single_stats.blocks != 2 || memcmp(&single_stats, &team_stats, sizeof(single_stats))) {
+        printf("test failed, %zu threads counted differently from one for order %zu\n", num_threads, order);
+        exit(1);
+    }
+#endif
+    printf("test passed, %zu threads decoded as one does for order %zu\n", num_threads, order);
+
+    free(msg);
+    free(encoded);
+    free(v);
+    free(noise);
+    free(soft);
+    free(single_out);
+    free(team_out);
+    correct_convolutional_sse_destroy(single);
+    correct_convolutional_sse_destroy(team);
+}
+
 size_t test_conv(correct_convolutional_sse *conv, conv_testbench **testbench_ptr, size_t msg_len, double eb_n0, double bpsk_bit_energy, double bpsk_voltage) {
     uint8_t *msg = (uint8_t *)malloc(max_block_len);
     size_t num_errors = 0;
@@ -27,6 +210,9 @@ size_t test_conv(correct_convolutional_sse *conv, conv_testbench **testbench_ptr
         testbench->encode = conv_correct_sse_encode;
         testbench->decoder = conv;
         testbench->decode = conv_correct_sse_decode;
+        if (soft_input_format != SOFT_INPUT_U8) {
+            testbench->decode = conv_decode_soft_input;
+        }
         build_white_noise(testbench->noise, testbench->enclen, eb_n0, bpsk_bit_energy);
         num_errors += test_conv_noise(testbench, msg, block_len, bpsk_voltage);
     }
@@ -36,7 +222,7 @@ size_t test_conv(correct_convolutional_sse *conv, conv_testbench **testbench_ptr
     return num_errors;
 }
 
-void assert_test_result(correct_convolutional_sse *conv, conv_testbench **testbench, size_t test_length, size_t rate, size_t order, double eb_n0, double error_rate, uint32_t retries) {
+void assert_test_result(correct_convolutional_sse *conv, conv_testbench **testbench, size_t test_length, double rate, size_t order, double eb_n0, double error_rate, uint32_t retries) {
     double bpsk_voltage = 1.0/sqrt(2.0);
     double bpsk_sym_energy = 2*pow(bpsk_voltage, 2.0);
     double bpsk_bit_energy = bpsk_sym_energy * rate;
@@ -48,7 +234,7 @@ void assert_test_result(correct_convolutional_sse *conv, conv_testbench **testbe
         error_count = test_conv(conv, testbench, test_length, eb_n0, bpsk_bit_energy, bpsk_voltage);
         observed_error_rate = error_count/((double)test_length * 8);
         if (observed_error_rate <= error_rate) {
-            printf("test passed, expected error rate=%.2e, observed error rate=%.2e @%.1fdB for rate %zu order %zu\n",
+            printf("test passed, expected error rate=%.2e, observed error rate=%.2e @%.1fdB for rate %g order %zu\n",
                    error_rate, observed_error_rate, eb_n0, rate, order);
             return;
         }
@@ -56,7 +242,7 @@ void assert_test_result(correct_convolutional_sse *conv, conv_testbench **testbe
         printf("Retry %d/%d: observed error rate=%.2e\n", i + 1, retries, observed_error_rate);
     }
 
-    printf("test failed, expected error rate=%.2e, observed error rate=%.2e @%.1fdB for rate %zu order %zu\n",
+    printf("test failed, expected error rate=%.2e, observed error rate=%.2e @%.1fdB for rate %g order %zu\n",
            error_rate, observed_error_rate, eb_n0, rate, order);
     
     exit(1);
@@ -136,6 +322,124 @@ int main(void) {
 
     printf("\n");
 
+    // rate 3/4, punctured up from the rate 1/2, order 7 code
+    correct_convolutional_puncture *puncture = correct_convolutional_puncture_create(2, correct_conv_puncture_r34, 3);
+    conv = correct_convolutional_sse_create(2, 7, (correct_convolutional_polynomial_t[]){0117, 0155});
+    if (correct_convolutional_sse_set_puncture(conv, puncture)) {
+        printf("test failed, couldn't set puncture pattern\n");
+        exit(1);
+    }
+    correct_convolutional_puncture_destroy(puncture);
+    assert_test_result(conv, &testbench, 1000000, 4.0 / 3.0, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 1000000, 4.0 / 3.0, 7, 5.0, 1e-04, retry_count);
+    correct_convolutional_sse_destroy(conv);
+
+    printf("\n");
+
+    // register exchange in place of the traceback
+    conv = correct_convolutional_sse_create(2, 7, correct_conv_r12_7_polynomial);
+    correct_convolutional_sse_set_survivor_memory(conv, CORRECT_CONV_SURVIVOR_REGISTER_EXCHANGE);
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    correct_convolutional_sse_destroy(conv);
+
+    printf("\n");
+
+    // the quadratic soft metric
+    conv = correct_convolutional_sse_create(2, 7, correct_conv_r12_7_polynomial);
+    correct_convolutional_sse_set_soft_metric(conv, CORRECT_SOFT_QUADRATIC);
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    correct_convolutional_sse_destroy(conv);
+
+    printf("\n");
+
+    // the syndrome pre-check
+    conv = correct_convolutional_sse_create(2, 7, correct_conv_r12_7_polynomial);
+    if (correct_convolutional_sse_set_syndrome_check(conv, 1)) {
+        printf("test failed, couldn't set syndrome check\n");
+        exit(1);
+    }
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    correct_convolutional_sse_destroy(conv);
+
+    printf("\n");
+
+    // the M-algorithm, keeping half of the 64 states
+    conv = correct_convolutional_sse_create(2, 7, correct_conv_r12_7_polynomial);
+    if (correct_convolutional_sse_set_m_algorithm(conv, 32)) {
+        printf("test failed, couldn't set M-algorithm\n");
+        exit(1);
+    }
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 2e-05, retry_count);
+    correct_convolutional_sse_destroy(conv);
+
+    printf("\n");
+
+    // the add-compare-select split across threads, which this runner may have fewer
+    //   cores than, so the blocks are kept short
+    assert_threads_exact(2, 9, correct_conv_r12_9_polynomial, 3);
+    assert_threads_exact(2, 13, (correct_convolutional_polynomial_t[]){016461, 012767}, 4);
+    conv = correct_convolutional_sse_create(2, 9, correct_conv_r12_9_polynomial);
+    correct_convolutional_sse_set_threads(conv, 2);
+    assert_test_result(conv, &testbench, 20000, 2, 9, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 20000, 2, 9, 4.5, 3e-05, retry_count);
+    correct_convolutional_sse_destroy(conv);
+
+    printf("\n");
+
+    // signed and float soft input
+    conv = correct_convolutional_sse_create(2, 7, correct_conv_r12_7_polynomial);
+    soft_input_format = SOFT_INPUT_S8;
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    soft_input_format = SOFT_INPUT_F32;
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    soft_input_format = SOFT_INPUT_U8;
+    correct_convolutional_sse_destroy(conv);
+
+    // packed 4-bit and 3-bit soft input
+    conv = correct_convolutional_sse_create(2, 7, correct_conv_r12_7_polynomial);
+    soft_input_format = SOFT_INPUT_U4;
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    soft_input_format = SOFT_INPUT_U3;
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    soft_input_format = SOFT_INPUT_U8;
+    correct_convolutional_sse_destroy(conv);
+
+    printf("\n");
+
+    // crc checked on the decoder's output
+    correct_crc *crc32c = correct_crc_create_standard(CORRECT_CRC32C);
+    max_block_len = 1024;
+    conv = correct_convolutional_sse_create(2, 7, correct_conv_r12_7_polynomial);
+    assert_decode_crc(conv, crc32c, 4);
+    correct_convolutional_sse_set_syndrome_check(conv, 1);
+    assert_decode_crc(conv, crc32c, 4);
+    correct_convolutional_sse_destroy(conv);
+    max_block_len = 16;
+    conv = correct_convolutional_sse_create(2, 7, correct_conv_r12_7_polynomial);
+    correct_convolutional_sse_set_tail_biting(conv, 1, 2);
+    assert_decode_crc(conv, crc32c, 4);
+    correct_convolutional_sse_destroy(conv);
+    correct_crc_destroy(crc32c);
+    max_block_len = 4096;
+
+    // tail-biting, in short packets
+    max_block_len = 16;
+    conv = correct_convolutional_sse_create(2, 7, correct_conv_r12_7_polynomial);
+    correct_convolutional_sse_set_tail_biting(conv, 1, 2);
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    correct_convolutional_sse_destroy(conv);
+
+    printf("\n");
+
     free_scratch(testbench);
 
     return 0;
@@ -1,3 +1,4 @@
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -10,6 +11,354 @@ uint32_t retry_count = 5;
 
 size_t max_block_len = 4096;
 
+// when active, test_conv decodes each block through a low-delay stream
+typedef struct {
+    bool active;
+    size_t delay;
+    size_t order;
+    correct_convolutional *conv;
+    uint8_t *bits;
+    uint8_t *tail;
+} stream_test_t;
+
+stream_test_t stream_test = {false, 0, 0, NULL, NULL, NULL};
+
+static void copy_bits(uint8_t *dst, size_t dst_offset, const uint8_t *src, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        size_t j = dst_offset + i;
+        uint8_t bit = (src[i / 8] >> (7 - i % 8)) & 1;
+        dst[j / 8] = (uint8_t)((dst[j / 8] & ~(0x80 >> (j % 8))) | (bit << (7 - j % 8)));
+    }
+}
+
+ssize_t conv_stream_decode(void *stream_v, uint8_t *soft, size_t soft_len, uint8_t *msg) {
+    stream_test_t *stream = (stream_test_t *)stream_v;
+    stream->bits = (uint8_t *)realloc(stream->bits, soft_len / 8 + 1);
+    stream->tail = (uint8_t *)realloc(stream->tail, stream->delay / 8 + 1);
+
+    // feed the block over two calls, so that the stream carries on across them
+    size_t split = (soft_len / 2) - (soft_len / 2) % 2;
+    ssize_t head_len = correct_convolutional_stream_decode_soft(stream->conv, soft, split, stream->bits);
+    ssize_t body_len = correct_convolutional_stream_decode_soft(stream->conv, soft + split, soft_len - split, stream->bits + soft_len / 16 + 1);
+    ssize_t tail_len = correct_convolutional_stream_end(stream->conv, stream->tail);
+    if (head_len < 0 || body_len < 0 || tail_len < 0) {
+        return -1;
+    }
+
+    // everything but the zero tail is message
+    size_t total_len = (size_t)(head_len + body_len + tail_len);
+    size_t msg_len = (total_len - (stream->order + 1)) / 8;
+    uint8_t *decoded = (uint8_t *)calloc(total_len / 8 + 1, 1);
+    copy_bits(decoded, 0, stream->bits, (size_t)head_len);
+    copy_bits(decoded, (size_t)head_len, stream->bits + soft_len / 16 + 1, (size_t)body_len);
+    copy_bits(decoded, (size_t)(head_len + body_len), stream->tail, (size_t)tail_len);
+    memcpy(msg, decoded, msg_len);
+    free(decoded);
+
+    return (ssize_t)msg_len;
+}
+
+// when set, test_conv encodes and decodes with this sequential decoder instead of conv
+correct_convolutional_sequential *sequential_test = NULL;
+bool sequential_test_hard = false;
+
+size_t conv_sequential_enclen(void *seq_v, size_t msg_len) {
+    return correct_convolutional_sequential_encode_len((correct_convolutional_sequential *)seq_v, msg_len);
+}
+
+void conv_sequential_encode(void *seq_v, uint8_t *msg, size_t msg_len, uint8_t *encoded) {
+    correct_convolutional_sequential_encode((correct_convolutional_sequential *)seq_v, msg, msg_len, encoded);
+}
+
+ssize_t conv_sequential_decode(void *seq_v, uint8_t *soft, size_t soft_len, uint8_t *msg) {
+    correct_convolutional_sequential *seq = (correct_convolutional_sequential *)seq_v;
+    if (!sequential_test_hard) {
+        return correct_convolutional_sequential_decode_soft(seq, soft, soft_len, msg);
+    }
+
+    uint8_t *hard = (uint8_t *)calloc(soft_len / 8 + 1, 1);
+    for (size_t i = 0; i < soft_len; i++) {
+        hard[i / 8] |= (uint8_t)((soft[i] >> 7) << (7 - i % 8));
+    }
+    ssize_t res = correct_convolutional_sequential_decode(seq, hard, soft_len, msg);
+    free(hard);
+    return res;
+}
+
+// a sequential encoder for a code of order 16 or less writes what conv does
+void assert_sequential_encode(size_t rate, size_t order, const correct_convolutional_polynomial_t *poly) {
+    correct_convolutional_long_polynomial_t long_poly[8];
+    for (size_t k = 0; k < rate; k++) {
+        long_poly[k] = poly[k];
+    }
+    correct_convolutional *conv = correct_convolutional_create(rate, order, poly);
+    correct_convolutional_sequential *seq = correct_convolutional_sequential_create(rate, order, long_poly);
+
+    size_t msg_len = 100;
+    uint8_t msg[100];
+    for (size_t i = 0; i < msg_len; i++) {
+        msg[i] = rand() % 256;
+    }
+    size_t enclen = correct_convolutional_encode_len(conv, msg_len);
+    uint8_t *encoded = (uint8_t *)calloc(enclen / 8 + 1, 1);
+    uint8_t *seq_encoded = (uint8_t *)calloc(enclen / 8 + 1, 1);
+    correct_convolutional_encode(conv, msg, msg_len, encoded);
+    if (correct_convolutional_sequential_encode_len(seq, msg_len) != enclen ||
+        correct_convolutional_sequential_encode(seq, msg, msg_len, seq_encoded) != enclen ||
+        memcmp(encoded, seq_encoded, enclen / 8 + 1)) {
+        printf("test failed, sequential encoder differs for rate %zu order %zu\n", rate, order);
+        exit(1);
+    }
+    printf("test passed, sequential encoder matches for rate %zu order %zu\n", rate, order);
+
+    free(encoded);
+    free(seq_encoded);
+    correct_convolutional_sequential_destroy(seq);
+    correct_convolutional_destroy(conv);
+}
+
+// a block far below what the code can decode spends its whole budget, and fails
+void assert_sequential_budget(correct_convolutional_sequential *seq) {
+    size_t msg_len = 64;
+    uint8_t msg[64];
+    size_t enclen = correct_convolutional_sequential_encode_len(seq, msg_len);
+    uint8_t *soft = (uint8_t *)malloc(enclen);
+    for (size_t i = 0; i < enclen; i++) {
+        soft[i] = rand() % 256;
+    }
+    correct_convolutional_sequential_set_compute_budget(seq, 2);
+    if (correct_convolutional_sequential_decode_soft(seq, soft, enclen, msg) != -1) {
+        printf("test failed, sequential decoder decoded noise within its budget\n");
+        exit(1);
+    }
+    printf("test passed, sequential decoder gave up on noise\n");
+    free(soft);
+}
+
+// when set, test_conv hands each block over in another soft format, and checks that it
+//   decodes exactly as the same symbols do as uint8_t. the packed formats have fewer
+//   levels, so for those the uint8_t symbols are first rounded to the nearest level
+typedef enum {
+    SOFT_INPUT_U8,
+    SOFT_INPUT_S8,
+    SOFT_INPUT_F32,
+    SOFT_INPUT_U4,
+    SOFT_INPUT_U3,
+} soft_input_format_t;
+
+static const char *soft_input_format_names[] = {"uint8_t", "int8_t", "float", "4-bit", "3-bit"};
+
+soft_input_format_t soft_input_format = SOFT_INPUT_U8;
+
+ssize_t conv_decode_soft_input(void *conv_v, uint8_t *soft, size_t soft_len, uint8_t *msg) {
+    correct_convolutional *conv = (correct_convolutional *)conv_v;
+
+    unsigned int packed_bits = (soft_input_format == SOFT_INPUT_U4) ? 4 : (soft_input_format == SOFT_INPUT_U3) ? 3 : 0;
+    uint8_t *packed = NULL;
+    if (packed_bits) {
+        unsigned int top = (1u << packed_bits) - 1;
+        packed = (uint8_t *)calloc((packed_bits * soft_len + 7) / 8, 1);
+        for (size_t i = 0; i < soft_len; i++) {
+            unsigned int level = (soft[i] * top + 127) / 255;
+            soft[i] = (uint8_t)((level * 255 + top / 2) / top);
+            for (unsigned int j = 0; j < packed_bits; j++) {
+                size_t bit = packed_bits * i + j;
+                if ((level >> (packed_bits - 1 - j)) & 1) {
+                    packed[bit / 8] |= (uint8_t)(0x80 >> (bit % 8));
+                }
+            }
+        }
+    }
+
+    ssize_t expected_len = correct_convolutional_decode_soft(conv, soft, soft_len, msg);
+    if (expected_len < 0) {
+        free(packed);
+        return -1;
+    }
+    uint8_t *expected = (uint8_t *)malloc((size_t)expected_len + 1);
+    memcpy(expected, msg, (size_t)expected_len);
+
+    ssize_t decoded_len;
+    if (soft_input_format == SOFT_INPUT_S8) {
+        int8_t *s8 = (int8_t *)malloc(soft_len);
+        for (size_t i = 0; i < soft_len; i++) {
+            s8[i] = (int8_t)(soft[i] - 128);
+        }
+        decoded_len = correct_convolutional_decode_soft_s8(conv, s8, soft_len, msg);
+        free(s8);
+    } else if (soft_input_format == SOFT_INPUT_F32) {
+        // a power of two scale, so that the ratios convert back to exactly the same symbols
+        float *llr = (float *)malloc(soft_len * sizeof(float));
+        for (size_t i = 0; i < soft_len; i++) {
+            llr[i] = (soft[i] - 128) / 32.0f;
+        }
+        decoded_len = correct_convolutional_decode_soft_llr_f32(conv, llr, soft_len, 32.0f, msg);
+        free(llr);
+    } else if (soft_input_format == SOFT_INPUT_U4) {
+        decoded_len = correct_convolutional_decode_soft_u4(conv, packed, soft_len, msg);
+    } else {
+        decoded_len = correct_convolutional_decode_soft_u3(conv, packed, soft_len, msg);
+    }
+    free(packed);
+
+    if (decoded_len != expected_len || memcmp(expected, msg, (size_t)expected_len)) {
+        printf("test failed, %s input decoded differently from uint8_t\n", soft_input_format_names[soft_input_format]);
+        exit(1);
+    }
+    free(expected);
+
+    return decoded_len;
+}
+
+// check a crc against the check value for "123456789" from the crc catalogues
+static void assert_crc_check_value(correct_crc *crc, uint32_t check) {
+    const uint8_t digits[] = "123456789";
+    if (!crc || correct_crc_compute(crc, digits, 9) != check) {
+        printf("test failed, crc of 123456789 should be %08x\n", check);
+        exit(1);
+    }
+    correct_crc_destroy(crc);
+}
+
+// decode blocks that end in a crc, clean and then with a burst of flipped symbols,
+//   and check that the crc passes exactly when the message comes out right
+void assert_decode_crc(correct_convolutional *conv, correct_crc *crc, size_t crc_len) {
+    uint8_t *msg = (uint8_t *)malloc(max_block_len + crc_len);
+    uint8_t *decoded = (uint8_t *)malloc(2 * (max_block_len + crc_len) + 16);
+    uint8_t *encoded = (uint8_t *)malloc(correct_convolutional_encode_len(conv, max_block_len + crc_len) / 8 + 1);
+    uint8_t *soft = (uint8_t *)malloc(correct_convolutional_encode_len(conv, max_block_len + crc_len));
+
+    for (size_t trial = 0; trial < 40; trial++) {
+        size_t msg_len = 1 + (size_t)rand() % max_block_len;
+        for (size_t i = 0; i < msg_len; i++) {
+            msg[i] = (uint8_t)(rand() % 256);
+        }
+        size_t block_len = correct_crc_append(crc, msg, msg_len);
+
+        size_t num_encoded_bits = correct_convolutional_encode(conv, msg, block_len, encoded);
+        for (size_t i = 0; i < num_encoded_bits; i++) {
+            soft[i] = ((encoded[i / 8] >> (7 - i % 8)) & 1) ? 255 : 0;
+        }
+
+        bool corrupt = trial % 2;
+        if (corrupt) {
+            size_t burst = (num_encoded_bits < 48) ? num_encoded_bits : 48;
+            size_t start = (size_t)rand() % (num_encoded_bits - burst + 1);
+            for (size_t i = start; i < start + burst; i++) {
+                soft[i] = (uint8_t)(255 - soft[i]);
+                encoded[i / 8] ^= (uint8_t)(0x80 >> (i % 8));
+            }
+        }
+
+        for (size_t hard = 0; hard < 2; hard++) {
+            ssize_t res = hard ? correct_convolutional_decode_crc(conv, encoded, num_encoded_bits, crc, decoded)
+                               : correct_convolutional_decode_soft_crc(conv, soft, num_encoded_bits, crc, decoded);
+            bool intact = !memcmp(decoded, msg, block_len);
+            if (res < 0 || (res == 1) != intact || (!corrupt && !intact)) {
+                printf("test failed, crc check returned %d on a %s %s block\n", (int)res, corrupt ? "corrupted" : "clean", hard ? "hard" : "soft");
+                exit(1);
+            }
+        }
+    }
+
+    free(soft);
+    free(encoded);
+    free(decoded);
+    free(msg);
+}
+
+// decode a block with a few hard errors, far enough apart that every one is corrected,
+//   and check the counters. the winning path is the one sent, so its metric is exactly
+//   the number of errors. register exchange survivors never trace back
+void assert_stats(correct_convolutional *conv, size_t rate, size_t num_flips, bool traceback) {
+    correct_convolutional_stats_t stats;
+#ifndef CORRECT_CONV_STATS
+    if (correct_convolutional_get_stats(conv, &stats) != -1 || correct_convolutional_reset_stats(conv) != -1) {
+        printf("test failed, stats reported without CORRECT_CONV_STATS\n");
+        exit(1);
+    }
+    printf("test passed, stats compiled out\n");
+#else
+    size_t msg_len = 256;
+    uint8_t *msg = (uint8_t *)malloc(msg_len);
+    uint8_t *encoded = (uint8_t *)malloc(correct_convolutional_encode_len(conv, msg_len) / 8 + 1);
+    uint8_t *decoded = (uint8_t *)malloc(2 * msg_len + 16);
+    for (size_t i = 0; i < msg_len; i++) {
+        msg[i] = (uint8_t)(rand() % 256);
+    }
+
+    size_t num_encoded_bits = correct_convolutional_encode(conv, msg, msg_len, encoded);
+    for (size_t i = 0; i < num_flips; i++) {
+        size_t bit = (i + 1) * num_encoded_bits / (num_flips + 1);
+        encoded[bit / 8] ^= (uint8_t)(0x80 >> (bit % 8));
+    }
+
+    correct_convolutional_reset_stats(conv);
+    ssize_t decoded_len = correct_convolutional_decode(conv, encoded, num_encoded_bits, decoded);
+    if (decoded_len < (ssize_t)msg_len || memcmp(decoded, msg, msg_len)) {
+        printf("test failed, couldn't decode the block for stats\n");
+        exit(1);
+    }
+
+    if (correct_convolutional_get_stats(conv, &stats)) {
+        printf("test failed, no stats with CORRECT_CONV_STATS\n");
+        exit(1);
+    }
+    if (stats.blocks != 1 || stats.steps != num_encoded_bits / rate || !stats.renormalizations || !stats.tracebacks != !traceback ||
+        stats.last_path_metric != num_flips || stats.metric_growth != stats.last_path_metric) {
+        printf("test failed, stats blocks=%llu steps=%llu renormalizations=%llu tracebacks=%llu growth=%llu metric=%llu\n",
+               (unsigned long long)stats.blocks, (unsigned long long)stats.steps,
+               (unsigned long long)stats.renormalizations, (unsigned long long)stats.tracebacks,
+               (unsigned long long)stats.metric_growth, (unsigned long long)stats.last_path_metric);
+        exit(1);
+    }
+
+    correct_convolutional_reset_stats(conv);
+    correct_convolutional_get_stats(conv, &stats);
+    if (stats.blocks || stats.steps || stats.metric_growth) {
+        printf("test failed, stats weren't reset\n");
+        exit(1);
+    }
+    printf("test passed, stats count %zu errors in a block\n", num_flips);
+
+    free(decoded);
+    free(encoded);
+    free(msg);
+#endif
+}
+
+// the stage timers count every call in the profiling build, and aren't there otherwise
+void assert_profile(void) {
+    correct_profile_stage_t stages[16];
+    ssize_t num_stages = correct_profile_dump(stages, sizeof(stages) / sizeof(stages[0]));
+#ifndef CORRECT_PROFILE
+    if (num_stages != -1 || correct_profile_reset() != -1) {
+        printf("test failed, stages profiled without CORRECT_PROFILE\n");
+        exit(1);
+    }
+    printf("test passed, profiling compiled out\n");
+#else
+    uint64_t acs_calls = 0;
+    for (ssize_t i = 0; i < num_stages; i++) {
+        acs_calls = strcmp(stages[i].name, "conv_acs") ? acs_calls : stages[i].calls;
+    }
+    if (num_stages <= 0 || !acs_calls) {
+        printf("test failed, no add-compare-select in the profile\n");
+        exit(1);
+    }
+
+    correct_profile_reset();
+    correct_profile_dump(stages, sizeof(stages) / sizeof(stages[0]));
+    for (ssize_t i = 0; i < num_stages; i++) {
+        if (stages[i].calls || stages[i].ticks) {
+            printf("test failed, %s wasn't reset\n", stages[i].name);
+            exit(1);
+        }
+    }
+    printf("test passed, profiled %llu add-compare-selects\n", (unsigned long long)acs_calls);
+#endif
+}
+
 size_t test_conv(correct_convolutional *conv, conv_testbench **testbench_ptr, size_t msg_len, double eb_n0, double bpsk_bit_energy, double bpsk_voltage) {
     uint8_t *msg = (uint8_t *)malloc(max_block_len);
     size_t num_errors = 0;
@@ -22,12 +371,32 @@ size_t test_conv(correct_convolutional *conv, conv_testbench **testbench_ptr, si
             msg[j] = rand() % 256;
         }
 
+        if (sequential_test) {
+            *testbench_ptr = resize_conv_testbench(*testbench_ptr, conv_sequential_enclen, sequential_test, block_len);
+            conv_testbench *testbench = *testbench_ptr;
+            testbench->encoder = sequential_test;
+            testbench->encode = conv_sequential_encode;
+            testbench->decoder = sequential_test;
+            testbench->decode = conv_sequential_decode;
+            build_white_noise(testbench->noise, testbench->enclen, eb_n0, bpsk_bit_energy);
+            num_errors += test_conv_noise(testbench, msg, block_len, bpsk_voltage);
+            continue;
+        }
+
         *testbench_ptr = resize_conv_testbench(*testbench_ptr, conv_correct_enclen, conv, block_len);
         conv_testbench *testbench = *testbench_ptr;
         testbench->encoder = conv;
         testbench->encode = conv_correct_encode;
         testbench->decoder = conv;
         testbench->decode = conv_correct_decode;
+        if (soft_input_format != SOFT_INPUT_U8) {
+            testbench->decode = conv_decode_soft_input;
+        }
+        if (stream_test.active) {
+            stream_test.conv = conv;
+            testbench->decoder = &stream_test;
+            testbench->decode = conv_stream_decode;
+        }
         build_white_noise(testbench->noise, testbench->enclen, eb_n0, bpsk_bit_energy);
         num_errors += test_conv_noise(testbench, msg, block_len, bpsk_voltage);
     }
@@ -37,7 +406,7 @@ size_t test_conv(correct_convolutional *conv, conv_testbench **testbench_ptr, si
     return num_errors;
 }
 
-void assert_test_result(correct_convolutional *conv, conv_testbench **testbench, size_t test_length, size_t rate, size_t order, double eb_n0, double error_rate, uint32_t retries) {
+void assert_test_result(correct_convolutional *conv, conv_testbench **testbench, size_t test_length, double rate, size_t order, double eb_n0, double error_rate, uint32_t retries) {
     double bpsk_voltage = 1.0/sqrt(2.0);
     double bpsk_sym_energy = 2*pow(bpsk_voltage, 2.0);
     double bpsk_bit_energy = bpsk_sym_energy * rate;
@@ -49,7 +418,7 @@ void assert_test_result(correct_convolutional *conv, conv_testbench **testbench,
         error_count = test_conv(conv, testbench, test_length, eb_n0, bpsk_bit_energy, bpsk_voltage);
         observed_error_rate = error_count/((double)test_length * 8);
         if (observed_error_rate <= error_rate) {
-            printf("test passed, expected error rate=%.2e, observed error rate=%.2e @%.1fdB for rate %zu order %zu\n",
+            printf("test passed, expected error rate=%.2e, observed error rate=%.2e @%.1fdB for rate %g order %zu\n",
                    error_rate, observed_error_rate, eb_n0, rate, order);
             return;
         }
@@ -57,12 +426,74 @@ void assert_test_result(correct_convolutional *conv, conv_testbench **testbench,
         printf("Retry %d/%d: observed error rate=%.2e\n", i + 1, retries, observed_error_rate);
     }
 
-    printf("test failed, expected error rate=%.2e, observed error rate=%.2e @%.1fdB for rate %zu order %zu\n",
+    printf("test failed, expected error rate=%.2e, observed error rate=%.2e @%.1fdB for rate %g order %zu\n",
            error_rate, observed_error_rate, eb_n0, rate, order);
 
     exit(1);
 }
 
+// encoded bits are packed highest first. a final byte with fewer than 8 bits keeps them at
+//   the top and 0s below. the decoders don't care where they are, so only a bit by bit
+//   comparison with a reference encoder shows a misplaced one
+// without puncturing, the last two time slices of the tail are always 0s, and a short
+//   final byte holds nothing else at rate 1/3. a punctured code can leave message bits there
+void assert_encode_partial_byte(size_t rate, size_t order, const correct_convolutional_polynomial_t *poly, const uint8_t *pattern, size_t period) {
+    correct_convolutional *conv = correct_convolutional_create(rate, order, poly);
+    if (pattern) {
+        correct_convolutional_puncture *puncture = correct_convolutional_puncture_create(rate, pattern, period);
+        correct_convolutional_set_puncture(conv, puncture);
+        correct_convolutional_puncture_destroy(puncture);
+    }
+    uint8_t msg[4];
+    uint8_t encoded[64];
+
+    for (size_t msg_len = 1; msg_len <= sizeof(msg); msg_len++) {
+        for (size_t i = 0; i < msg_len; i++) {
+            msg[i] = rand() % 256;
+        }
+
+        size_t num_encoded_bits = correct_convolutional_encode_len(conv, msg_len);
+        memset(encoded, 0xa5, sizeof(encoded));
+        if (correct_convolutional_encode(conv, msg, msg_len, encoded) != num_encoded_bits) {
+            printf("test failed, rate %zu order %zu encoded the wrong number of bits\n", rate, order);
+            exit(1);
+        }
+
+        // the message, then a tail of order + 1 0s, shifted through the register a bit at a time
+        size_t index = 0;
+        unsigned int shiftregister = 0;
+        for (size_t set = 0; set < 8 * msg_len + order + 1; set++) {
+            unsigned int bit = (set < 8 * msg_len) ? (msg[set / 8] >> (7 - set % 8)) & 1 : 0;
+            shiftregister = ((shiftregister << 1) | bit) & ((1u << order) - 1);
+            for (size_t j = 0; j < rate; j++) {
+                if (pattern && !pattern[(set % period) * rate + j]) {
+                    continue;
+                }
+
+                unsigned int expected = 0;
+                for (unsigned int taps = shiftregister & poly[j]; taps; taps >>= 1) {
+                    expected ^= taps & 1;
+                }
+                if (((encoded[index / 8] >> (7 - index % 8)) & 1) != expected) {
+                    printf("test failed, rate %zu order %zu encoded bit %zu of %zu wrong\n", rate, order, index, num_encoded_bits);
+                    exit(1);
+                }
+                index++;
+            }
+        }
+
+        for (; index % 8; index++) {
+            if ((encoded[index / 8] >> (7 - index % 8)) & 1) {
+                printf("test failed, rate %zu order %zu padding bit %zu set\n", rate, order, index);
+                exit(1);
+            }
+        }
+    }
+    printf("test passed, rate %zu order %zu%s final partial byte\n", rate, order, pattern ? " punctured" : "");
+
+    correct_convolutional_destroy(conv);
+}
+
 int main(void) {
     srand((unsigned int)time(NULL));
 
@@ -70,6 +501,11 @@ int main(void) {
 
     correct_convolutional *conv;
 
+    assert_encode_partial_byte(3, 6, correct_conv_r13_6_polynomial, NULL, 0);
+    assert_encode_partial_byte(2, 7, correct_conv_r12_7_polynomial, correct_conv_puncture_r34, 3);
+
+    printf("\n");
+
     // n.b. the error rates below are at 5.0dB/4.5dB for order 6 polys
     //  and 4.5dB/4.0dB for order 7-9 polys. this can be easy to miss.
 
@@ -85,6 +521,91 @@ int main(void) {
     assert_test_result(conv, &testbench, 1000000, 2, 7, INFINITY, 0, retry_count);
     assert_test_result(conv, &testbench, 1000000, 2, 7, 4.5, 1e-05, retry_count);
     assert_test_result(conv, &testbench, 1000000, 2, 7, 4.0, 5e-05, retry_count);
+    // a longer traceback, swapped in after the decoder is already set up
+    if (correct_convolutional_set_traceback(conv, 7 * 7, 30 * 7)) {
+        printf("test failed, couldn't set traceback\n");
+        exit(1);
+    }
+    assert_test_result(conv, &testbench, 1000000, 2, 7, 4.0, 5e-05, retry_count);
+    correct_convolutional_destroy(conv);
+
+    printf("\n");
+
+    // register exchange in place of the traceback
+    conv = correct_convolutional_create(2, 7, correct_conv_r12_7_polynomial);
+    correct_convolutional_set_survivor_memory(conv, CORRECT_CONV_SURVIVOR_REGISTER_EXCHANGE);
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.0, 5e-05, retry_count);
+    correct_convolutional_destroy(conv);
+
+    printf("\n");
+
+    // the quadratic soft metric
+    conv = correct_convolutional_create(2, 7, correct_conv_r12_7_polynomial);
+    correct_convolutional_set_soft_metric(conv, CORRECT_SOFT_QUADRATIC);
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.0, 5e-05, retry_count);
+    correct_convolutional_destroy(conv);
+
+    printf("\n");
+
+    // the syndrome pre-check, which takes every clean block and hands the rest to viterbi
+    conv = correct_convolutional_create(2, 7, correct_conv_r12_7_polynomial);
+    if (correct_convolutional_set_syndrome_check(conv, 1)) {
+        printf("test failed, couldn't set syndrome check\n");
+        exit(1);
+    }
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    correct_convolutional_destroy(conv);
+    conv = correct_convolutional_create(3, 7, correct_conv_r13_7_polynomial);
+    correct_convolutional_set_syndrome_check(conv, 1);
+    assert_test_result(conv, &testbench, 200000, 3, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 3, 7, 4.5, 5e-06, retry_count);
+    correct_convolutional_destroy(conv);
+
+    printf("\n");
+
+    // the M-algorithm, keeping half of the 64 states
+    conv = correct_convolutional_create(2, 7, correct_conv_r12_7_polynomial);
+    if (correct_convolutional_set_m_algorithm(conv, 32)) {
+        printf("test failed, couldn't set M-algorithm\n");
+        exit(1);
+    }
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 2e-05, retry_count);
+    correct_convolutional_destroy(conv);
+
+    printf("\n");
+
+    // signed and float soft input, the float through a punctured code
+    conv = correct_convolutional_create(2, 7, correct_conv_r12_7_polynomial);
+    soft_input_format = SOFT_INPUT_S8;
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    correct_convolutional_destroy(conv);
+
+    correct_convolutional_puncture *llr_puncture = correct_convolutional_puncture_create(2, correct_conv_puncture_r34, 3);
+    conv = correct_convolutional_create(2, 7, (correct_convolutional_polynomial_t[]){0117, 0155});
+    correct_convolutional_set_puncture(conv, llr_puncture);
+    correct_convolutional_puncture_destroy(llr_puncture);
+    soft_input_format = SOFT_INPUT_F32;
+    assert_test_result(conv, &testbench, 200000, 4.0 / 3.0, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 4.0 / 3.0, 7, 5.0, 1e-04, retry_count);
+    soft_input_format = SOFT_INPUT_U8;
+    correct_convolutional_destroy(conv);
+
+    // packed 4-bit and 3-bit soft input
+    conv = correct_convolutional_create(2, 7, correct_conv_r12_7_polynomial);
+    soft_input_format = SOFT_INPUT_U4;
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    soft_input_format = SOFT_INPUT_U3;
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    soft_input_format = SOFT_INPUT_U8;
     correct_convolutional_destroy(conv);
 
     printf("\n");
@@ -137,6 +658,123 @@ int main(void) {
 
     printf("\n");
 
+    // punctured up from the rate 1/2, order 7 code, so the inverse rates are fractional
+    const correct_convolutional_polynomial_t punctured_poly[] = {0117, 0155};
+    const uint8_t *patterns[] = {correct_conv_puncture_r23, correct_conv_puncture_r34, correct_conv_puncture_r56, correct_conv_puncture_r78};
+    const size_t periods[] = {2, 3, 5, 7};
+    const double error_rates[] = {2e-05, 1e-04, 4e-04, 2e-03};
+    for (size_t i = 0; i < 4; i++) {
+        correct_convolutional_puncture *puncture = correct_convolutional_puncture_create(2, patterns[i], periods[i]);
+        conv = correct_convolutional_create(2, 7, punctured_poly);
+        if (correct_convolutional_set_puncture(conv, puncture)) {
+            printf("test failed, couldn't set puncture pattern\n");
+            exit(1);
+        }
+        correct_convolutional_puncture_destroy(puncture);
+
+        double inv_rate = (double)(periods[i] + 1) / (double)periods[i];
+        assert_test_result(conv, &testbench, 1000000, inv_rate, 7, INFINITY, 0, retry_count);
+        assert_test_result(conv, &testbench, 1000000, inv_rate, 7, 5.0, error_rates[i], retry_count);
+        correct_convolutional_destroy(conv);
+    }
+
+    printf("\n");
+
+    // crc checked on the decoder's output
+    assert_crc_check_value(correct_crc_create_standard(CORRECT_CRC16_CCITT), 0x29b1);
+    assert_crc_check_value(correct_crc_create_standard(CORRECT_CRC32), 0xcbf43926);
+    assert_crc_check_value(correct_crc_create_standard(CORRECT_CRC32C), 0xe3069283);
+    assert_crc_check_value(correct_crc_create(16, 0x1021, 0, 0, 1), 0x2189);
+    assert_crc_check_value(correct_crc_create(24, 0x864cfb, 0xb704ce, 0, 0), 0x21cf02);
+
+    correct_crc *crc16 = correct_crc_create_standard(CORRECT_CRC16_CCITT);
+    correct_crc *crc32 = correct_crc_create_standard(CORRECT_CRC32);
+    max_block_len = 1024;
+    conv = correct_convolutional_create(2, 7, correct_conv_r12_7_polynomial);
+    assert_decode_crc(conv, crc16, 2);
+    assert_decode_crc(conv, crc32, 4);
+    correct_convolutional_set_syndrome_check(conv, 1);
+    assert_decode_crc(conv, crc32, 4);
+    correct_convolutional_destroy(conv);
+    conv = correct_convolutional_create(2, 4, (correct_convolutional_polynomial_t[]){017, 015});
+    assert_decode_crc(conv, crc32, 4);
+    correct_convolutional_destroy(conv);
+    max_block_len = 16;
+    conv = correct_convolutional_create(2, 7, correct_conv_r12_7_polynomial);
+    correct_convolutional_set_tail_biting(conv, 1, 2);
+    assert_decode_crc(conv, crc32, 4);
+    correct_convolutional_destroy(conv);
+    correct_crc_destroy(crc16);
+    correct_crc_destroy(crc32);
+    max_block_len = 4096;
+
+    // tail-biting, in short packets where the tail would otherwise cost the most
+    max_block_len = 16;
+    conv = correct_convolutional_create(2, 7, correct_conv_r12_7_polynomial);
+    correct_convolutional_set_tail_biting(conv, 1, 2);
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.0, 5e-05, retry_count);
+    correct_convolutional_destroy(conv);
+
+    printf("\n");
+
+    // a low-delay stream, with a delay as long as the block decoder's traceback
+    max_block_len = 4096;
+    conv = correct_convolutional_create(2, 7, correct_conv_r12_7_polynomial);
+    if (correct_convolutional_stream_begin(conv, 5 * 7)) {
+        printf("test failed, couldn't begin stream\n");
+        exit(1);
+    }
+    stream_test.active = true;
+    stream_test.delay = 5 * 7;
+    stream_test.order = 7;
+    assert_test_result(conv, &testbench, 200000, 2, 7, INFINITY, 0, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.5, 1e-05, retry_count);
+    assert_test_result(conv, &testbench, 200000, 2, 7, 4.0, 5e-05, retry_count);
+    stream_test.active = false;
+    correct_convolutional_destroy(conv);
+    free(stream_test.bits);
+    free(stream_test.tail);
+
+    printf("\n");
+
+    // decoder event counters, with the history buffer, register exchange and m-algorithm
+    conv = correct_convolutional_create(2, 7, correct_conv_r12_7_polynomial);
+    assert_stats(conv, 2, 12, true);
+    correct_convolutional_set_m_algorithm(conv, 64);
+    assert_stats(conv, 2, 12, true);
+    correct_convolutional_destroy(conv);
+    conv = correct_convolutional_create(3, 4, (correct_convolutional_polynomial_t[]){017, 015, 013});
+    assert_stats(conv, 3, 8, false);
+    correct_convolutional_destroy(conv);
+    assert_profile();
+
+    printf("\n");
+
+    // the sequential decoder, for orders no trellis search reaches, in frames of 2048 bits
+    assert_sequential_encode(2, 7, correct_conv_r12_7_polynomial);
+    assert_sequential_encode(3, 9, correct_conv_r13_9_polynomial);
+    assert_sequential_encode(2, 16, (correct_convolutional_polynomial_t[]){0x8f57, 0xd6b3});
+    max_block_len = 256;
+    sequential_test = correct_convolutional_sequential_create(2, 32, correct_conv_r12_32_polynomial);
+    assert_test_result(NULL, &testbench, 200000, 2, 32, INFINITY, 0, retry_count);
+    assert_test_result(NULL, &testbench, 200000, 2, 32, 4.0, 0, retry_count);
+    sequential_test_hard = true;
+    assert_test_result(NULL, &testbench, 200000, 2, 32, INFINITY, 0, retry_count);
+    assert_test_result(NULL, &testbench, 200000, 2, 32, 6.0, 0, retry_count);
+    sequential_test_hard = false;
+    assert_sequential_budget(sequential_test);
+    correct_convolutional_sequential_destroy(sequential_test);
+    sequential_test = correct_convolutional_sequential_create(2, 64, (correct_convolutional_long_polynomial_t[]){0xf2d05351e4613c47ULL, 0xe4613c47f2d05353ULL});
+    assert_test_result(NULL, &testbench, 200000, 2, 64, INFINITY, 0, retry_count);
+    assert_test_result(NULL, &testbench, 200000, 2, 64, 4.0, 0, retry_count);
+    correct_convolutional_sequential_destroy(sequential_test);
+    sequential_test = NULL;
+    max_block_len = 4096;
+
+    printf("\n");
+
     free_scratch(testbench);
     return 0;
 }
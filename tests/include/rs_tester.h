@@ -10,6 +10,9 @@ void rs_correct_encode(void *encoder, uint8_t *msg, size_t msg_length,
 void rs_correct_decode(void *decoder, uint8_t *encoded, size_t encoded_length,
                        uint8_t *erasure_locations, size_t erasure_length,
                        uint8_t *msg, size_t pad_length, size_t num_roots);
+void rs_correct_decode_erasures_only(void *decoder, uint8_t *encoded, size_t encoded_length,
+                                     uint8_t *erasure_locations, size_t erasure_length,
+                                     uint8_t *msg, size_t pad_length, size_t num_roots);
 
 typedef struct {
     size_t block_length;
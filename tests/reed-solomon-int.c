@@ -0,0 +1,260 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "correct.h"
+#include "fec_shim.h"
+
+void print_test_type(unsigned int symbol_size, size_t block_length, size_t message_length, size_t num_errors, size_t num_erasures) {
+    printf(
+        "testing reed solomon symbol size=%u, block length=%zu, message length=%zu, errors=%zu, erasures=%zu...",
+        symbol_size, block_length, message_length, num_errors, num_erasures
+    );
+}
+
+void fail_test(void) {
+    printf("FAILED\n");
+
+    exit(1);
+}
+
+void pass_test(void) {
+    printf("PASSED\n");
+}
+
+// pick num distinct indices in [0, len)
+static void shuffle_locations(size_t *indices, size_t len, uint16_t *locations, size_t num) {
+    for (size_t i = 0; i < len; i++) {
+        indices[i] = i;
+    }
+
+    for (size_t i = 0; i < num; i++) {
+        size_t j = i + (size_t)rand() % (len - i);
+        size_t t = indices[i];
+        indices[i] = indices[j];
+        indices[j] = t;
+        locations[i] = (uint16_t)indices[i];
+    }
+}
+
+static uint16_t rand_symbol(uint16_t mask) {
+    return (uint16_t)(((unsigned int)rand() ^ ((unsigned int)rand() << 8)) & mask);
+}
+
+void run_tests(correct_reed_solomon_int *rs, unsigned int symbol_size, size_t test_msg_length, size_t num_roots, size_t num_errors, size_t num_erasures, size_t num_iterations) {
+    uint16_t mask = (uint16_t)((1U << symbol_size) - 1);
+    size_t block_length = mask;
+    size_t encoded_length = test_msg_length + num_roots;
+
+    uint16_t *msg = (uint16_t *)malloc(test_msg_length * sizeof(uint16_t));
+    uint16_t *encoded = (uint16_t *)malloc(encoded_length * sizeof(uint16_t));
+    uint16_t *recvmsg = (uint16_t *)malloc(test_msg_length * sizeof(uint16_t));
+    size_t *indices = (size_t *)malloc(encoded_length * sizeof(size_t));
+    uint16_t *locations = (uint16_t *)malloc((num_errors + num_erasures) * sizeof(uint16_t));
+
+    print_test_type(symbol_size, block_length, test_msg_length, num_errors, num_erasures);
+
+    for (size_t i = 0; i < num_iterations; i++) {
+        for (size_t j = 0; j < test_msg_length; j++) {
+            msg[j] = rand_symbol(mask);
+        }
+
+        if (correct_reed_solomon_int_encode(rs, msg, test_msg_length, encoded) != (ssize_t)encoded_length) {
+            fail_test();
+        }
+
+        // the first num_erasures locations are erased, the rest are undeclared errors
+        shuffle_locations(indices, encoded_length, locations, num_errors + num_erasures);
+        for (size_t j = 0; j < num_errors + num_erasures; j++) {
+            uint16_t corruption = rand_symbol(mask);
+            if (j >= num_erasures && !corruption) {
+                corruption = 1;
+            }
+            encoded[locations[j]] ^= corruption;
+        }
+
+        ssize_t res = correct_reed_solomon_int_decode_with_erasures(rs, encoded, encoded_length, locations, num_erasures, recvmsg);
+        if (res != (ssize_t)test_msg_length || memcmp(msg, recvmsg, test_msg_length * sizeof(uint16_t)) != 0) {
+            fail_test();
+        }
+    }
+
+    free(msg);
+    free(encoded);
+    free(recvmsg);
+    free(indices);
+    free(locations);
+
+    pass_test();
+}
+
+void run_code_tests(unsigned int symbol_size, uint32_t primitive_polynomial, size_t num_roots, size_t num_iterations) {
+    correct_reed_solomon_int *rs = correct_reed_solomon_int_create(symbol_size, primitive_polynomial, 1, 1, num_roots);
+    if (!rs) {
+        printf("could not create symbol size=%u code\n", symbol_size);
+        fail_test();
+    }
+
+    size_t message_length = ((1U << symbol_size) - 1) - num_roots;
+    size_t short_length = (num_roots < 8) ? 2 : 8;
+
+    run_tests(rs, symbol_size, short_length, num_roots, 0, 0, num_iterations);
+    run_tests(rs, symbol_size, message_length, num_roots, 0, 0, num_iterations);
+    run_tests(rs, symbol_size, short_length, num_roots, num_roots / 2, 0, num_iterations);
+    run_tests(rs, symbol_size, message_length / 2, num_roots, num_roots / 2, 0, num_iterations);
+    run_tests(rs, symbol_size, message_length, num_roots, num_roots / 2, 0, num_iterations);
+    run_tests(rs, symbol_size, message_length / 2, num_roots, 0, num_roots, num_iterations);
+    run_tests(rs, symbol_size, message_length, num_roots, 0, num_roots, num_iterations);
+    run_tests(rs, symbol_size, message_length, num_roots, num_roots / 4, num_roots / 2, num_iterations);
+
+    correct_reed_solomon_int_destroy(rs);
+}
+
+// with 8-bit symbols, the generic code must produce the same parity as the GF(2^8) code
+void run_compat_tests(size_t num_roots, size_t num_iterations) {
+    correct_reed_solomon *rs8 = correct_reed_solomon_create(correct_rs_primitive_polynomial_ccsds, 1, 1, num_roots);
+    correct_reed_solomon_int *rs = correct_reed_solomon_int_create(8, correct_rs_primitive_polynomial_ccsds, 1, 1, num_roots);
+    size_t message_length = 255 - num_roots;
+
+    uint8_t msg8[255];
+    uint8_t encoded8[255];
+    uint16_t msg[255];
+    uint16_t encoded[255];
+
+    printf("testing reed solomon symbol size=8 matches 8-bit code, roots=%zu...", num_roots);
+
+    for (size_t i = 0; i < num_iterations; i++) {
+        for (size_t j = 0; j < message_length; j++) {
+            msg8[j] = (uint8_t)(rand() % 256);
+            msg[j] = msg8[j];
+        }
+
+        correct_reed_solomon_encode(rs8, msg8, message_length, encoded8);
+        correct_reed_solomon_int_encode(rs, msg, message_length, encoded);
+
+        for (size_t j = 0; j < message_length + num_roots; j++) {
+            if (encoded[j] != encoded8[j]) {
+                fail_test();
+            }
+        }
+    }
+
+    correct_reed_solomon_destroy(rs8);
+    correct_reed_solomon_int_destroy(rs);
+
+    pass_test();
+}
+
+// bits above symbol_size in the message must not reach the codeword, whether or not
+//   encoding happens in place
+void run_mask_tests(unsigned int symbol_size, uint32_t primitive_polynomial, size_t num_roots, size_t num_iterations) {
+    correct_reed_solomon_int *rs = correct_reed_solomon_int_create(symbol_size, primitive_polynomial, 1, 1, num_roots);
+    uint16_t mask = (uint16_t)((1U << symbol_size) - 1);
+    size_t message_length = mask - num_roots;
+    uint16_t *msg = (uint16_t *)malloc(mask * sizeof(uint16_t));
+    uint16_t *encoded = (uint16_t *)malloc(mask * sizeof(uint16_t));
+    uint16_t *inplace = (uint16_t *)malloc(mask * sizeof(uint16_t));
+    uint16_t *recvmsg = (uint16_t *)malloc(message_length * sizeof(uint16_t));
+
+    printf("testing reed solomon symbol size=%u ignores high bits...", symbol_size);
+
+    for (size_t i = 0; i < num_iterations; i++) {
+        for (size_t j = 0; j < message_length; j++) {
+            msg[j] = (uint16_t)(rand_symbol(mask) | (rand_symbol(0xffff) & ~mask));
+            inplace[j] = msg[j];
+        }
+
+        if (correct_reed_solomon_int_encode(rs, msg, message_length, encoded) != (ssize_t)mask ||
+            correct_reed_solomon_int_encode(rs, inplace, message_length, inplace) != (ssize_t)mask) {
+            fail_test();
+        }
+
+        for (size_t j = 0; j < mask; j++) {
+            if (encoded[j] != inplace[j] || (encoded[j] & ~mask) ||
+                (j < message_length && encoded[j] != (msg[j] & mask))) {
+                fail_test();
+            }
+        }
+
+        if (correct_reed_solomon_int_decode(rs, encoded, mask, recvmsg) != (ssize_t)message_length ||
+            memcmp(recvmsg, encoded, message_length * sizeof(uint16_t)) != 0) {
+            fail_test();
+        }
+    }
+
+    free(msg);
+    free(encoded);
+    free(inplace);
+    free(recvmsg);
+    correct_reed_solomon_int_destroy(rs);
+
+    pass_test();
+}
+
+void run_shim_tests(unsigned int symbol_size, uint32_t primitive_polynomial, size_t num_roots, size_t pad, size_t num_iterations) {
+    void *fec_rs = init_rs_int((int)symbol_size, (int)primitive_polynomial, 1, 1, (int)num_roots, (int)pad);
+    if (!fec_rs) {
+        fail_test();
+    }
+
+    uint16_t mask = (uint16_t)((1U << symbol_size) - 1);
+    size_t block_length = mask - pad;
+    size_t message_length = block_length - num_roots;
+    int *block = (int *)malloc(block_length * sizeof(int));
+    int *msg = (int *)malloc(message_length * sizeof(int));
+    int erasures[2];
+
+    printf("testing reed solomon shim symbol size=%u, pad=%zu...", symbol_size, pad);
+
+    for (size_t i = 0; i < num_iterations; i++) {
+        for (size_t j = 0; j < message_length; j++) {
+            msg[j] = rand_symbol(mask);
+            block[j] = msg[j];
+        }
+
+        encode_rs_int(fec_rs, block, block + message_length);
+
+        // one declared erasure and one undeclared error
+        size_t erased = (size_t)rand() % block_length;
+        size_t errored = (erased + 1 + (size_t)rand() % (block_length - 1)) % block_length;
+        block[erased] ^= rand_symbol(mask);
+        block[errored] ^= 1;
+        erasures[0] = (int)(erased + pad);
+
+        if (decode_rs_int(fec_rs, block, erasures, 1) < 0 || memcmp(msg, block, message_length * sizeof(int)) != 0) {
+            fail_test();
+        }
+    }
+
+    free(block);
+    free(msg);
+    free_rs_int(fec_rs);
+
+    pass_test();
+}
+
+int main(void) {
+    srand((unsigned int)time(NULL));
+
+    run_code_tests(4, correct_rs_primitive_polynomial_4_1_0, 4, 2000);
+    run_code_tests(8, correct_rs_primitive_polynomial_ccsds, 32, 2000);
+    run_code_tests(8, correct_rs_primitive_polynomial_8_4_3_2_0, 16, 2000);
+    run_code_tests(10, correct_rs_primitive_polynomial_10_3_0, 32, 500);
+    run_code_tests(12, correct_rs_primitive_polynomial_12_6_4_1_0, 64, 50);
+    run_code_tests(16, correct_rs_primitive_polynomial_16_12_3_1_0, 32, 4);
+
+    run_compat_tests(32, 2000);
+    run_compat_tests(16, 2000);
+
+    run_mask_tests(4, correct_rs_primitive_polynomial_4_1_0, 4, 2000);
+    run_mask_tests(10, correct_rs_primitive_polynomial_10_3_0, 16, 200);
+
+    run_shim_tests(10, correct_rs_primitive_polynomial_10_3_0, 16, 0, 200);
+    run_shim_tests(12, correct_rs_primitive_polynomial_12_6_4_1_0, 16, 3000, 200);
+
+    printf("test passed\n");
+
+    return 0;
+}
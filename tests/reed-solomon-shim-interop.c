@@ -57,6 +57,78 @@ void run_tests(correct_reed_solomon *rs, void *fec_rs, rs_testbench *testbench,
     pass_test();
 }
 
+// encode_rs_8 and decode_rs_8 must agree with a general CCSDS instance, and the
+//   dual-basis pair must round trip through errors and erasures
+void run_fixed_tests(size_t pad_length, size_t num_errors, size_t num_erasures, size_t num_iterations) {
+    const size_t num_roots = 32;
+    size_t msg_length = 223 - pad_length;
+    size_t block_length = msg_length + num_roots;
+    void *fec_rs = init_rs_char(8, correct_rs_primitive_polynomial_ccsds, 112, 11, (int)num_roots, (unsigned int)pad_length);
+
+    uint8_t block[255];
+    uint8_t sent[255];
+    uint8_t parity[32];
+    int erasures[32];
+
+    printf("testing fixed ccsds reed solomon pad=%zu, errors=%zu, erasures=%zu...", pad_length, num_errors, num_erasures);
+    for (size_t i = 0; i < num_iterations; i++) {
+        for (size_t j = 0; j < msg_length; j++) {
+            block[j] = rand() % 256;
+        }
+
+        encode_rs_8(block, block + msg_length, (int)pad_length);
+        encode_rs_char(fec_rs, block, parity);
+        if (memcmp(parity, block + msg_length, num_roots)) {
+            fail_test();
+        }
+
+        for (int dual = 0; dual < 2; dual++) {
+            if (dual) {
+                encode_rs_ccsds(block, block + msg_length, (int)pad_length);
+            }
+            memcpy(sent, block, block_length);
+
+            // corrupt distinct positions, the first num_erasures of them marked
+            for (size_t j = 0; j < num_errors + num_erasures; j++) {
+                size_t pos;
+                bool seen;
+                do {
+                    pos = (size_t)rand() % block_length;
+                    seen = false;
+                    for (size_t k = 0; k < j; k++) {
+                        seen = seen || erasures[k] == (int)(pos + pad_length);
+                    }
+                } while (seen);
+                erasures[j] = (int)(pos + pad_length);
+                block[pos] ^= (uint8_t)(1 + rand() % 255);
+            }
+
+            int res = dual ? decode_rs_ccsds(block, erasures, (int)num_erasures, (int)pad_length)
+                           : decode_rs_8(block, erasures, (int)num_erasures, (int)pad_length);
+            // every corrupted symbol is counted, and the parity is repaired too
+            if (res != (int)(num_errors + num_erasures) || memcmp(sent, block, block_length)) {
+                fail_test();
+            }
+
+            // an erasure outside the shortened block is refused
+            if (num_erasures) {
+                int bad_erasure = erasures[0];
+                erasures[0] = pad_length ? (int)pad_length - 1 : 255;
+                res = dual ? decode_rs_ccsds(block, erasures, (int)num_erasures, (int)pad_length)
+                           : decode_rs_8(block, erasures, (int)num_erasures, (int)pad_length);
+                if (res != -1) {
+                    fail_test();
+                }
+                erasures[0] = bad_erasure;
+            }
+            memcpy(block, sent, block_length);
+        }
+    }
+    pass_test();
+
+    free_rs_char(fec_rs);
+}
+
 int main(void) {
     srand((unsigned int)time(NULL));
 
@@ -112,6 +184,11 @@ int main(void) {
     rs_testbench_destroy(testbench);
     correct_reed_solomon_destroy(rs);
 
+    run_fixed_tests(0, 0, 0, 2000);
+    run_fixed_tests(0, 16, 0, 2000);
+    run_fixed_tests(100, 8, 16, 2000);
+    run_fixed_tests(0, 0, 32, 2000);
+
     printf("test passed\n");
 
     return 0;
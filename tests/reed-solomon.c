@@ -42,6 +42,222 @@ void run_tests(correct_reed_solomon *rs, rs_testbench *testbench, size_t block_l
     pass_test();
 }
 
+void run_erasure_only_tests(correct_reed_solomon *rs, rs_testbench *testbench, size_t block_length, size_t test_msg_length, size_t num_erasures, size_t num_iterations) {
+    rs_test test;
+
+    test.encode = rs_correct_encode;
+    test.decode = rs_correct_decode_erasures_only;
+    test.encoder = rs;
+    test.decoder = rs;
+    print_test_type(block_length, test_msg_length, 0, num_erasures);
+
+    for (size_t i = 0; i < num_iterations; i++) {
+        rs_test_run run = test_rs_errors(&test, testbench, test_msg_length, 0, num_erasures);
+        if (!run.output_matches) {
+            fail_test();
+        }
+    }
+
+    pass_test();
+}
+
+// same erasure pattern on every block, as from a lost disk
+// exercises the reuse of the erasure-only recovery matrix
+void run_erasure_pattern_tests(correct_reed_solomon *rs, size_t block_length, size_t test_msg_length, size_t num_roots, size_t num_erasures, size_t num_iterations) {
+    size_t encoded_length = test_msg_length + num_roots;
+    uint8_t *msg = (uint8_t *)malloc(test_msg_length);
+    uint8_t *encoded = (uint8_t *)malloc(encoded_length);
+    uint8_t *recvmsg = (uint8_t *)malloc(test_msg_length);
+    uint8_t *erasure_locations = (uint8_t *)malloc(num_erasures);
+
+    for (size_t i = 0; i < num_erasures; i++) {
+        erasure_locations[i] = (uint8_t)((i * encoded_length) / num_erasures);
+    }
+
+    printf("testing reed solomon block length=%zu, message length=%zu, fixed erasures=%zu...",
+           block_length, test_msg_length, num_erasures);
+
+    for (size_t i = 0; i < num_iterations; i++) {
+        for (size_t j = 0; j < test_msg_length; j++) {
+            msg[j] = (uint8_t)(rand() % 256);
+        }
+
+        correct_reed_solomon_encode(rs, msg, test_msg_length, encoded);
+
+        for (size_t j = 0; j < num_erasures; j++) {
+            encoded[erasure_locations[j]] = (uint8_t)(rand() % 256);
+        }
+
+        ssize_t res = correct_reed_solomon_decode_erasures_only(rs, encoded, encoded_length, erasure_locations, num_erasures, recvmsg);
+        if (res != (ssize_t)test_msg_length || memcmp(msg, recvmsg, test_msg_length) != 0) {
+            fail_test();
+        }
+    }
+
+    free(msg);
+    free(encoded);
+    free(recvmsg);
+    free(erasure_locations);
+
+    pass_test();
+}
+
+// feed the message in random fragments, the parity must match a one-shot encode
+void run_stream_tests(correct_reed_solomon *rs, size_t block_length, size_t test_msg_length, size_t num_roots, size_t num_iterations) {
+    uint8_t *msg = (uint8_t *)malloc(test_msg_length);
+    uint8_t *encoded = (uint8_t *)malloc(test_msg_length + num_roots);
+    uint8_t *parity = (uint8_t *)malloc(num_roots);
+    correct_reed_solomon_fragment_t fragments[16];
+
+    printf("testing reed solomon incremental encode block length=%zu, message length=%zu...", block_length, test_msg_length);
+
+    for (size_t i = 0; i < num_iterations; i++) {
+        for (size_t j = 0; j < test_msg_length; j++) {
+            msg[j] = (uint8_t)(rand() % 256);
+        }
+        correct_reed_solomon_encode(rs, msg, test_msg_length, encoded);
+
+        size_t num_fragments = 0;
+        size_t offset = 0;
+        while (offset < test_msg_length && num_fragments < 15) {
+            size_t length = (size_t)rand() % (test_msg_length - offset + 1);
+            fragments[num_fragments].data = msg + offset;
+            fragments[num_fragments].length = length;
+            num_fragments++;
+            offset += length;
+        }
+        fragments[num_fragments].data = msg + offset;
+        fragments[num_fragments].length = test_msg_length - offset;
+        num_fragments++;
+
+        correct_reed_solomon_encode_begin(rs);
+        if (i % 2) {
+            if (correct_reed_solomon_encode_updatev(rs, fragments, num_fragments) != (ssize_t)test_msg_length) {
+                fail_test();
+            }
+        } else {
+            for (size_t f = 0; f < num_fragments; f++) {
+                correct_reed_solomon_encode_update(rs, fragments[f].data, fragments[f].length);
+            }
+        }
+
+        // one byte too many must be refused
+        if (test_msg_length == block_length - num_roots && correct_reed_solomon_encode_update(rs, msg, 1) != -1) {
+            fail_test();
+        }
+
+        if (correct_reed_solomon_encode_final(rs, parity) != (ssize_t)num_roots ||
+            memcmp(parity, encoded + test_msg_length, num_roots) != 0) {
+            fail_test();
+        }
+    }
+
+    free(msg);
+    free(encoded);
+    free(parity);
+
+    pass_test();
+}
+
+// clean blocks must pass, and any corruption of up to num_roots bytes must be caught
+void run_check_tests(correct_reed_solomon *rs, size_t block_length, size_t test_msg_length, size_t num_roots, size_t num_iterations) {
+    size_t encoded_length = test_msg_length + num_roots;
+    size_t num_blocks = 8;
+    uint8_t *msg = (uint8_t *)malloc(test_msg_length);
+    uint8_t *encoded = (uint8_t *)malloc(num_blocks * encoded_length);
+    uint8_t clean[8];
+
+    printf("testing reed solomon check block length=%zu, message length=%zu...", block_length, test_msg_length);
+
+    for (size_t i = 0; i < num_iterations; i++) {
+        for (size_t b = 0; b < num_blocks; b++) {
+            for (size_t j = 0; j < test_msg_length; j++) {
+                msg[j] = (uint8_t)(rand() % 256);
+            }
+            correct_reed_solomon_encode(rs, msg, test_msg_length, encoded + b * encoded_length);
+
+            if (correct_reed_solomon_check(rs, encoded + b * encoded_length, encoded_length) != 1) {
+                fail_test();
+            }
+        }
+
+        if (correct_reed_solomon_check_blocks(rs, encoded, encoded_length, num_blocks, NULL) != 0) {
+            fail_test();
+        }
+
+        // corrupt one block in as many as num_roots places
+        size_t dirty = (size_t)rand() % num_blocks;
+        uint8_t *block = encoded + dirty * encoded_length;
+        size_t num_corrupt = 1 + (size_t)rand() % num_roots;
+        for (size_t j = 0; j < num_corrupt; j++) {
+            block[(j * encoded_length) / num_corrupt] ^= (uint8_t)(1 + rand() % 255);
+        }
+
+        if (correct_reed_solomon_check(rs, block, encoded_length) != 0) {
+            fail_test();
+        }
+
+        if (correct_reed_solomon_check_blocks(rs, encoded, encoded_length, num_blocks, NULL) != 1) {
+            fail_test();
+        }
+
+        if (correct_reed_solomon_check_blocks(rs, encoded, encoded_length, num_blocks, clean) != 1) {
+            fail_test();
+        }
+
+        for (size_t b = 0; b < num_blocks; b++) {
+            if (clean[b] != (b != dirty)) {
+                fail_test();
+            }
+        }
+    }
+
+    free(msg);
+    free(encoded);
+
+    pass_test();
+}
+
+// with profiling built in, a decode counts one call to each stage it reaches, whether
+//   or not it was given erasures
+void run_profile_tests(correct_reed_solomon *rs) {
+#ifdef CORRECT_PROFILE
+    uint8_t msg[223];
+    uint8_t encoded[255];
+    uint8_t erasures[4] = {3, 40, 100, 200};
+    correct_profile_stage_t stages[16];
+
+    printf("testing reed solomon profile stage counts...");
+
+    for (size_t i = 0; i < sizeof(msg); i++) {
+        msg[i] = rand() % 256;
+    }
+
+    correct_reed_solomon_encode(rs, msg, sizeof(msg), encoded);
+    for (size_t i = 0; i < sizeof(erasures); i++) {
+        encoded[erasures[i]] ^= 1;
+    }
+    encoded[10] ^= 1;
+
+    correct_profile_reset();
+    if (correct_reed_solomon_decode(rs, encoded, sizeof(encoded), msg) < 0 ||
+        correct_reed_solomon_decode_with_erasures(rs, encoded, sizeof(encoded), erasures, sizeof(erasures), msg) < 0) {
+        fail_test();
+    }
+
+    ssize_t num_stages = correct_profile_dump(stages, sizeof(stages) / sizeof(stages[0]));
+    for (ssize_t i = 0; i < num_stages; i++) {
+        if (!strncmp(stages[i].name, "rs_", 3) && stages[i].calls != 2) {
+            fail_test();
+        }
+    }
+
+    pass_test();
+#else
+    (void)rs;
+#endif
+}
+
 int main(void) {
     srand((unsigned int)time(NULL));
 
@@ -52,6 +268,8 @@ int main(void) {
     correct_reed_solomon *rs = correct_reed_solomon_create(correct_rs_primitive_polynomial_ccsds, 1, 1, min_distance);
     rs_testbench *testbench = rs_testbench_create(block_length, min_distance);
 
+    run_profile_tests(rs);
+
     run_tests(rs, testbench, block_length, message_length / 2, 0, 0, 20000);
     run_tests(rs, testbench, block_length, message_length, 0, 0, 20000);
     run_tests(rs, testbench, block_length, message_length / 2, min_distance / 2, 0, 20000);
@@ -60,6 +278,14 @@ int main(void) {
     run_tests(rs, testbench, block_length, message_length, 0, min_distance, 20000);
     run_tests(rs, testbench, block_length, message_length / 2, min_distance / 4, min_distance / 2, 20000);
     run_tests(rs, testbench, block_length, message_length, min_distance / 4, min_distance / 2, 20000);
+    run_erasure_only_tests(rs, testbench, block_length, message_length / 2, min_distance, 20000);
+    run_erasure_only_tests(rs, testbench, block_length, message_length, min_distance / 2, 20000);
+    run_erasure_pattern_tests(rs, block_length, message_length, min_distance, min_distance, 20000);
+    run_stream_tests(rs, block_length, message_length / 2, min_distance, 2000);
+    run_stream_tests(rs, block_length, message_length, min_distance, 2000);
+    run_check_tests(rs, block_length, 1, min_distance, 2000);
+    run_check_tests(rs, block_length, message_length / 2, min_distance, 2000);
+    run_check_tests(rs, block_length, message_length, min_distance, 2000);
 
     rs_testbench_destroy(testbench);
     correct_reed_solomon_destroy(rs);
@@ -77,6 +303,14 @@ int main(void) {
     run_tests(rs, testbench, block_length, message_length, 0, min_distance, 20000);
     run_tests(rs, testbench, block_length, message_length / 2, min_distance / 4, min_distance / 2, 20000);
     run_tests(rs, testbench, block_length, message_length, min_distance / 4, min_distance / 2, 20000);
+    run_erasure_only_tests(rs, testbench, block_length, message_length / 2, min_distance, 20000);
+    run_erasure_only_tests(rs, testbench, block_length, message_length, min_distance / 2, 20000);
+    run_erasure_pattern_tests(rs, block_length, message_length, min_distance, min_distance, 20000);
+    run_stream_tests(rs, block_length, message_length / 2, min_distance, 2000);
+    run_stream_tests(rs, block_length, message_length, min_distance, 2000);
+    run_check_tests(rs, block_length, 1, min_distance, 2000);
+    run_check_tests(rs, block_length, message_length / 2, min_distance, 2000);
+    run_check_tests(rs, block_length, message_length, min_distance, 2000);
 
     rs_testbench_destroy(testbench);
     correct_reed_solomon_destroy(rs);
@@ -94,6 +328,14 @@ int main(void) {
     run_tests(rs, testbench, block_length, message_length, 0, min_distance, 20000);
     run_tests(rs, testbench, block_length, message_length / 2, min_distance / 4, min_distance / 2, 20000);
     run_tests(rs, testbench, block_length, message_length, min_distance / 4, min_distance / 2, 20000);
+    run_erasure_only_tests(rs, testbench, block_length, message_length / 2, min_distance, 20000);
+    run_erasure_only_tests(rs, testbench, block_length, message_length, min_distance / 2, 20000);
+    run_erasure_pattern_tests(rs, block_length, message_length, min_distance, min_distance, 20000);
+    run_stream_tests(rs, block_length, message_length / 2, min_distance, 2000);
+    run_stream_tests(rs, block_length, message_length, min_distance, 2000);
+    run_check_tests(rs, block_length, 1, min_distance, 2000);
+    run_check_tests(rs, block_length, message_length / 2, min_distance, 2000);
+    run_check_tests(rs, block_length, message_length, min_distance, 2000);
 
     rs_testbench_destroy(testbench);
     correct_reed_solomon_destroy(rs);
@@ -111,6 +353,14 @@ int main(void) {
     run_tests(rs, testbench, block_length, message_length, 0, min_distance, 20000);
     run_tests(rs, testbench, block_length, message_length / 2, min_distance / 4, min_distance / 2, 20000);
     run_tests(rs, testbench, block_length, message_length, min_distance / 4, min_distance / 2, 20000);
+    run_erasure_only_tests(rs, testbench, block_length, message_length / 2, min_distance, 20000);
+    run_erasure_only_tests(rs, testbench, block_length, message_length, min_distance / 2, 20000);
+    run_erasure_pattern_tests(rs, block_length, message_length, min_distance, min_distance, 20000);
+    run_stream_tests(rs, block_length, message_length / 2, min_distance, 2000);
+    run_stream_tests(rs, block_length, message_length, min_distance, 2000);
+    run_check_tests(rs, block_length, 1, min_distance, 2000);
+    run_check_tests(rs, block_length, message_length / 2, min_distance, 2000);
+    run_check_tests(rs, block_length, message_length, min_distance, 2000);
 
     rs_testbench_destroy(testbench);
     correct_reed_solomon_destroy(rs);
@@ -20,6 +20,13 @@ void rs_correct_decode(void *decoder, uint8_t *encoded, size_t encoded_length, u
     correct_reed_solomon_decode_with_erasures((correct_reed_solomon *)decoder, encoded, encoded_length, erasure_locations, erasure_length, msg);
 }
 
+void rs_correct_decode_erasures_only(void *decoder, uint8_t *encoded, size_t encoded_length, uint8_t *erasure_locations, size_t erasure_length, uint8_t *msg, size_t pad_length, size_t num_roots) {
+    (void) pad_length;
+    (void) num_roots;
+
+    correct_reed_solomon_decode_erasures_only((correct_reed_solomon *)decoder, encoded, encoded_length, erasure_locations, erasure_length, msg);
+}
+
 rs_testbench *rs_testbench_create(size_t block_length, size_t min_distance) {
     rs_testbench *testbench = (rs_testbench *)calloc(1, sizeof(rs_testbench));
 
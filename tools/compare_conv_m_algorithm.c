@@ -0,0 +1,151 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// compares the M-algorithm against the full viterbi decoder for one code, reporting the
+//   throughput and bit error rate of each number of paths
+// without polys, this is the order 15 rate 1/6 code of libfec's viterbi615, where the
+//   full trellis has 16384 states
+// every decoder decodes the same noisy blocks, so differences in error rate are down to
+//   the decoder and not the noise
+
+#if HAVE_SSE
+#include "correct/util/error-sim-sse.h"
+typedef correct_convolutional_sse conv_t;
+static conv_t*(*conv_create)(size_t, size_t, const uint16_t *) = correct_convolutional_sse_create;
+static void(*conv_destroy)(conv_t *) = correct_convolutional_sse_destroy;
+static ssize_t(*conv_set_m_algorithm)(conv_t *, size_t) = correct_convolutional_sse_set_m_algorithm;
+static size_t(*conv_enclen)(void *, size_t) = conv_correct_sse_enclen;
+static void(*conv_encode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_sse_encode;
+static ssize_t(*conv_decode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_sse_decode;
+#else
+#include "correct/util/error-sim.h"
+typedef correct_convolutional conv_t;
+static conv_t*(*conv_create)(size_t, size_t, const uint16_t *) = correct_convolutional_create;
+static void(*conv_destroy)(conv_t *) = correct_convolutional_destroy;
+static ssize_t(*conv_set_m_algorithm)(conv_t *, size_t) = correct_convolutional_set_m_algorithm;
+static size_t(*conv_enclen)(void *, size_t) = conv_correct_enclen;
+static void(*conv_encode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_encode;
+static ssize_t(*conv_decode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_decode;
+#endif
+
+// 0 is the full viterbi decoder
+static const size_t max_paths[] = {0, 16, 32, 64, 128, 256, 512, 1024};
+#define NUM_MAX_PATHS (sizeof(max_paths) / sizeof(max_paths[0]))
+
+static const correct_convolutional_polynomial_t viterbi615_poly[] = {042631, 047245, 056507, 073363, 077267, 064537};
+
+const size_t max_block_len = 4096;
+
+typedef struct {
+    conv_t *conv;
+    size_t max_paths;
+    size_t errors;
+    double seconds;
+} operating_point_t;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("usage: %s rate order eb_n0 n_bytes [poly...]\n", argv[0]);
+        printf("  polys are octal, one per output. without them, rate 6 order 15 is viterbi615\n");
+        return 1;
+    }
+
+    srand((unsigned int)time(NULL));
+
+    size_t rate, order, n_bytes;
+    double eb_n0;
+    sscanf(argv[1], "%zu", &rate);
+    sscanf(argv[2], "%zu", &order);
+    sscanf(argv[3], "%lf", &eb_n0);
+    sscanf(argv[4], "%zu", &n_bytes);
+
+    correct_convolutional_polynomial_t *poly = (correct_convolutional_polynomial_t *)calloc(rate, sizeof(correct_convolutional_polynomial_t));
+    if ((size_t)argc >= 5 + rate) {
+        for (size_t i = 0; i < rate; i++) {
+            unsigned int coeff;
+            sscanf(argv[5 + i], "%o", &coeff);
+            poly[i] = (correct_convolutional_polynomial_t)coeff;
+        }
+    } else if (rate == 6 && order == 15) {
+        memcpy(poly, viterbi615_poly, rate * sizeof(correct_convolutional_polynomial_t));
+    } else {
+        printf("no preset polynomial for rate 1/%zu order %zu, please give one\n", rate, order);
+        free(poly);
+        return 1;
+    }
+
+    double bpsk_voltage = 1.0/sqrt(2.0);
+    double bpsk_sym_energy = 2*pow(bpsk_voltage, 2.0);
+    double bpsk_bit_energy = bpsk_sym_energy * rate;
+
+    operating_point_t *points = (operating_point_t *)calloc(NUM_MAX_PATHS, sizeof(operating_point_t));
+    for (size_t i = 0; i < NUM_MAX_PATHS; i++) {
+        operating_point_t *point = &points[i];
+        point->max_paths = max_paths[i];
+        point->conv = conv_create(rate, order, poly);
+        if (!point->conv || conv_set_m_algorithm(point->conv, point->max_paths)) {
+            printf("couldn't create a decoder with %zu paths\n", point->max_paths);
+            return 1;
+        }
+    }
+
+    uint8_t *msg = (uint8_t *)malloc(max_block_len);
+    conv_testbench *scratch = NULL;
+    size_t bytes_remaining = n_bytes;
+    while (bytes_remaining) {
+        size_t block_len = (max_block_len < bytes_remaining) ? max_block_len : bytes_remaining;
+        bytes_remaining -= block_len;
+
+        for (size_t i = 0; i < block_len; i++) {
+            msg[i] = rand() % 256;
+        }
+
+        scratch = resize_conv_testbench(scratch, conv_enclen, points[0].conv, block_len);
+        build_white_noise(scratch->noise, scratch->enclen, eb_n0, bpsk_bit_energy);
+        conv_encode(points[0].conv, msg, block_len, scratch->encoded);
+        encode_bpsk(scratch->encoded, scratch->v, scratch->enclen, bpsk_voltage);
+        memcpy(scratch->corrupted, scratch->v, scratch->enclen * sizeof(double));
+        add_white_noise(scratch->corrupted, scratch->noise, scratch->enclen);
+        decode_bpsk_soft(scratch->corrupted, scratch->soft, scratch->enclen, bpsk_voltage);
+
+        for (size_t i = 0; i < NUM_MAX_PATHS; i++) {
+            double start = now();
+            conv_decode(points[i].conv, scratch->soft, scratch->enclen, scratch->msg_out);
+            points[i].seconds += now() - start;
+            points[i].errors += distance(msg, scratch->msg_out, block_len);
+        }
+    }
+
+    printf("rate 1/%zu order %zu, polys", rate, order);
+    for (size_t i = 0; i < rate; i++) {
+        printf(" %o", poly[i]);
+    }
+    printf(", %zu bytes @%.1fdB\n", n_bytes, eb_n0);
+    printf("%10s %12s %12s\n", "paths", "BER", "Mbit/s");
+    for (size_t i = 0; i < NUM_MAX_PATHS; i++) {
+        double ber = points[i].errors / ((double)n_bytes * 8);
+        double mbps = (n_bytes * 8) / (points[i].seconds * 1e6);
+        if (points[i].max_paths) {
+            printf("%10zu %12.2e %12.2f\n", points[i].max_paths, ber, mbps);
+        } else {
+            printf("%10s %12.2e %12.2f\n", "viterbi", ber, mbps);
+        }
+        conv_destroy(points[i].conv);
+    }
+
+    free_scratch(scratch);
+    free(msg);
+    free(points);
+    free(poly);
+
+    return 0;
+}
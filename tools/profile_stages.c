@@ -0,0 +1,164 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// breaks the time of a convolutional decode and a reed-solomon decode down by stage,
+//   see correct_profile_dump. the library must be built with the Profiling build type
+// the convolutional code decodes n_bytes of noisy blocks, then n_bytes of RS(255, 223)
+//   codewords are decoded, each with errors in half of what the code can correct
+
+#if HAVE_SSE
+#include "correct/util/error-sim-sse.h"
+typedef correct_convolutional_sse conv_t;
+static conv_t*(*conv_create)(size_t, size_t, const uint16_t *) = correct_convolutional_sse_create;
+static void(*conv_destroy)(conv_t *) = correct_convolutional_sse_destroy;
+static size_t(*conv_enclen)(void *, size_t) = conv_correct_sse_enclen;
+static void(*conv_encode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_sse_encode;
+static ssize_t(*conv_decode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_sse_decode;
+#else
+#include "correct/util/error-sim.h"
+typedef correct_convolutional conv_t;
+static conv_t*(*conv_create)(size_t, size_t, const uint16_t *) = correct_convolutional_create;
+static void(*conv_destroy)(conv_t *) = correct_convolutional_destroy;
+static size_t(*conv_enclen)(void *, size_t) = conv_correct_enclen;
+static void(*conv_encode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_encode;
+static ssize_t(*conv_decode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_decode;
+#endif
+
+const size_t max_block_len = 4096;
+const size_t rs_block_len = 255;
+const size_t rs_num_roots = 32;
+
+static void print_stages(const char *prefix) {
+    correct_profile_stage_t stages[16];
+    ssize_t num_stages = correct_profile_dump(stages, sizeof(stages) / sizeof(stages[0]));
+
+    uint64_t total = 0;
+    for (ssize_t i = 0; i < num_stages; i++) {
+        if (!strncmp(stages[i].name, prefix, strlen(prefix))) {
+            total += stages[i].ticks;
+        }
+    }
+
+    printf("%20s %12s %16s %12s %8s\n", "stage", "calls", "ticks", "ticks/call", "share");
+    for (ssize_t i = 0; i < num_stages; i++) {
+        if (strncmp(stages[i].name, prefix, strlen(prefix))) {
+            continue;
+        }
+        double per_call = stages[i].calls ? (double)stages[i].ticks / stages[i].calls : 0;
+        double share = total ? 100.0 * stages[i].ticks / total : 0;
+        printf("%20s %12llu %16llu %12.1f %7.1f%%\n", stages[i].name, (unsigned long long)stages[i].calls,
+               (unsigned long long)stages[i].ticks, per_call, share);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("usage: %s rate order eb_n0 n_bytes [poly...]\n", argv[0]);
+        printf("  polys are octal, one per output. without them, rate 2 order 7 and 9 and rate 3\n");
+        printf("  order 9 use libcorrect's own\n");
+        return 1;
+    }
+
+    if (correct_profile_reset()) {
+        printf("libcorrect wasn't built for profiling, build it with -DCMAKE_BUILD_TYPE=Profiling\n");
+        return 1;
+    }
+
+    srand((unsigned int)time(NULL));
+
+    size_t rate, order, n_bytes;
+    double eb_n0;
+    sscanf(argv[1], "%zu", &rate);
+    sscanf(argv[2], "%zu", &order);
+    sscanf(argv[3], "%lf", &eb_n0);
+    sscanf(argv[4], "%zu", &n_bytes);
+
+    correct_convolutional_polynomial_t *poly = (correct_convolutional_polynomial_t *)calloc(rate, sizeof(correct_convolutional_polynomial_t));
+    if ((size_t)argc >= 5 + rate) {
+        for (size_t i = 0; i < rate; i++) {
+            unsigned int coeff;
+            sscanf(argv[5 + i], "%o", &coeff);
+            poly[i] = (correct_convolutional_polynomial_t)coeff;
+        }
+    } else if (rate == 2 && order == 7) {
+        memcpy(poly, correct_conv_r12_7_polynomial, rate * sizeof(correct_convolutional_polynomial_t));
+    } else if (rate == 2 && order == 9) {
+        memcpy(poly, correct_conv_r12_9_polynomial, rate * sizeof(correct_convolutional_polynomial_t));
+    } else if (rate == 3 && order == 9) {
+        memcpy(poly, correct_conv_r13_9_polynomial, rate * sizeof(correct_convolutional_polynomial_t));
+    } else {
+        printf("no preset polynomial for rate 1/%zu order %zu, please give one\n", rate, order);
+        free(poly);
+        return 1;
+    }
+
+    conv_t *conv = conv_create(rate, order, poly);
+    if (!conv) {
+        printf("couldn't create a decoder for rate 1/%zu order %zu\n", rate, order);
+        free(poly);
+        return 1;
+    }
+
+    double bpsk_voltage = 1.0/sqrt(2.0);
+    double bpsk_sym_energy = 2*pow(bpsk_voltage, 2.0);
+    double bpsk_bit_energy = bpsk_sym_energy * rate;
+
+    // the noise and the decoder's output are made outside the timed stages, so only
+    //   the decodes add to the counters
+    uint8_t *msg = (uint8_t *)malloc(max_block_len);
+    conv_testbench *scratch = NULL;
+    size_t bytes_remaining = n_bytes;
+    while (bytes_remaining) {
+        size_t block_len = (max_block_len < bytes_remaining) ? max_block_len : bytes_remaining;
+        bytes_remaining -= block_len;
+
+        for (size_t i = 0; i < block_len; i++) {
+            msg[i] = rand() % 256;
+        }
+
+        scratch = resize_conv_testbench(scratch, conv_enclen, conv, block_len);
+        build_white_noise(scratch->noise, scratch->enclen, eb_n0, bpsk_bit_energy);
+        conv_encode(conv, msg, block_len, scratch->encoded);
+        encode_bpsk(scratch->encoded, scratch->v, scratch->enclen, bpsk_voltage);
+        add_white_noise(scratch->v, scratch->noise, scratch->enclen);
+        decode_bpsk_soft(scratch->v, scratch->soft, scratch->enclen, bpsk_voltage);
+        conv_decode(conv, scratch->soft, scratch->enclen, scratch->msg_out);
+    }
+
+    printf("rate 1/%zu order %zu, polys", rate, order);
+    for (size_t i = 0; i < rate; i++) {
+        printf(" %o", poly[i]);
+    }
+    printf(", %zu bytes @%.1fdB\n", n_bytes, eb_n0);
+    print_stages("conv_");
+
+    correct_reed_solomon *rs = correct_reed_solomon_create(correct_rs_primitive_polynomial_ccsds, 1, 1, rs_num_roots);
+    size_t rs_msg_len = rs_block_len - rs_num_roots;
+    uint8_t *rs_encoded = (uint8_t *)malloc(rs_block_len);
+    uint8_t *rs_decoded = (uint8_t *)malloc(rs_block_len);
+    for (size_t done = 0; done < n_bytes; done += rs_msg_len) {
+        for (size_t i = 0; i < rs_msg_len; i++) {
+            msg[i] = rand() % 256;
+        }
+        correct_reed_solomon_encode(rs, msg, rs_msg_len, rs_encoded);
+        for (size_t i = 0; i < rs_num_roots / 4; i++) {
+            rs_encoded[rand() % rs_block_len] ^= (uint8_t)(1 + rand() % 255);
+        }
+        correct_reed_solomon_decode(rs, rs_encoded, rs_block_len, rs_decoded);
+    }
+
+    printf("\nRS(255, 223), %zu bytes, %zu byte errors per codeword\n", n_bytes, rs_num_roots / 4);
+    print_stages("rs_");
+
+    correct_reed_solomon_destroy(rs);
+    free(rs_encoded);
+    free(rs_decoded);
+    free(msg);
+    free_scratch(scratch);
+    conv_destroy(conv);
+    free(poly);
+    return 0;
+}
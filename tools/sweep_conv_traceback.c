@@ -0,0 +1,268 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// sweeps the decoder's traceback depth and group length for one code and reports the
+//   throughput and bit error rate of each operating point
+// then does the same for the delay of a low-delay stream, where the latency of every
+//   decoded bit is exactly the delay
+// and last, compares the traceback with register exchange at the default depth
+// every point decodes the same noisy blocks, so differences in error rate are down to
+//   the traceback and not the noise
+
+#if HAVE_SSE
+#include "correct/util/error-sim-sse.h"
+typedef correct_convolutional_sse conv_t;
+static conv_t*(*conv_create)(size_t, size_t, const uint16_t *) = correct_convolutional_sse_create;
+static void(*conv_destroy)(conv_t *) = correct_convolutional_sse_destroy;
+static ssize_t(*conv_set_traceback)(conv_t *, size_t, size_t) = correct_convolutional_sse_set_traceback;
+static ssize_t(*conv_set_survivor_memory)(conv_t *, int) = correct_convolutional_sse_set_survivor_memory;
+static size_t(*conv_enclen)(void *, size_t) = conv_correct_sse_enclen;
+static void(*conv_encode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_sse_encode;
+static ssize_t(*conv_decode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_sse_decode;
+static ssize_t(*conv_stream_begin)(conv_t *, size_t) = correct_convolutional_sse_stream_begin;
+static ssize_t(*conv_stream_decode)(conv_t *, const uint8_t *, size_t, uint8_t *) = correct_convolutional_sse_stream_decode_soft;
+static ssize_t(*conv_stream_end)(conv_t *, uint8_t *) = correct_convolutional_sse_stream_end;
+#else
+#include "correct/util/error-sim.h"
+typedef correct_convolutional conv_t;
+static conv_t*(*conv_create)(size_t, size_t, const uint16_t *) = correct_convolutional_create;
+static void(*conv_destroy)(conv_t *) = correct_convolutional_destroy;
+static ssize_t(*conv_set_traceback)(conv_t *, size_t, size_t) = correct_convolutional_set_traceback;
+static ssize_t(*conv_set_survivor_memory)(conv_t *, int) = correct_convolutional_set_survivor_memory;
+static size_t(*conv_enclen)(void *, size_t) = conv_correct_enclen;
+static void(*conv_encode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_encode;
+static ssize_t(*conv_decode)(void *, uint8_t *, size_t, uint8_t *) = conv_correct_decode;
+static ssize_t(*conv_stream_begin)(conv_t *, size_t) = correct_convolutional_stream_begin;
+static ssize_t(*conv_stream_decode)(conv_t *, const uint8_t *, size_t, uint8_t *) = correct_convolutional_stream_decode_soft;
+static ssize_t(*conv_stream_end)(conv_t *, uint8_t *) = correct_convolutional_stream_end;
+#endif
+
+// both in multiples of the code's order
+static const size_t depths[] = {3, 4, 5, 6, 7, 8, 10, 12};
+static const size_t group_lengths[] = {5, 10, 15, 30, 60, 100, 200};
+#define NUM_DEPTHS (sizeof(depths) / sizeof(depths[0]))
+#define NUM_GROUP_LENGTHS (sizeof(group_lengths) / sizeof(group_lengths[0]))
+
+// low-delay stream delays, also in multiples of order
+static const size_t delays[] = {1, 2, 3, 4, 5, 6, 8};
+#define NUM_DELAYS (sizeof(delays) / sizeof(delays[0]))
+
+static const int survivor_memories[] = {CORRECT_CONV_SURVIVOR_TRACEBACK, CORRECT_CONV_SURVIVOR_REGISTER_EXCHANGE};
+static const char *survivor_memory_names[] = {"traceback", "register exchange"};
+#define NUM_SURVIVOR_MEMORIES (sizeof(survivor_memories) / sizeof(survivor_memories[0]))
+
+const size_t max_block_len = 16384;
+
+typedef struct {
+    conv_t *conv;
+    size_t depth;
+    size_t group_length;
+    size_t errors;
+    double seconds;
+} operating_point_t;
+
+static const correct_convolutional_polynomial_t *preset_poly(size_t rate, size_t order) {
+    if (rate == 2) {
+        switch (order) {
+            case 6: return correct_conv_r12_6_polynomial;
+            case 7: return correct_conv_r12_7_polynomial;
+            case 8: return correct_conv_r12_8_polynomial;
+            case 9: return correct_conv_r12_9_polynomial;
+        }
+    } else if (rate == 3) {
+        switch (order) {
+            case 6: return correct_conv_r13_6_polynomial;
+            case 7: return correct_conv_r13_7_polynomial;
+            case 8: return correct_conv_r13_8_polynomial;
+            case 9: return correct_conv_r13_9_polynomial;
+        }
+    }
+    return NULL;
+}
+
+// count the message bits that differ from the stream's output, which is in two pieces
+static size_t stream_errors(const uint8_t *msg, size_t msg_len, const uint8_t *head, size_t head_len, const uint8_t *tail) {
+    size_t errors = 0;
+    for (size_t i = 0; i < 8 * msg_len; i++) {
+        const uint8_t *bits = (i < head_len) ? head : tail;
+        size_t j = (i < head_len) ? i : i - head_len;
+        unsigned int expected = (msg[i / 8] >> (7 - i % 8)) & 1;
+        unsigned int decoded = (bits[j / 8] >> (7 - j % 8)) & 1;
+        errors += (expected != decoded);
+    }
+    return errors;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        printf("usage: %s rate order eb_n0 n_bytes [poly...]\n", argv[0]);
+        printf("  polys are octal, one per output. without them, the libcorrect preset is used\n");
+        return 1;
+    }
+
+    srand((unsigned int)time(NULL));
+
+    size_t rate, order, n_bytes;
+    double eb_n0;
+    sscanf(argv[1], "%zu", &rate);
+    sscanf(argv[2], "%zu", &order);
+    sscanf(argv[3], "%lf", &eb_n0);
+    sscanf(argv[4], "%zu", &n_bytes);
+
+    correct_convolutional_polynomial_t *poly = (correct_convolutional_polynomial_t *)calloc(rate, sizeof(correct_convolutional_polynomial_t));
+    if ((size_t)argc >= 5 + rate) {
+        for (size_t i = 0; i < rate; i++) {
+            unsigned int coeff;
+            sscanf(argv[5 + i], "%o", &coeff);
+            poly[i] = (correct_convolutional_polynomial_t)coeff;
+        }
+    } else if (preset_poly(rate, order)) {
+        memcpy(poly, preset_poly(rate, order), rate * sizeof(correct_convolutional_polynomial_t));
+    } else {
+        printf("no preset polynomial for rate 1/%zu order %zu, please give one\n", rate, order);
+        free(poly);
+        return 1;
+    }
+
+    double bpsk_voltage = 1.0/sqrt(2.0);
+    double bpsk_sym_energy = 2*pow(bpsk_voltage, 2.0);
+    double bpsk_bit_energy = bpsk_sym_energy * rate;
+
+    size_t num_points = NUM_DEPTHS * NUM_GROUP_LENGTHS;
+    operating_point_t *points = (operating_point_t *)calloc(num_points, sizeof(operating_point_t));
+    for (size_t i = 0; i < NUM_DEPTHS; i++) {
+        for (size_t j = 0; j < NUM_GROUP_LENGTHS; j++) {
+            operating_point_t *point = &points[i * NUM_GROUP_LENGTHS + j];
+            point->depth = depths[i] * order;
+            point->group_length = group_lengths[j] * order;
+            point->conv = conv_create(rate, order, poly);
+            if (!point->conv || conv_set_traceback(point->conv, point->depth, point->group_length)) {
+                printf("couldn't create a decoder with traceback %zu/%zu\n", point->depth, point->group_length);
+                return 1;
+            }
+        }
+    }
+
+    operating_point_t *delay_points = (operating_point_t *)calloc(NUM_DELAYS, sizeof(operating_point_t));
+    for (size_t i = 0; i < NUM_DELAYS; i++) {
+        operating_point_t *point = &delay_points[i];
+        point->depth = delays[i] * order;
+        point->conv = conv_create(rate, order, poly);
+        if (!point->conv || conv_stream_begin(point->conv, point->depth)) {
+            printf("couldn't create a stream with delay %zu\n", point->depth);
+            return 1;
+        }
+    }
+
+    // register exchange only holds 64 bits per state, so it needs a depth below that
+    size_t num_survivor_points = (5 * order < 64) ? NUM_SURVIVOR_MEMORIES : 0;
+    operating_point_t *survivor_points = (operating_point_t *)calloc(NUM_SURVIVOR_MEMORIES, sizeof(operating_point_t));
+    for (size_t i = 0; i < num_survivor_points; i++) {
+        operating_point_t *point = &survivor_points[i];
+        point->depth = 5 * order;
+        point->conv = conv_create(rate, order, poly);
+        if (!point->conv || conv_set_survivor_memory(point->conv, survivor_memories[i])) {
+            printf("couldn't create a decoder with %s\n", survivor_memory_names[i]);
+            return 1;
+        }
+    }
+
+    uint8_t *msg = (uint8_t *)malloc(max_block_len);
+    uint8_t *stream_head = (uint8_t *)malloc(max_block_len + 8);
+    uint8_t *stream_tail = (uint8_t *)malloc(delays[NUM_DELAYS - 1] * order / 8 + 1);
+    conv_testbench *scratch = NULL;
+    size_t bytes_remaining = n_bytes;
+    while (bytes_remaining) {
+        size_t block_len = (max_block_len < bytes_remaining) ? max_block_len : bytes_remaining;
+        bytes_remaining -= block_len;
+
+        for (size_t i = 0; i < block_len; i++) {
+            msg[i] = rand() % 256;
+        }
+
+        scratch = resize_conv_testbench(scratch, conv_enclen, points[0].conv, block_len);
+        build_white_noise(scratch->noise, scratch->enclen, eb_n0, bpsk_bit_energy);
+        conv_encode(points[0].conv, msg, block_len, scratch->encoded);
+        encode_bpsk(scratch->encoded, scratch->v, scratch->enclen, bpsk_voltage);
+        memcpy(scratch->corrupted, scratch->v, scratch->enclen * sizeof(double));
+        add_white_noise(scratch->corrupted, scratch->noise, scratch->enclen);
+        decode_bpsk_soft(scratch->corrupted, scratch->soft, scratch->enclen, bpsk_voltage);
+
+        for (size_t i = 0; i < num_points; i++) {
+            double start = now();
+            conv_decode(points[i].conv, scratch->soft, scratch->enclen, scratch->msg_out);
+            points[i].seconds += now() - start;
+            points[i].errors += distance(msg, scratch->msg_out, block_len);
+        }
+
+        // the stream's output runs past the message into the zero tail, and ending the
+        //   stream starts the next one
+        for (size_t i = 0; i < NUM_DELAYS; i++) {
+            double start = now();
+            ssize_t head_len = conv_stream_decode(delay_points[i].conv, scratch->soft, scratch->enclen, stream_head);
+            conv_stream_end(delay_points[i].conv, stream_tail);
+            delay_points[i].seconds += now() - start;
+            delay_points[i].errors += stream_errors(msg, block_len, stream_head, (size_t)head_len, stream_tail);
+        }
+
+        for (size_t i = 0; i < num_survivor_points; i++) {
+            double start = now();
+            conv_decode(survivor_points[i].conv, scratch->soft, scratch->enclen, scratch->msg_out);
+            survivor_points[i].seconds += now() - start;
+            survivor_points[i].errors += distance(msg, scratch->msg_out, block_len);
+        }
+    }
+
+    printf("rate 1/%zu order %zu, polys", rate, order);
+    for (size_t i = 0; i < rate; i++) {
+        printf(" %o", poly[i]);
+    }
+    printf(", %zu bytes @%.1fdB\n", n_bytes, eb_n0);
+    printf("%8s %8s %12s %12s\n", "depth", "group", "BER", "Mbit/s");
+    for (size_t i = 0; i < num_points; i++) {
+        double ber = points[i].errors / ((double)n_bytes * 8);
+        double mbps = (n_bytes * 8) / (points[i].seconds * 1e6);
+        printf("%8zu %8zu %12.2e %12.2f\n", points[i].depth, points[i].group_length, ber, mbps);
+        conv_destroy(points[i].conv);
+    }
+
+    printf("\nlow-delay stream\n");
+    printf("%8s %12s %12s\n", "delay", "BER", "Mbit/s");
+    for (size_t i = 0; i < NUM_DELAYS; i++) {
+        double ber = delay_points[i].errors / ((double)n_bytes * 8);
+        double mbps = (n_bytes * 8) / (delay_points[i].seconds * 1e6);
+        printf("%8zu %12.2e %12.2f\n", delay_points[i].depth, ber, mbps);
+        conv_destroy(delay_points[i].conv);
+    }
+
+    if (num_survivor_points) {
+        printf("\nsurvivor memory, default depth and group length\n");
+        printf("%18s %8s %12s %12s\n", "", "depth", "BER", "Mbit/s");
+        for (size_t i = 0; i < num_survivor_points; i++) {
+            double ber = survivor_points[i].errors / ((double)n_bytes * 8);
+            double mbps = (n_bytes * 8) / (survivor_points[i].seconds * 1e6);
+            printf("%18s %8zu %12.2e %12.2f\n", survivor_memory_names[i], survivor_points[i].depth, ber, mbps);
+            conv_destroy(survivor_points[i].conv);
+        }
+    }
+
+    free_scratch(scratch);
+    free(stream_tail);
+    free(stream_head);
+    free(msg);
+    free(survivor_points);
+    free(delay_points);
+    free(points);
+    free(poly);
+
+    return 0;
+}